@@ -0,0 +1,555 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Load-time selection of the expxsqr and expmxsqr implementations for libexpxsqr.so.
+
+// The library contains several builds of each function, distinguished by a suffix:
+//   _generic  compiled for the baseline x86-64 ISA (scalar; fma() is a libm call).
+//   _fma      scalar, compiled with -mfma.
+//   _avx2     four-lane (eight-lane for float) AVX2/FMA array kernel.
+//   _avx512   eight-lane (sixteen-lane for float) AVX-512F array kernel.
+// The public symbols expxsqr, expmxsqr, expxsqr_fast, expmxsqr_fast, expxsqr_cr, expmxsqr_cr, expxsqr_cr_escalations,
+// expxsqr_pair, expxsqr_dd, expmxsqr_dd, gaussian, gaussian_setup, gaussian_kernel, expxy, expmxy, expxsqrf, expmxsqrf and their
+// array forms are bound to the best build for the processor once, when the library is loaded.  On ELF/glibc targets this is done
+// with GNU indirect functions (ifunc), so calls cost the same as a direct call through the PLT.  Elsewhere the public functions
+// call through pointers that are set by a constructor.
+
+#include <stddef.h>
+#include <stdlib.h> // Defines __GLIBC__ on glibc systems.
+
+#include "DD_arithmetic.h"
+#include "gaussian.h"
+
+double expxsqr_generic(const double x);
+double expxsqr_fma(const double x);
+double expmxsqr_generic(const double x);
+double expmxsqr_fma(const double x);
+double expxsqr_fast_generic(const double x);
+double expxsqr_fast_fma(const double x);
+double expmxsqr_fast_generic(const double x);
+double expmxsqr_fast_fma(const double x);
+double expxsqr_cr_generic(const double x);
+double expxsqr_cr_fma(const double x);
+double expmxsqr_cr_generic(const double x);
+double expmxsqr_cr_fma(const double x);
+unsigned long long expxsqr_cr_escalations_generic(void);
+unsigned long long expxsqr_cr_escalations_fma(void);
+void expxsqr_pair_generic(const double x, double* pos, double* neg);
+void expxsqr_pair_fma(const double x, double* pos, double* neg);
+void expxsqr_array_generic(const double* x, double* y, const size_t n);
+void expxsqr_array_avx2(const double* x, double* y, const size_t n);
+void expxsqr_array_avx512(const double* x, double* y, const size_t n);
+void expmxsqr_array_generic(const double* x, double* y, const size_t n);
+void expmxsqr_array_avx2(const double* x, double* y, const size_t n);
+void expmxsqr_array_avx512(const double* x, double* y, const size_t n);
+void expxsqr_pair_array_generic(const double* x, double* pos, double* neg, const size_t n);
+void expxsqr_pair_array_avx2(const double* x, double* pos, double* neg, const size_t n);
+void expxsqr_pair_array_avx512(const double* x, double* pos, double* neg, const size_t n);
+DD expxsqr_dd_generic(const double x);
+DD expxsqr_dd_fma(const double x);
+DD expmxsqr_dd_generic(const double x);
+DD expmxsqr_dd_fma(const double x);
+void expxsqr_dd_array_generic(const double* x, double* hi, double* lo, const size_t n);
+void expxsqr_dd_array_avx2(const double* x, double* hi, double* lo, const size_t n);
+void expxsqr_dd_array_avx512(const double* x, double* hi, double* lo, const size_t n);
+void expmxsqr_dd_array_generic(const double* x, double* hi, double* lo, const size_t n);
+void expmxsqr_dd_array_avx2(const double* x, double* hi, double* lo, const size_t n);
+void expmxsqr_dd_array_avx512(const double* x, double* hi, double* lo, const size_t n);
+float expxsqrf_generic(const float x);
+float expxsqrf_fma(const float x);
+float expmxsqrf_generic(const float x);
+float expmxsqrf_fma(const float x);
+void expxsqrf_array_generic(const float* x, float* y, const size_t n);
+void expxsqrf_array_avx2(const float* x, float* y, const size_t n);
+void expxsqrf_array_avx512(const float* x, float* y, const size_t n);
+void expmxsqrf_array_generic(const float* x, float* y, const size_t n);
+void expmxsqrf_array_avx2(const float* x, float* y, const size_t n);
+void expmxsqrf_array_avx512(const float* x, float* y, const size_t n);
+double gaussian_generic(const double x, const double A, const double mu, const double sigma);
+double gaussian_fma(const double x, const double A, const double mu, const double sigma);
+gaussian_params gaussian_setup_generic(const double A, const double mu, const double sigma);
+gaussian_params gaussian_setup_fma(const double A, const double mu, const double sigma);
+double gaussian_kernel_generic(const double x, const gaussian_params* params);
+double gaussian_kernel_fma(const double x, const gaussian_params* params);
+void gaussian_array_generic(const double* x, double* y, const size_t n, const double A, const double mu, const double sigma);
+void gaussian_array_avx2(const double* x, double* y, const size_t n, const double A, const double mu, const double sigma);
+void gaussian_array_avx512(const double* x, double* y, const size_t n, const double A, const double mu, const double sigma);
+double expxy_generic(const double x, const double y);
+double expxy_fma(const double x, const double y);
+double expmxy_generic(const double x, const double y);
+double expmxy_fma(const double x, const double y);
+void expxy_array_generic(const double* x, const double* y, double* z, const size_t n);
+void expxy_array_avx2(const double* x, const double* y, double* z, const size_t n);
+void expxy_array_avx512(const double* x, const double* y, double* z, const size_t n);
+void expmxy_array_generic(const double* x, const double* y, double* z, const size_t n);
+void expmxy_array_avx2(const double* x, const double* y, double* z, const size_t n);
+void expmxy_array_avx512(const double* x, const double* y, double* z, const size_t n);
+
+typedef double scalar_func(const double x);
+typedef unsigned long long counter_func(void);
+typedef void array_func(const double* x, double* y, const size_t n);
+typedef void pair_func(const double x, double* pos, double* neg);
+typedef void pair_array_func(const double* x, double* pos, double* neg, const size_t n);
+typedef DD dd_func(const double x);
+typedef void dd_array_func(const double* x, double* hi, double* lo, const size_t n);
+typedef double gaussian_func(const double x, const double A, const double mu, const double sigma);
+typedef gaussian_params gaussian_setup_func(const double A, const double mu, const double sigma);
+typedef double gaussian_kernel_func(const double x, const gaussian_params* params);
+typedef void gaussian_array_func(const double* x, double* y, const size_t n, const double A, const double mu, const double sigma);
+typedef double xy_func(const double x, const double y);
+typedef void xy_array_func(const double* x, const double* y, double* z, const size_t n);
+typedef float scalarf_func(const float x);
+typedef void arrayf_func(const float* x, float* y, const size_t n);
+
+#if defined(__ELF__) && defined(__GLIBC__) && !defined(NO_IFUNC)
+#define USE_IFUNC 1
+#endif
+
+// The resolvers may run before the library's constructors (ifunc resolvers run during relocation), so each one initializes the
+// CPU model data itself.
+
+static scalar_func*
+select_expxsqr(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma") ? expxsqr_fma : expxsqr_generic;
+}
+
+static scalar_func*
+select_expmxsqr(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma") ? expmxsqr_fma : expmxsqr_generic;
+}
+
+static scalar_func*
+select_expxsqr_fast(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma") ? expxsqr_fast_fma : expxsqr_fast_generic;
+}
+
+static scalar_func*
+select_expmxsqr_fast(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma") ? expmxsqr_fast_fma : expmxsqr_fast_generic;
+}
+
+static scalar_func*
+select_expxsqr_cr(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma") ? expxsqr_cr_fma : expxsqr_cr_generic;
+}
+
+static scalar_func*
+select_expmxsqr_cr(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma") ? expmxsqr_cr_fma : expmxsqr_cr_generic;
+}
+
+// expxsqr_cr_escalations() is selected on the same condition as expxsqr_cr() and expmxsqr_cr(), so it reads the counter of the
+// triple-double fallback that they call.
+static counter_func*
+select_expxsqr_cr_escalations(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma") ? expxsqr_cr_escalations_fma : expxsqr_cr_escalations_generic;
+}
+
+static pair_func*
+select_expxsqr_pair(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma") ? expxsqr_pair_fma : expxsqr_pair_generic;
+}
+
+static array_func*
+select_expxsqr_array(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return expxsqr_array_avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return expxsqr_array_avx2;
+    return expxsqr_array_generic;
+}
+
+static array_func*
+select_expmxsqr_array(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return expmxsqr_array_avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return expmxsqr_array_avx2;
+    return expmxsqr_array_generic;
+}
+
+static pair_array_func*
+select_expxsqr_pair_array(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return expxsqr_pair_array_avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return expxsqr_pair_array_avx2;
+    return expxsqr_pair_array_generic;
+}
+
+static dd_func*
+select_expxsqr_dd(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma") ? expxsqr_dd_fma : expxsqr_dd_generic;
+}
+
+static dd_func*
+select_expmxsqr_dd(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma") ? expmxsqr_dd_fma : expmxsqr_dd_generic;
+}
+
+static dd_array_func*
+select_expxsqr_dd_array(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return expxsqr_dd_array_avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return expxsqr_dd_array_avx2;
+    return expxsqr_dd_array_generic;
+}
+
+static dd_array_func*
+select_expmxsqr_dd_array(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return expmxsqr_dd_array_avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return expmxsqr_dd_array_avx2;
+    return expmxsqr_dd_array_generic;
+}
+
+static gaussian_func*
+select_gaussian(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma") ? gaussian_fma : gaussian_generic;
+}
+
+// gaussian_setup() and gaussian_kernel() are selected on the same condition, so the kernel always reads the parameters of its own
+// build.
+static gaussian_setup_func*
+select_gaussian_setup(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma") ? gaussian_setup_fma : gaussian_setup_generic;
+}
+
+static gaussian_kernel_func*
+select_gaussian_kernel(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma") ? gaussian_kernel_fma : gaussian_kernel_generic;
+}
+
+static gaussian_array_func*
+select_gaussian_array(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("fma")) return gaussian_array_avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return gaussian_array_avx2;
+    return gaussian_array_generic;
+}
+
+static xy_func*
+select_expxy(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma") ? expxy_fma : expxy_generic;
+}
+
+static xy_func*
+select_expmxy(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma") ? expmxy_fma : expmxy_generic;
+}
+
+static xy_array_func*
+select_expxy_array(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return expxy_array_avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return expxy_array_avx2;
+    return expxy_array_generic;
+}
+
+static xy_array_func*
+select_expmxy_array(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return expmxy_array_avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return expmxy_array_avx2;
+    return expmxy_array_generic;
+}
+
+static scalarf_func*
+select_expxsqrf(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma") ? expxsqrf_fma : expxsqrf_generic;
+}
+
+static scalarf_func*
+select_expmxsqrf(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma") ? expmxsqrf_fma : expmxsqrf_generic;
+}
+
+static arrayf_func*
+select_expxsqrf_array(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return expxsqrf_array_avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return expxsqrf_array_avx2;
+    return expxsqrf_array_generic;
+}
+
+static arrayf_func*
+select_expmxsqrf_array(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return expmxsqrf_array_avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return expmxsqrf_array_avx2;
+    return expmxsqrf_array_generic;
+}
+
+#if defined(USE_IFUNC)
+
+double expxsqr(const double x) __attribute__((ifunc("select_expxsqr")));
+double expmxsqr(const double x) __attribute__((ifunc("select_expmxsqr")));
+double expxsqr_fast(const double x) __attribute__((ifunc("select_expxsqr_fast")));
+double expmxsqr_fast(const double x) __attribute__((ifunc("select_expmxsqr_fast")));
+double expxsqr_cr(const double x) __attribute__((ifunc("select_expxsqr_cr")));
+double expmxsqr_cr(const double x) __attribute__((ifunc("select_expmxsqr_cr")));
+unsigned long long expxsqr_cr_escalations(void) __attribute__((ifunc("select_expxsqr_cr_escalations")));
+void expxsqr_pair(const double x, double* pos, double* neg) __attribute__((ifunc("select_expxsqr_pair")));
+void expxsqr_array(const double* x, double* y, const size_t n) __attribute__((ifunc("select_expxsqr_array")));
+void expmxsqr_array(const double* x, double* y, const size_t n) __attribute__((ifunc("select_expmxsqr_array")));
+void expxsqr_pair_array(const double* x, double* pos, double* neg, const size_t n) __attribute__((ifunc("select_expxsqr_pair_array")));
+DD expxsqr_dd(const double x) __attribute__((ifunc("select_expxsqr_dd")));
+DD expmxsqr_dd(const double x) __attribute__((ifunc("select_expmxsqr_dd")));
+void expxsqr_dd_array(const double* x, double* hi, double* lo, const size_t n) __attribute__((ifunc("select_expxsqr_dd_array")));
+void expmxsqr_dd_array(const double* x, double* hi, double* lo, const size_t n) __attribute__((ifunc("select_expmxsqr_dd_array")));
+double gaussian(const double x, const double A, const double mu, const double sigma) __attribute__((ifunc("select_gaussian")));
+void gaussian_array(const double* x, double* y, const size_t n, const double A, const double mu, const double sigma)
+    __attribute__((ifunc("select_gaussian_array")));
+gaussian_params gaussian_setup(const double A, const double mu, const double sigma) __attribute__((ifunc("select_gaussian_setup")));
+double gaussian_kernel(const double x, const gaussian_params* params) __attribute__((ifunc("select_gaussian_kernel")));
+double expxy(const double x, const double y) __attribute__((ifunc("select_expxy")));
+double expmxy(const double x, const double y) __attribute__((ifunc("select_expmxy")));
+void expxy_array(const double* x, const double* y, double* z, const size_t n) __attribute__((ifunc("select_expxy_array")));
+void expmxy_array(const double* x, const double* y, double* z, const size_t n) __attribute__((ifunc("select_expmxy_array")));
+float expxsqrf(const float x) __attribute__((ifunc("select_expxsqrf")));
+float expmxsqrf(const float x) __attribute__((ifunc("select_expmxsqrf")));
+void expxsqrf_array(const float* x, float* y, const size_t n) __attribute__((ifunc("select_expxsqrf_array")));
+void expmxsqrf_array(const float* x, float* y, const size_t n) __attribute__((ifunc("select_expmxsqrf_array")));
+
+#else // !USE_IFUNC
+
+static scalar_func* expxsqr_ptr = expxsqr_generic;
+static scalar_func* expmxsqr_ptr = expmxsqr_generic;
+static scalar_func* expxsqr_fast_ptr = expxsqr_fast_generic;
+static scalar_func* expmxsqr_fast_ptr = expmxsqr_fast_generic;
+static scalar_func* expxsqr_cr_ptr = expxsqr_cr_generic;
+static scalar_func* expmxsqr_cr_ptr = expmxsqr_cr_generic;
+static counter_func* expxsqr_cr_escalations_ptr = expxsqr_cr_escalations_generic;
+static pair_func* expxsqr_pair_ptr = expxsqr_pair_generic;
+static array_func* expxsqr_array_ptr = expxsqr_array_generic;
+static array_func* expmxsqr_array_ptr = expmxsqr_array_generic;
+static pair_array_func* expxsqr_pair_array_ptr = expxsqr_pair_array_generic;
+static dd_func* expxsqr_dd_ptr = expxsqr_dd_generic;
+static dd_func* expmxsqr_dd_ptr = expmxsqr_dd_generic;
+static dd_array_func* expxsqr_dd_array_ptr = expxsqr_dd_array_generic;
+static dd_array_func* expmxsqr_dd_array_ptr = expmxsqr_dd_array_generic;
+static gaussian_func* gaussian_ptr = gaussian_generic;
+static gaussian_array_func* gaussian_array_ptr = gaussian_array_generic;
+static gaussian_setup_func* gaussian_setup_ptr = gaussian_setup_generic;
+static gaussian_kernel_func* gaussian_kernel_ptr = gaussian_kernel_generic;
+static xy_func* expxy_ptr = expxy_generic;
+static xy_func* expmxy_ptr = expmxy_generic;
+static xy_array_func* expxy_array_ptr = expxy_array_generic;
+static xy_array_func* expmxy_array_ptr = expmxy_array_generic;
+static scalarf_func* expxsqrf_ptr = expxsqrf_generic;
+static scalarf_func* expmxsqrf_ptr = expmxsqrf_generic;
+static arrayf_func* expxsqrf_array_ptr = expxsqrf_array_generic;
+static arrayf_func* expmxsqrf_array_ptr = expmxsqrf_array_generic;
+
+__attribute__((constructor))
+static void
+init_dispatch(void) {
+    expxsqr_ptr = select_expxsqr();
+    expmxsqr_ptr = select_expmxsqr();
+    expxsqr_fast_ptr = select_expxsqr_fast();
+    expmxsqr_fast_ptr = select_expmxsqr_fast();
+    expxsqr_cr_ptr = select_expxsqr_cr();
+    expmxsqr_cr_ptr = select_expmxsqr_cr();
+    expxsqr_cr_escalations_ptr = select_expxsqr_cr_escalations();
+    expxsqr_pair_ptr = select_expxsqr_pair();
+    expxsqr_array_ptr = select_expxsqr_array();
+    expmxsqr_array_ptr = select_expmxsqr_array();
+    expxsqr_pair_array_ptr = select_expxsqr_pair_array();
+    expxsqr_dd_ptr = select_expxsqr_dd();
+    expmxsqr_dd_ptr = select_expmxsqr_dd();
+    expxsqr_dd_array_ptr = select_expxsqr_dd_array();
+    expmxsqr_dd_array_ptr = select_expmxsqr_dd_array();
+    gaussian_ptr = select_gaussian();
+    gaussian_array_ptr = select_gaussian_array();
+    gaussian_setup_ptr = select_gaussian_setup();
+    gaussian_kernel_ptr = select_gaussian_kernel();
+    expxy_ptr = select_expxy();
+    expmxy_ptr = select_expmxy();
+    expxy_array_ptr = select_expxy_array();
+    expmxy_array_ptr = select_expmxy_array();
+    expxsqrf_ptr = select_expxsqrf();
+    expmxsqrf_ptr = select_expmxsqrf();
+    expxsqrf_array_ptr = select_expxsqrf_array();
+    expmxsqrf_array_ptr = select_expmxsqrf_array();
+    return;
+}
+
+double
+expxsqr(const double x) {
+    return expxsqr_ptr(x);
+}
+
+double
+expmxsqr(const double x) {
+    return expmxsqr_ptr(x);
+}
+
+double
+expxsqr_fast(const double x) {
+    return expxsqr_fast_ptr(x);
+}
+
+double
+expmxsqr_fast(const double x) {
+    return expmxsqr_fast_ptr(x);
+}
+
+double
+expxsqr_cr(const double x) {
+    return expxsqr_cr_ptr(x);
+}
+
+double
+expmxsqr_cr(const double x) {
+    return expmxsqr_cr_ptr(x);
+}
+
+unsigned long long
+expxsqr_cr_escalations(void) {
+    return expxsqr_cr_escalations_ptr();
+}
+
+void
+expxsqr_pair(const double x, double* pos, double* neg) {
+    expxsqr_pair_ptr(x, pos, neg);
+    return;
+}
+
+void
+expxsqr_array(const double* x, double* y, const size_t n) {
+    expxsqr_array_ptr(x, y, n);
+    return;
+}
+
+void
+expmxsqr_array(const double* x, double* y, const size_t n) {
+    expmxsqr_array_ptr(x, y, n);
+    return;
+}
+
+void
+expxsqr_pair_array(const double* x, double* pos, double* neg, const size_t n) {
+    expxsqr_pair_array_ptr(x, pos, neg, n);
+    return;
+}
+
+DD
+expxsqr_dd(const double x) {
+    return expxsqr_dd_ptr(x);
+}
+
+DD
+expmxsqr_dd(const double x) {
+    return expmxsqr_dd_ptr(x);
+}
+
+void
+expxsqr_dd_array(const double* x, double* hi, double* lo, const size_t n) {
+    expxsqr_dd_array_ptr(x, hi, lo, n);
+    return;
+}
+
+void
+expmxsqr_dd_array(const double* x, double* hi, double* lo, const size_t n) {
+    expmxsqr_dd_array_ptr(x, hi, lo, n);
+    return;
+}
+
+double
+gaussian(const double x, const double A, const double mu, const double sigma) {
+    return gaussian_ptr(x, A, mu, sigma);
+}
+
+void
+gaussian_array(const double* x, double* y, const size_t n, const double A, const double mu, const double sigma) {
+    gaussian_array_ptr(x, y, n, A, mu, sigma);
+    return;
+}
+
+gaussian_params
+gaussian_setup(const double A, const double mu, const double sigma) {
+    return gaussian_setup_ptr(A, mu, sigma);
+}
+
+double
+gaussian_kernel(const double x, const gaussian_params* params) {
+    return gaussian_kernel_ptr(x, params);
+}
+
+double
+expxy(const double x, const double y) {
+    return expxy_ptr(x, y);
+}
+
+double
+expmxy(const double x, const double y) {
+    return expmxy_ptr(x, y);
+}
+
+void
+expxy_array(const double* x, const double* y, double* z, const size_t n) {
+    expxy_array_ptr(x, y, z, n);
+    return;
+}
+
+void
+expmxy_array(const double* x, const double* y, double* z, const size_t n) {
+    expmxy_array_ptr(x, y, z, n);
+    return;
+}
+
+float
+expxsqrf(const float x) {
+    return expxsqrf_ptr(x);
+}
+
+float
+expmxsqrf(const float x) {
+    return expmxsqrf_ptr(x);
+}
+
+void
+expxsqrf_array(const float* x, float* y, const size_t n) {
+    expxsqrf_array_ptr(x, y, n);
+    return;
+}
+
+void
+expmxsqrf_array(const float* x, float* y, const size_t n) {
+    expmxsqrf_array_ptr(x, y, n);
+    return;
+}
+
+#endif // USE_IFUNC
@@ -24,6 +24,8 @@
 //   [2] S. Boldo and J.-M. Muller, "Some Functions Computable with a Fused-Mac," in 17th IEEE Symposium on Computer Arithmetic (ARITH'05), Cape Cod, MA, USA, 2005, pp. 52-58.
 //   [3] V. Popescu, "Towards fast and certified multiple-precision librairies," Theses, Université de Lyon, 2017
 //   [4] C.-P. Jeannerod, J.-M. Muller, and P. Zimmermann, “On Various Ways to Split a Floating-Point Number,” in 2018 IEEE 25th Symposium on Computer Arithmetic (ARITH), Amherst, MA, Jun. 2018, pp. 53–60, doi: 10.1109/ARITH.2018.8464793.
+//   [5] A. H. Karp and P. Markstein, "High-precision division and square root," ACM Transactions on Mathematical Software, vol. 23, no. 4, pp. 561-589, 1997.
+//   [6] S. Graillat, P. Langlois, and N. Louvet, "Algorithms for accurate, validated and fast polynomial evaluation," Japan Journal of Industrial and Applied Mathematics, vol. 26, no. 2-3, pp. 191-214, 2009.
 
 // Do not allow unsafe optimizations when compiling any source which uses this code.
 
@@ -32,6 +34,11 @@
 
 #include <float.h>
 #include <math.h>
+#include <stdint.h>
+
+#if defined(__SSE__)
+#include <immintrin.h>
+#endif
 
 typedef struct {
     double high;
@@ -197,4 +204,217 @@ div_DD_DD_DD(const DD x, const DD y) {
     return result;
 }
 
+// The reciprocal and square root functions below start from the single-precision hardware estimates (rcpss and rsqrtss, relative
+// error at most 1.5 * 2^-12) instead of dividing or taking a square root.  The argument is first scaled by a power of 2 into
+// [1, 2) or [1, 4) so that it fits in a float; one polynomial Newton step then gives a double, and one more step carried out in
+// double-double arithmetic gives the double-double result (Ref. [5]).  The vector versions use the same float estimates (not
+// vrcp14pd/vrsqrt14pd), so the results are bitwise identical on the same processor.  The measured relative error of the
+// double-double results is below 2^-103 as long as their low parts stay normal (about 2^-968 < |x| < 2^968).  Special values (0,
+// infinities, NaNs, subnormal and, for rsqrt and sqrt, negative arguments) are not handled.
+
+// D -> D, relative error below 2^-52.9 (measured).  Assumes 2^-1022 <= |x| < 2^1023.
+// With e = 1 - x * y, 1 / x = y / (1 - e) = y * (1 + e + e^2 + e^3 + e^4 + ...); |e| <= 1.5 * 2^-12 so the truncation error is
+// below 2^-57.
+static inline double
+rcp_D_D(const double x) {
+    union {
+        double d;
+        uint64_t ui64;
+    } m = {x}, scale;
+    uint64_t exponent = (m.ui64 >> (DBL_MANT_DIG - 1)) & 0x7ff;
+    m.ui64 = (m.ui64 & ~(0x7ffULL << (DBL_MANT_DIG - 1))) | (0x3ffULL << (DBL_MANT_DIG - 1));  // m = +-[1, 2)
+    scale.ui64 = (0x7feULL - exponent) << (DBL_MANT_DIG - 1);                                  // 1 / x = (1 / m) * scale
+#if defined(__SSE__)
+    double y = (double)_mm_cvtss_f32(_mm_rcp_ss(_mm_set_ss((float)m.d))) * scale.d;
+#else
+    double y = (double)(1.0f / (float)m.d) * scale.d;
+#endif
+    double e = fma(-x, y, 1.0);
+    double p = fma(e, fma(e, 1.0 + e, 1.0), 1.0);
+    return fma(y * e, p, y);
+}
+
+// D -> D, relative error below 2^-52.4 (measured).  Assumes x >= 2^-1022 and finite.
+// With r = 1 - x * y^2, 1 / sqrt(x) = y * (1 - r)^(-1/2) = y * (1 + r/2 + 3r^2/8 + 5r^3/16 + 35r^4/128 + 63r^5/256 + ...);
+// |r| <= 3 * 2^-12 so the truncation error is below 2^-64.
+static inline double
+rsqrt_D_D(const double x) {
+    union {
+        double d;
+        uint64_t ui64;
+    } m = {x}, scale;
+    uint64_t exponent = (m.ui64 >> (DBL_MANT_DIG - 1)) & 0x7ff;
+    uint64_t m_exponent = 0x3ff + ((exponent + 1) & 1);                                       // x = m * 4^k with m in [1, 4)
+    m.ui64 = (m.ui64 & ~(0x7ffULL << (DBL_MANT_DIG - 1))) | (m_exponent << (DBL_MANT_DIG - 1));
+    scale.ui64 = ((0x7fe + m_exponent - exponent) >> 1) << (DBL_MANT_DIG - 1);                // 2^-k; the sum is even
+#if defined(__SSE__)
+    double y = (double)_mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss((float)m.d))) * scale.d;
+#else
+    double y = (double)(1.0f / sqrtf((float)m.d)) * scale.d;
+#endif
+    double r = fma(-x * y, y, 1.0);
+    double p = fma(r, fma(r, fma(r, fma(r, 63.0 / 256.0, 35.0 / 128.0), 5.0 / 16.0), 3.0 / 8.0), 0.5);
+    return fma(y * r, p, y);
+}
+
+// 1 / DD -> DD
+// One Newton step in double-double from y = rcp_D_D(hi):  1 / x = y + y * (1 - x * y) + O((1 - x * y)^2).  See Ref. [5].
+// Requires FMA instruction
+static inline DD
+rcp_DD_DD(const DD x) {
+    double y = rcp_D_D(DD_HI(x));
+    double e = fma(-DD_HI(x), y, 1.0) - DD_LO(x) * y;
+    DD result = fast_add_D_D_DD(y, y * e);
+    return result;
+}
+
+// 1 / sqrt(DD) -> DD
+// One Newton step in double-double from y = rsqrt_D_D(hi):  1 / sqrt(x) = y + y * (1 - x * y^2) / 2 + O((1 - x * y^2)^2).
+// 1 - hi(x * y^2) is exact since x * y^2 is close to 1.  See Ref. [5].
+static inline DD
+rsqrt_DD_DD(const DD x) {
+    double y = rsqrt_D_D(DD_HI(x));
+    DD p = mul_DD_DD_DD(x, sqr_D_DD(y));
+    double r = (1.0 - DD_HI(p)) - DD_LO(p);
+    DD result = fast_add_D_D_DD(y, 0.5 * y * r);
+    return result;
+}
+
+// sqrt(DD) -> DD
+// Karp and Markstein's method (Ref. [5]):  with y = rsqrt_D_D(hi) and s = hi * y,
+// sqrt(x) = s + y * (x - s^2) / 2 + O((x - s^2)^2 / x).  hi - s^2 is computed with an FMA.
+// Requires FMA instruction
+static inline DD
+sqrt_DD_DD(const DD x) {
+    double y = rsqrt_D_D(DD_HI(x));
+    double s = DD_HI(x) * y;
+    double d = fma(-s, s, DD_HI(x)) + DD_LO(x);
+    DD result = fast_add_D_D_DD(s, 0.5 * y * d);
+    return result;
+}
+
+// Polynomial evaluation.  a[0], a[1], ... a[n-1] are the coefficients from the highest power down, the order of expxsqr_coeffs:
+// p(x) = a[0] * x^(n-1) + a[1] * x^(n-2) + ... + a[n-1], with 1 <= n <= DD_POLY_MAX_COEFFS.  When n is a compile-time constant the
+// loops are fully unrolled ("#pragma GCC unroll 16" is DD_POLY_MAX_COEFFS) and the coefficients can be kept in registers.
+// p~(|x|) below is the same polynomial with |a[i]| and |x|; p~(|x|) / |p(x)| is the condition number of the evaluation.
+#define DD_POLY_MAX_COEFFS 16
+
+// p(D) -> D
+// Plain Horner with an FMA per coefficient, as in expxsqr.  The error is up to about 2 * (n - 1) * 2^-53 * p~(|x|).
+static inline double
+horner_D_D(const double* a, const int n, const double x) {
+    double s = a[0];
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 16
+#endif
+    for (int i = 1; i < n; i++) s = fma(s, x, a[i]);
+    return s;
+}
+
+// p(D) -> D
+// Estrin's scheme in double:  the coefficients are paired from the constant term up as fma(a[k-1], x, a[k]), then neighbouring
+// terms are combined as fma(t[i+1], x^2, t[i]), fma(..., x^4, ...), ...  The critical path is the chain of squarings plus one FMA,
+// ceil(log2(n)) operations instead of the n - 1 FMAs of Horner (3 instead of 4 for n = 5).  The error is of the same order as
+// Horner's.
+static inline double
+estrin_D_D(const double* a, const int n, const double x) {
+    double t[(DD_POLY_MAX_COEFFS + 1) / 2];
+    int m = 0;
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 16
+#endif
+    for (int k = n - 1; k > 0; k -= 2) t[m++] = fma(a[k - 1], x, a[k]);
+    if (n % 2 != 0) t[m++] = a[0];
+    double power = x * x;
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 4
+#endif
+    while (m > 1) {
+        int j = 0;
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 8
+#endif
+        for (int i = 0; i + 1 < m; i += 2) t[j++] = fma(t[i + 1], power, t[i]);
+        if (m % 2 != 0) t[j++] = t[m - 1];
+        m = j;
+        if (m > 1) power = power * power;
+    }
+    return t[0];
+}
+
+// p(D) -> DD
+// Compensated Horner, Ref. [6], algorithm CompHorner with the error of each product computed with an FMA.  The rounding errors of
+// the product and of the sum at each step are exact (mul_D_D_DD and add_D_D_DD) and are run through Horner's scheme in c.
+// With d = n - 1, |s + c - p(x)| <= gamma(2d)^2 * p~(|x|) where gamma(k) = k * 2^-53 / (1 - k * 2^-53), so DD_HI of the result is
+// within 0.5 ulp plus that bound:  as accurate as Horner in twice the working precision and then rounded.
+static inline DD
+comp_horner_D_DD(const double* a, const int n, const double x) {
+    double s = a[0];
+    double c = 0.0;
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 16
+#endif
+    for (int i = 1; i < n; i++) {
+        DD p = mul_D_D_DD(s, x);
+        DD t = add_D_D_DD(DD_HI(p), a[i]);
+        s = DD_HI(t);
+        c = fma(c, x, DD_LO(p) + DD_LO(t));
+    }
+    DD result = add_D_D_DD(s, c);
+    return result;
+}
+
+// p(DD) -> DD
+// comp_horner_D_DD at hi plus the first-order term lo * p'(hi), with p'(hi) from a plain Horner loop run alongside.  This is the
+// r_lo correction of expxsqr made generic.  Assumes |lo| <= ulp(hi); the extra error is then below 2^-104 * d^2 * p~(|x|).
+static inline DD
+comp_horner_DD_DD(const double* a, const int n, const DD x) {
+    double s = a[0];
+    double c = 0.0;
+    double d = 0.0;
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 16
+#endif
+    for (int i = 1; i < n; i++) {
+        d = fma(d, DD_HI(x), s);
+        DD p = mul_D_D_DD(s, DD_HI(x));
+        DD t = add_D_D_DD(DD_HI(p), a[i]);
+        s = DD_HI(t);
+        c = fma(c, DD_HI(x), DD_LO(p) + DD_LO(t));
+    }
+    DD result = add_D_D_DD(s, fma(DD_LO(x), d, c));
+    return result;
+}
+
+// p(D) -> DD
+// Estrin's scheme with double-double accumulation.  The coefficients are first paired from the constant term up as
+// a[k-1] * x + a[k] (an exact product and add_DD_D_DD), then neighbouring terms are combined as t[i] + t[i+1] * x^2, x^4, ... with
+// add_DD_DD_DD and mul_DD_DD_DD.  The dependency chain is ceil(log2(n)) double-double steps long instead of n - 1, for about three
+// times the operations of comp_horner_D_DD.  The error is of the same order as that of comp_horner_D_DD.
+static inline DD
+estrin_D_DD(const double* a, const int n, const double x) {
+    DD t[(DD_POLY_MAX_COEFFS + 1) / 2];
+    int m = 0;
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 16
+#endif
+    for (int k = n - 1; k > 0; k -= 2) t[m++] = add_DD_D_DD(mul_D_D_DD(a[k - 1], x), a[k]);
+    if (n % 2 != 0) t[m++] = load_D_D_DD(a[0], 0.0);
+    DD power = sqr_D_DD(x);
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 4
+#endif
+    while (m > 1) {
+        int j = 0;
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 8
+#endif
+        for (int i = 0; i + 1 < m; i += 2) t[j++] = add_DD_DD_DD(t[i], mul_DD_DD_DD(t[i + 1], power));
+        if (m % 2 != 0) t[j++] = t[m - 1];
+        m = j;
+        if (m > 1) power = mul_DD_DD_DD(power, power);
+    }
+    return t[0];
+}
+
 #endif // _DD_ARITHMETIC_H
@@ -0,0 +1,356 @@
+// -*-  mode: C; tab-width:4; fill-column: 132; comment-start:  "// "; comment-end:  ""; coding: utf-8;  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// References:
+//   [1] M. M. Joldes, J.-M. Muller, and V. Popescu, "Tight and rigourous error bounds for basic building blocks of double-word arithmetic," ACM Transactions on Mathematical Software, vol. 44, no. 2, pp. 1-27, 2017.
+//   [2] S. Boldo and J.-M. Muller, "Some Functions Computable with a Fused-Mac," in 17th IEEE Symposium on Computer Arithmetic (ARITH'05), Cape Cod, MA, USA, 2005, pp. 52-58.
+//   [3] V. Popescu, "Towards fast and certified multiple-precision librairies," Theses, Université de Lyon, 2017
+//   [4] C.-P. Jeannerod, J.-M. Muller, and P. Zimmermann, “On Various Ways to Split a Floating-Point Number,” in 2018 IEEE 25th Symposium on Computer Arithmetic (ARITH), Amherst, MA, Jun. 2018, pp. 53–60, doi: 10.1109/ARITH.2018.8464793.
+//   [5] A. H. Karp and P. Markstein, "High-precision division and square root," ACM Transactions on Mathematical Software, vol. 23, no. 4, pp. 561-589, 1997.
+//   [6] S. Graillat, P. Langlois, and N. Louvet, "Algorithms for accurate, validated and fast polynomial evaluation," Japan Journal of Industrial and Applied Mathematics, vol. 26, no. 2-3, pp. 191-214, 2009.
+
+// Do not allow unsafe optimizations when compiling any source which uses this code.
+
+// Four-lane AVX2/FMA versions of the operations in DD_arithmetic.h.  A DD4 holds four double-double values with the high parts in
+// one __m256d and the low parts in another.  Each function performs, lane by lane, exactly the same sequence of operations as the
+// scalar function of the same name so the results are bitwise identical.
+
+#if !defined(_DD_ARITHMETIC_AVX2_H)
+#define _DD_ARITHMETIC_AVX2_H 1
+
+#include <float.h>
+
+#include <immintrin.h>
+
+#if !defined(__AVX2__) || !defined(__FMA__)
+#error "DD_arithmetic_avx2.h requires AVX2 and FMA"
+#endif
+
+typedef struct {
+    __m256d high;
+    __m256d low;
+} DD4;
+
+#define DD4_HI(x) ((x).high)
+#define DD4_LO(x) ((x).low)
+
+// -DD4 -> DD4
+static inline DD4
+negate_DD4_DD4(const DD4 x) {
+    DD4 result;
+    DD4_HI(result) = _mm256_xor_pd(DD4_HI(x), _mm256_set1_pd(-0.0));
+    DD4_LO(result) = _mm256_xor_pd(DD4_LO(x), _mm256_set1_pd(-0.0));
+    return result;
+}
+
+// D4, D4 -> DD4
+static inline DD4
+load_D4_D4_DD4(const __m256d hi, const __m256d lo) {
+    DD4 result;
+    DD4_HI(result) = hi;
+    DD4_LO(result) = lo;
+    return result;
+}
+
+// DD4 -> D4, D4
+static inline void
+unpack_DD4_D4_D4(const DD4 x, __m256d* y, __m256d* z) {
+    *y = DD4_HI(x);
+    *z = DD4_LO(x);
+    return;
+}
+
+// Split doubles into two doubles using Veltkamp's splitting with FMA.
+// See Ref [4], algorithm 4.
+static inline void
+split_D4_D4_D4(const __m256d x, __m256d* hi, __m256d* lo) {
+    const __m256d C1 = _mm256_set1_pd(-134217728.0); // -2^ceil(DBL_MANT_DIG / 2)
+    const __m256d C2 = _mm256_set1_pd(+134217729.0); //  2^ceil(DBL_MANT_DIG / 2) + 1
+    __m256d t = _mm256_mul_pd(C2, x);
+    *hi = _mm256_fmadd_pd(C1, x, t);
+    *lo = _mm256_fmsub_pd(C2, x, t); // Same as x - *hi;
+    return;
+}
+
+// D4 + D4 -> DD4
+// See Ref[1], algorithm 2.
+static inline DD4
+add_D4_D4_DD4(const __m256d x, const __m256d y) {
+    DD4 result;
+    DD4_HI(result) = _mm256_add_pd(x, y);
+    __m256d x_virt = _mm256_sub_pd(DD4_HI(result), y);
+    __m256d y_virt = _mm256_sub_pd(DD4_HI(result), x_virt);
+    DD4_LO(result) = _mm256_add_pd(_mm256_sub_pd(x, x_virt), _mm256_sub_pd(y, y_virt));
+    return result;
+}
+
+// D4 + D4 -> DD4
+// See Ref[1], algorithm 1.
+// Assumes |x| >= |y| in every lane.
+static inline DD4
+fast_add_D4_D4_DD4(const __m256d x, const __m256d y) {
+    DD4 result;
+    DD4_HI(result) = _mm256_add_pd(x, y);
+    DD4_LO(result) = _mm256_sub_pd(y, _mm256_sub_pd(DD4_HI(result), x));
+    return result;
+}
+
+// DD4 + D4 -> DD4
+// See Ref[1], algorithm 4.
+static inline DD4
+add_DD4_D4_DD4(const DD4 x, const __m256d y) {
+    DD4 s = add_D4_D4_DD4(DD4_HI(x), y);
+    DD4 result = fast_add_D4_D4_DD4(DD4_HI(s), _mm256_add_pd(DD4_LO(x), DD4_LO(s)));
+    return result;
+}
+
+// DD4 + DD4 -> DD4
+// See Ref[1], algorithm 6.
+static inline DD4
+add_DD4_DD4_DD4(const DD4 x, const DD4 y) {
+    DD4 s = add_D4_D4_DD4(DD4_HI(x), DD4_HI(y));
+    DD4 t = add_D4_D4_DD4(DD4_LO(x), DD4_LO(y));
+    __m256d c = _mm256_add_pd(DD4_LO(s), DD4_HI(t));
+    DD4 v = fast_add_D4_D4_DD4(DD4_HI(s), c);
+    __m256d w = _mm256_add_pd(DD4_LO(t), DD4_LO(v));
+    DD4 result = fast_add_D4_D4_DD4(DD4_HI(v), w);
+    return result;
+}
+
+// D4 * D4 -> DD4
+// See Ref [1], algorithm 3
+static inline DD4
+mul_D4_D4_DD4(const __m256d x, const __m256d y) {
+    DD4 result;
+    DD4_HI(result) = _mm256_mul_pd(x, y);
+    DD4_LO(result) = _mm256_fmsub_pd(x, y, DD4_HI(result));
+    return result;
+}
+
+// D4 * D4 -> DD4
+// Same as mul_D4_D4_DD4 except specialized for x = y.
+static inline DD4
+sqr_D4_DD4(const __m256d x) {
+    DD4 result;
+    DD4_HI(result) = _mm256_mul_pd(x, x);
+    DD4_LO(result) = _mm256_fmsub_pd(x, x, DD4_HI(result));
+    return result;
+}
+
+// DD4 * D4 -> DD4
+// See Ref [1], algorithm 9 or Ref [3], algorithm 12.
+static inline DD4
+mul_DD4_D4_DD4(const DD4 x, const __m256d y) {
+    DD4 c = mul_D4_D4_DD4(DD4_HI(x), y);
+    DD4 result = fast_add_D4_D4_DD4(DD4_HI(c), _mm256_fmadd_pd(DD4_LO(x), y, DD4_LO(c)));
+    return result;
+}
+
+// DD4 * DD4 -> DD4
+// See Ref. [1], algorithm 12 or Ref. [3], algorithm 15.
+static inline DD4
+mul_DD4_DD4_DD4(const DD4 x, const DD4 y) {
+    DD4 c = mul_D4_D4_DD4(DD4_HI(x), DD4_HI(y));
+    __m256d tl0 = _mm256_mul_pd(DD4_LO(x), DD4_LO(y));
+    __m256d tl1 = _mm256_fmadd_pd(DD4_HI(x), DD4_LO(y), tl0);
+    __m256d cl2 = _mm256_fmadd_pd(DD4_LO(x), DD4_HI(y), tl1);
+    __m256d cl3 = _mm256_add_pd(DD4_LO(c), cl2);
+    DD4 result = fast_add_D4_D4_DD4(DD4_HI(c), cl3);
+    return result;
+}
+
+// DD4 / D4 -> DD4
+// See Ref [1], algorithm 15.  However, see for corrections to algorithm 15.  (In Ref. [3], it's algorithm 17.)
+static inline DD4
+div_DD4_D4_DD4(const DD4 x, const __m256d y) {
+    __m256d t_hi = _mm256_div_pd(DD4_HI(x), y);
+    DD4 pi = mul_D4_D4_DD4(t_hi, y);
+    DD4 delta = load_D4_D4_DD4(_mm256_sub_pd(DD4_HI(x), DD4_HI(pi)), _mm256_sub_pd(DD4_LO(x), DD4_LO(pi)));
+    __m256d delta_1 = _mm256_add_pd(DD4_HI(delta), DD4_LO(delta));
+    __m256d t_lo = _mm256_div_pd(delta_1, y);
+    DD4 result = fast_add_D4_D4_DD4(t_hi, t_lo);
+    return result;
+}
+
+// DD4 / DD4 -> DD4
+// See Ref [1], algorithm 18.  (Or algorithm 18 in Ref. [3].)
+static inline DD4
+div_DD4_DD4_DD4(const DD4 x, const DD4 y) {
+    __m256d t = _mm256_div_pd(_mm256_set1_pd(1.0), DD4_HI(y));
+    DD4 r;
+    DD4_HI(r) = _mm256_fnmadd_pd(DD4_HI(y), t, _mm256_set1_pd(1.0));
+    DD4_LO(r) = _mm256_mul_pd(_mm256_xor_pd(DD4_LO(y), _mm256_set1_pd(-0.0)), t);
+    DD4 e = fast_add_D4_D4_DD4(DD4_HI(r), DD4_LO(r));
+    DD4 delta = mul_DD4_D4_DD4(e, t);
+    DD4 m = add_DD4_D4_DD4(delta, t);
+    DD4 result = mul_DD4_DD4_DD4(x, m);
+    return result;
+}
+
+// 1 / D4 -> D4, see rcp_D_D.  Assumes 2^-1022 <= |x| < 2^1023.
+static inline __m256d
+rcp_D4_D4(const __m256d x) {
+    const __m256i exponent_mask = _mm256_set1_epi64x(0x7ffLL << (DBL_MANT_DIG - 1));
+    const __m256d one = _mm256_set1_pd(1.0);
+    __m256i bits = _mm256_castpd_si256(x);
+    __m256i exponent = _mm256_srli_epi64(_mm256_and_si256(bits, exponent_mask), DBL_MANT_DIG - 1);
+    // m = +-[1, 2) and 1 / x = (1 / m) * scale.
+    __m256i mantissa = _mm256_andnot_si256(exponent_mask, bits);
+    __m256d m = _mm256_castsi256_pd(_mm256_or_si256(mantissa, _mm256_set1_epi64x(0x3ffLL << (DBL_MANT_DIG - 1))));
+    __m256d scale = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_sub_epi64(_mm256_set1_epi64x(0x7fe), exponent), DBL_MANT_DIG - 1));
+    __m256d y = _mm256_mul_pd(_mm256_cvtps_pd(_mm_rcp_ps(_mm256_cvtpd_ps(m))), scale);
+    __m256d e = _mm256_fnmadd_pd(x, y, one);
+    __m256d p = _mm256_fmadd_pd(e, _mm256_fmadd_pd(e, _mm256_add_pd(one, e), one), one);
+    return _mm256_fmadd_pd(_mm256_mul_pd(y, e), p, y);
+}
+
+// 1 / sqrt(D4) -> D4, see rsqrt_D_D.  Assumes x >= 2^-1022 and finite.
+static inline __m256d
+rsqrt_D4_D4(const __m256d x) {
+    const __m256i exponent_mask = _mm256_set1_epi64x(0x7ffLL << (DBL_MANT_DIG - 1));
+    const __m256i one_i = _mm256_set1_epi64x(1);
+    __m256i bits = _mm256_castpd_si256(x);
+    __m256i exponent = _mm256_srli_epi64(_mm256_and_si256(bits, exponent_mask), DBL_MANT_DIG - 1);
+    // x = m * 4^k with m in [1, 4) and scale = 2^-k; twice the biased exponent of scale is 0x7fe + m_exponent - exponent.
+    __m256i m_exponent = _mm256_add_epi64(_mm256_set1_epi64x(0x3ff), _mm256_and_si256(_mm256_add_epi64(exponent, one_i), one_i));
+    __m256i mantissa = _mm256_andnot_si256(exponent_mask, bits);
+    __m256d m = _mm256_castsi256_pd(_mm256_or_si256(mantissa, _mm256_slli_epi64(m_exponent, DBL_MANT_DIG - 1)));
+    __m256i twice_scale_exponent = _mm256_sub_epi64(_mm256_add_epi64(_mm256_set1_epi64x(0x7fe), m_exponent), exponent);
+    __m256d scale = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_srli_epi64(twice_scale_exponent, 1), DBL_MANT_DIG - 1));
+    __m256d y = _mm256_mul_pd(_mm256_cvtps_pd(_mm_rsqrt_ps(_mm256_cvtpd_ps(m))), scale);
+    __m256d r = _mm256_fnmadd_pd(_mm256_mul_pd(x, y), y, _mm256_set1_pd(1.0));
+    __m256d p = _mm256_fmadd_pd(r, _mm256_set1_pd(63.0 / 256.0), _mm256_set1_pd(35.0 / 128.0));
+    p = _mm256_fmadd_pd(r, p, _mm256_set1_pd(5.0 / 16.0));
+    p = _mm256_fmadd_pd(r, p, _mm256_set1_pd(3.0 / 8.0));
+    p = _mm256_fmadd_pd(r, p, _mm256_set1_pd(0.5));
+    return _mm256_fmadd_pd(_mm256_mul_pd(y, r), p, y);
+}
+
+// 1 / DD4 -> DD4, see rcp_DD_DD.
+static inline DD4
+rcp_DD4_DD4(const DD4 x) {
+    __m256d y = rcp_D4_D4(DD4_HI(x));
+    __m256d e = _mm256_sub_pd(_mm256_fnmadd_pd(DD4_HI(x), y, _mm256_set1_pd(1.0)), _mm256_mul_pd(DD4_LO(x), y));
+    DD4 result = fast_add_D4_D4_DD4(y, _mm256_mul_pd(y, e));
+    return result;
+}
+
+// 1 / sqrt(DD4) -> DD4, see rsqrt_DD_DD.
+static inline DD4
+rsqrt_DD4_DD4(const DD4 x) {
+    __m256d y = rsqrt_D4_D4(DD4_HI(x));
+    DD4 p = mul_DD4_DD4_DD4(x, sqr_D4_DD4(y));
+    __m256d r = _mm256_sub_pd(_mm256_sub_pd(_mm256_set1_pd(1.0), DD4_HI(p)), DD4_LO(p));
+    DD4 result = fast_add_D4_D4_DD4(y, _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(0.5), y), r));
+    return result;
+}
+
+// sqrt(DD4) -> DD4, see sqrt_DD_DD.
+static inline DD4
+sqrt_DD4_DD4(const DD4 x) {
+    __m256d y = rsqrt_D4_D4(DD4_HI(x));
+    __m256d s = _mm256_mul_pd(DD4_HI(x), y);
+    __m256d d = _mm256_add_pd(_mm256_fnmadd_pd(s, s, DD4_HI(x)), DD4_LO(x));
+    DD4 result = fast_add_D4_D4_DD4(s, _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(0.5), y), d));
+    return result;
+}
+
+// Polynomial evaluation, see horner_D_D, comp_horner_D_DD, comp_horner_DD_DD and estrin_D_DD in DD_arithmetic.h.  The coefficients
+// a[0 .. n-1] are doubles shared by all the lanes; n <= DD_POLY_MAX_COEFFS.
+#define DD_POLY_MAX_COEFFS 16
+
+// p(D4) -> D4
+static inline __m256d
+horner_D4_D4(const double* a, const int n, const __m256d x) {
+    __m256d s = _mm256_set1_pd(a[0]);
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 16
+#endif
+    for (int i = 1; i < n; i++) s = _mm256_fmadd_pd(s, x, _mm256_set1_pd(a[i]));
+    return s;
+}
+
+// p(D4) -> DD4, compensated Horner.
+static inline DD4
+comp_horner_D4_DD4(const double* a, const int n, const __m256d x) {
+    __m256d s = _mm256_set1_pd(a[0]);
+    __m256d c = _mm256_setzero_pd();
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 16
+#endif
+    for (int i = 1; i < n; i++) {
+        DD4 p = mul_D4_D4_DD4(s, x);
+        DD4 t = add_D4_D4_DD4(DD4_HI(p), _mm256_set1_pd(a[i]));
+        s = DD4_HI(t);
+        c = _mm256_fmadd_pd(c, x, _mm256_add_pd(DD4_LO(p), DD4_LO(t)));
+    }
+    DD4 result = add_D4_D4_DD4(s, c);
+    return result;
+}
+
+// p(DD4) -> DD4, compensated Horner at hi plus lo * p'(hi).
+static inline DD4
+comp_horner_DD4_DD4(const double* a, const int n, const DD4 x) {
+    __m256d s = _mm256_set1_pd(a[0]);
+    __m256d c = _mm256_setzero_pd();
+    __m256d d = _mm256_setzero_pd();
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 16
+#endif
+    for (int i = 1; i < n; i++) {
+        d = _mm256_fmadd_pd(d, DD4_HI(x), s);
+        DD4 p = mul_D4_D4_DD4(s, DD4_HI(x));
+        DD4 t = add_D4_D4_DD4(DD4_HI(p), _mm256_set1_pd(a[i]));
+        s = DD4_HI(t);
+        c = _mm256_fmadd_pd(c, DD4_HI(x), _mm256_add_pd(DD4_LO(p), DD4_LO(t)));
+    }
+    DD4 result = add_D4_D4_DD4(s, _mm256_fmadd_pd(DD4_LO(x), d, c));
+    return result;
+}
+
+// p(D4) -> DD4, Estrin's scheme with double-double accumulation.
+static inline DD4
+estrin_D4_DD4(const double* a, const int n, const __m256d x) {
+    DD4 t[(DD_POLY_MAX_COEFFS + 1) / 2];
+    int m = 0;
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 16
+#endif
+    for (int k = n - 1; k > 0; k -= 2) t[m++] = add_DD4_D4_DD4(mul_D4_D4_DD4(_mm256_set1_pd(a[k - 1]), x), _mm256_set1_pd(a[k]));
+    if (n % 2 != 0) t[m++] = load_D4_D4_DD4(_mm256_set1_pd(a[0]), _mm256_setzero_pd());
+    DD4 power = sqr_D4_DD4(x);
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 4
+#endif
+    while (m > 1) {
+        int j = 0;
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 8
+#endif
+        for (int i = 0; i + 1 < m; i += 2) t[j++] = add_DD4_DD4_DD4(t[i], mul_DD4_DD4_DD4(t[i + 1], power));
+        if (m % 2 != 0) t[j++] = t[m - 1];
+        m = j;
+        if (m > 1) power = mul_DD4_DD4_DD4(power, power);
+    }
+    return t[0];
+}
+
+#endif // _DD_ARITHMETIC_AVX2_H
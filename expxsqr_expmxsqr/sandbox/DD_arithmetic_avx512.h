@@ -0,0 +1,357 @@
+// -*-  mode: C; tab-width:4; fill-column: 132; comment-start:  "// "; comment-end:  ""; coding: utf-8;  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// References:
+//   [1] M. M. Joldes, J.-M. Muller, and V. Popescu, "Tight and rigourous error bounds for basic building blocks of double-word arithmetic," ACM Transactions on Mathematical Software, vol. 44, no. 2, pp. 1-27, 2017.
+//   [2] S. Boldo and J.-M. Muller, "Some Functions Computable with a Fused-Mac," in 17th IEEE Symposium on Computer Arithmetic (ARITH'05), Cape Cod, MA, USA, 2005, pp. 52-58.
+//   [3] V. Popescu, "Towards fast and certified multiple-precision librairies," Theses, Université de Lyon, 2017
+//   [4] C.-P. Jeannerod, J.-M. Muller, and P. Zimmermann, “On Various Ways to Split a Floating-Point Number,” in 2018 IEEE 25th Symposium on Computer Arithmetic (ARITH), Amherst, MA, Jun. 2018, pp. 53–60, doi: 10.1109/ARITH.2018.8464793.
+//   [5] A. H. Karp and P. Markstein, "High-precision division and square root," ACM Transactions on Mathematical Software, vol. 23, no. 4, pp. 561-589, 1997.
+//   [6] S. Graillat, P. Langlois, and N. Louvet, "Algorithms for accurate, validated and fast polynomial evaluation," Japan Journal of Industrial and Applied Mathematics, vol. 26, no. 2-3, pp. 191-214, 2009.
+
+// Do not allow unsafe optimizations when compiling any source which uses this code.
+
+// Eight-lane AVX-512 versions of the operations in DD_arithmetic.h.  A DD8 holds eight double-double values with the high parts
+// in one __m512d and the low parts in another.  Each function performs, lane by lane, exactly the same sequence of operations as the
+// scalar function of the same name so the results are bitwise identical.
+
+#if !defined(_DD_ARITHMETIC_AVX512_H)
+#define _DD_ARITHMETIC_AVX512_H 1
+
+#include <float.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#if !defined(__AVX512F__)
+#error "DD_arithmetic_avx512.h requires AVX-512F"
+#endif
+
+typedef struct {
+    __m512d high;
+    __m512d low;
+} DD8;
+
+#define DD8_HI(x) ((x).high)
+#define DD8_LO(x) ((x).low)
+
+// -DD8 -> DD8
+static inline DD8
+negate_DD8_DD8(const DD8 x) {
+    DD8 result;
+    DD8_HI(result) = _mm512_castsi512_pd(_mm512_xor_epi64(_mm512_castpd_si512(DD8_HI(x)), _mm512_set1_epi64(INT64_MIN)));
+    DD8_LO(result) = _mm512_castsi512_pd(_mm512_xor_epi64(_mm512_castpd_si512(DD8_LO(x)), _mm512_set1_epi64(INT64_MIN)));
+    return result;
+}
+
+// D8, D8 -> DD8
+static inline DD8
+load_D8_D8_DD8(const __m512d hi, const __m512d lo) {
+    DD8 result;
+    DD8_HI(result) = hi;
+    DD8_LO(result) = lo;
+    return result;
+}
+
+// DD8 -> D8, D8
+static inline void
+unpack_DD8_D8_D8(const DD8 x, __m512d* y, __m512d* z) {
+    *y = DD8_HI(x);
+    *z = DD8_LO(x);
+    return;
+}
+
+// Split doubles into two doubles using Veltkamp's splitting with FMA.
+// See Ref [4], algorithm 4.
+static inline void
+split_D8_D8_D8(const __m512d x, __m512d* hi, __m512d* lo) {
+    const __m512d C1 = _mm512_set1_pd(-134217728.0); // -2^ceil(DBL_MANT_DIG / 2)
+    const __m512d C2 = _mm512_set1_pd(+134217729.0); //  2^ceil(DBL_MANT_DIG / 2) + 1
+    __m512d t = _mm512_mul_pd(C2, x);
+    *hi = _mm512_fmadd_pd(C1, x, t);
+    *lo = _mm512_fmsub_pd(C2, x, t); // Same as x - *hi;
+    return;
+}
+
+// D8 + D8 -> DD8
+// See Ref[1], algorithm 2.
+static inline DD8
+add_D8_D8_DD8(const __m512d x, const __m512d y) {
+    DD8 result;
+    DD8_HI(result) = _mm512_add_pd(x, y);
+    __m512d x_virt = _mm512_sub_pd(DD8_HI(result), y);
+    __m512d y_virt = _mm512_sub_pd(DD8_HI(result), x_virt);
+    DD8_LO(result) = _mm512_add_pd(_mm512_sub_pd(x, x_virt), _mm512_sub_pd(y, y_virt));
+    return result;
+}
+
+// D8 + D8 -> DD8
+// See Ref[1], algorithm 1.
+// Assumes |x| >= |y| in every lane.
+static inline DD8
+fast_add_D8_D8_DD8(const __m512d x, const __m512d y) {
+    DD8 result;
+    DD8_HI(result) = _mm512_add_pd(x, y);
+    DD8_LO(result) = _mm512_sub_pd(y, _mm512_sub_pd(DD8_HI(result), x));
+    return result;
+}
+
+// DD8 + D8 -> DD8
+// See Ref[1], algorithm 4.
+static inline DD8
+add_DD8_D8_DD8(const DD8 x, const __m512d y) {
+    DD8 s = add_D8_D8_DD8(DD8_HI(x), y);
+    DD8 result = fast_add_D8_D8_DD8(DD8_HI(s), _mm512_add_pd(DD8_LO(x), DD8_LO(s)));
+    return result;
+}
+
+// DD8 + DD8 -> DD8
+// See Ref[1], algorithm 6.
+static inline DD8
+add_DD8_DD8_DD8(const DD8 x, const DD8 y) {
+    DD8 s = add_D8_D8_DD8(DD8_HI(x), DD8_HI(y));
+    DD8 t = add_D8_D8_DD8(DD8_LO(x), DD8_LO(y));
+    __m512d c = _mm512_add_pd(DD8_LO(s), DD8_HI(t));
+    DD8 v = fast_add_D8_D8_DD8(DD8_HI(s), c);
+    __m512d w = _mm512_add_pd(DD8_LO(t), DD8_LO(v));
+    DD8 result = fast_add_D8_D8_DD8(DD8_HI(v), w);
+    return result;
+}
+
+// D8 * D8 -> DD8
+// See Ref [1], algorithm 3
+static inline DD8
+mul_D8_D8_DD8(const __m512d x, const __m512d y) {
+    DD8 result;
+    DD8_HI(result) = _mm512_mul_pd(x, y);
+    DD8_LO(result) = _mm512_fmsub_pd(x, y, DD8_HI(result));
+    return result;
+}
+
+// D8 * D8 -> DD8
+// Same as mul_D8_D8_DD8 except specialized for x = y.
+static inline DD8
+sqr_D8_DD8(const __m512d x) {
+    DD8 result;
+    DD8_HI(result) = _mm512_mul_pd(x, x);
+    DD8_LO(result) = _mm512_fmsub_pd(x, x, DD8_HI(result));
+    return result;
+}
+
+// DD8 * D8 -> DD8
+// See Ref [1], algorithm 9 or Ref [3], algorithm 12.
+static inline DD8
+mul_DD8_D8_DD8(const DD8 x, const __m512d y) {
+    DD8 c = mul_D8_D8_DD8(DD8_HI(x), y);
+    DD8 result = fast_add_D8_D8_DD8(DD8_HI(c), _mm512_fmadd_pd(DD8_LO(x), y, DD8_LO(c)));
+    return result;
+}
+
+// DD8 * DD8 -> DD8
+// See Ref. [1], algorithm 12 or Ref. [3], algorithm 15.
+static inline DD8
+mul_DD8_DD8_DD8(const DD8 x, const DD8 y) {
+    DD8 c = mul_D8_D8_DD8(DD8_HI(x), DD8_HI(y));
+    __m512d tl0 = _mm512_mul_pd(DD8_LO(x), DD8_LO(y));
+    __m512d tl1 = _mm512_fmadd_pd(DD8_HI(x), DD8_LO(y), tl0);
+    __m512d cl2 = _mm512_fmadd_pd(DD8_LO(x), DD8_HI(y), tl1);
+    __m512d cl3 = _mm512_add_pd(DD8_LO(c), cl2);
+    DD8 result = fast_add_D8_D8_DD8(DD8_HI(c), cl3);
+    return result;
+}
+
+// DD8 / D8 -> DD8
+// See Ref [1], algorithm 15.  However, see for corrections to algorithm 15.  (In Ref. [3], it's algorithm 17.)
+static inline DD8
+div_DD8_D8_DD8(const DD8 x, const __m512d y) {
+    __m512d t_hi = _mm512_div_pd(DD8_HI(x), y);
+    DD8 pi = mul_D8_D8_DD8(t_hi, y);
+    DD8 delta = load_D8_D8_DD8(_mm512_sub_pd(DD8_HI(x), DD8_HI(pi)), _mm512_sub_pd(DD8_LO(x), DD8_LO(pi)));
+    __m512d delta_1 = _mm512_add_pd(DD8_HI(delta), DD8_LO(delta));
+    __m512d t_lo = _mm512_div_pd(delta_1, y);
+    DD8 result = fast_add_D8_D8_DD8(t_hi, t_lo);
+    return result;
+}
+
+// DD8 / DD8 -> DD8
+// See Ref [1], algorithm 18.  (Or algorithm 18 in Ref. [3].)
+static inline DD8
+div_DD8_DD8_DD8(const DD8 x, const DD8 y) {
+    __m512d t = _mm512_div_pd(_mm512_set1_pd(1.0), DD8_HI(y));
+    DD8 r;
+    DD8_HI(r) = _mm512_fnmadd_pd(DD8_HI(y), t, _mm512_set1_pd(1.0));
+    DD8_LO(r) = _mm512_mul_pd(_mm512_castsi512_pd(_mm512_xor_epi64(_mm512_castpd_si512(DD8_LO(y)), _mm512_set1_epi64(INT64_MIN))), t);
+    DD8 e = fast_add_D8_D8_DD8(DD8_HI(r), DD8_LO(r));
+    DD8 delta = mul_DD8_D8_DD8(e, t);
+    DD8 m = add_DD8_D8_DD8(delta, t);
+    DD8 result = mul_DD8_DD8_DD8(x, m);
+    return result;
+}
+
+// 1 / D8 -> D8, see rcp_D_D.  Assumes 2^-1022 <= |x| < 2^1023.
+static inline __m512d
+rcp_D8_D8(const __m512d x) {
+    const __m512i exponent_mask = _mm512_set1_epi64(0x7ffLL << (DBL_MANT_DIG - 1));
+    const __m512d one = _mm512_set1_pd(1.0);
+    __m512i bits = _mm512_castpd_si512(x);
+    __m512i exponent = _mm512_srli_epi64(_mm512_and_epi64(bits, exponent_mask), DBL_MANT_DIG - 1);
+    // m = +-[1, 2) and 1 / x = (1 / m) * scale.
+    __m512i mantissa = _mm512_andnot_epi64(exponent_mask, bits);
+    __m512d m = _mm512_castsi512_pd(_mm512_or_epi64(mantissa, _mm512_set1_epi64(0x3ffLL << (DBL_MANT_DIG - 1))));
+    __m512d scale = _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_sub_epi64(_mm512_set1_epi64(0x7fe), exponent), DBL_MANT_DIG - 1));
+    __m512d y = _mm512_mul_pd(_mm512_cvtps_pd(_mm256_rcp_ps(_mm512_cvtpd_ps(m))), scale);
+    __m512d e = _mm512_fnmadd_pd(x, y, one);
+    __m512d p = _mm512_fmadd_pd(e, _mm512_fmadd_pd(e, _mm512_add_pd(one, e), one), one);
+    return _mm512_fmadd_pd(_mm512_mul_pd(y, e), p, y);
+}
+
+// 1 / sqrt(D8) -> D8, see rsqrt_D_D.  Assumes x >= 2^-1022 and finite.
+static inline __m512d
+rsqrt_D8_D8(const __m512d x) {
+    const __m512i exponent_mask = _mm512_set1_epi64(0x7ffLL << (DBL_MANT_DIG - 1));
+    const __m512i one_i = _mm512_set1_epi64(1);
+    __m512i bits = _mm512_castpd_si512(x);
+    __m512i exponent = _mm512_srli_epi64(_mm512_and_epi64(bits, exponent_mask), DBL_MANT_DIG - 1);
+    // x = m * 4^k with m in [1, 4) and scale = 2^-k; twice the biased exponent of scale is 0x7fe + m_exponent - exponent.
+    __m512i m_exponent = _mm512_add_epi64(_mm512_set1_epi64(0x3ff), _mm512_and_epi64(_mm512_add_epi64(exponent, one_i), one_i));
+    __m512i mantissa = _mm512_andnot_epi64(exponent_mask, bits);
+    __m512d m = _mm512_castsi512_pd(_mm512_or_epi64(mantissa, _mm512_slli_epi64(m_exponent, DBL_MANT_DIG - 1)));
+    __m512i twice_scale_exponent = _mm512_sub_epi64(_mm512_add_epi64(_mm512_set1_epi64(0x7fe), m_exponent), exponent);
+    __m512d scale = _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_srli_epi64(twice_scale_exponent, 1), DBL_MANT_DIG - 1));
+    __m512d y = _mm512_mul_pd(_mm512_cvtps_pd(_mm256_rsqrt_ps(_mm512_cvtpd_ps(m))), scale);
+    __m512d r = _mm512_fnmadd_pd(_mm512_mul_pd(x, y), y, _mm512_set1_pd(1.0));
+    __m512d p = _mm512_fmadd_pd(r, _mm512_set1_pd(63.0 / 256.0), _mm512_set1_pd(35.0 / 128.0));
+    p = _mm512_fmadd_pd(r, p, _mm512_set1_pd(5.0 / 16.0));
+    p = _mm512_fmadd_pd(r, p, _mm512_set1_pd(3.0 / 8.0));
+    p = _mm512_fmadd_pd(r, p, _mm512_set1_pd(0.5));
+    return _mm512_fmadd_pd(_mm512_mul_pd(y, r), p, y);
+}
+
+// 1 / DD8 -> DD8, see rcp_DD_DD.
+static inline DD8
+rcp_DD8_DD8(const DD8 x) {
+    __m512d y = rcp_D8_D8(DD8_HI(x));
+    __m512d e = _mm512_sub_pd(_mm512_fnmadd_pd(DD8_HI(x), y, _mm512_set1_pd(1.0)), _mm512_mul_pd(DD8_LO(x), y));
+    DD8 result = fast_add_D8_D8_DD8(y, _mm512_mul_pd(y, e));
+    return result;
+}
+
+// 1 / sqrt(DD8) -> DD8, see rsqrt_DD_DD.
+static inline DD8
+rsqrt_DD8_DD8(const DD8 x) {
+    __m512d y = rsqrt_D8_D8(DD8_HI(x));
+    DD8 p = mul_DD8_DD8_DD8(x, sqr_D8_DD8(y));
+    __m512d r = _mm512_sub_pd(_mm512_sub_pd(_mm512_set1_pd(1.0), DD8_HI(p)), DD8_LO(p));
+    DD8 result = fast_add_D8_D8_DD8(y, _mm512_mul_pd(_mm512_mul_pd(_mm512_set1_pd(0.5), y), r));
+    return result;
+}
+
+// sqrt(DD8) -> DD8, see sqrt_DD_DD.
+static inline DD8
+sqrt_DD8_DD8(const DD8 x) {
+    __m512d y = rsqrt_D8_D8(DD8_HI(x));
+    __m512d s = _mm512_mul_pd(DD8_HI(x), y);
+    __m512d d = _mm512_add_pd(_mm512_fnmadd_pd(s, s, DD8_HI(x)), DD8_LO(x));
+    DD8 result = fast_add_D8_D8_DD8(s, _mm512_mul_pd(_mm512_mul_pd(_mm512_set1_pd(0.5), y), d));
+    return result;
+}
+
+// Polynomial evaluation, see horner_D_D, comp_horner_D_DD, comp_horner_DD_DD and estrin_D_DD in DD_arithmetic.h.  The coefficients
+// a[0 .. n-1] are doubles shared by all the lanes; n <= DD_POLY_MAX_COEFFS.
+#define DD_POLY_MAX_COEFFS 16
+
+// p(D8) -> D8
+static inline __m512d
+horner_D8_D8(const double* a, const int n, const __m512d x) {
+    __m512d s = _mm512_set1_pd(a[0]);
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 16
+#endif
+    for (int i = 1; i < n; i++) s = _mm512_fmadd_pd(s, x, _mm512_set1_pd(a[i]));
+    return s;
+}
+
+// p(D8) -> DD8, compensated Horner.
+static inline DD8
+comp_horner_D8_DD8(const double* a, const int n, const __m512d x) {
+    __m512d s = _mm512_set1_pd(a[0]);
+    __m512d c = _mm512_setzero_pd();
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 16
+#endif
+    for (int i = 1; i < n; i++) {
+        DD8 p = mul_D8_D8_DD8(s, x);
+        DD8 t = add_D8_D8_DD8(DD8_HI(p), _mm512_set1_pd(a[i]));
+        s = DD8_HI(t);
+        c = _mm512_fmadd_pd(c, x, _mm512_add_pd(DD8_LO(p), DD8_LO(t)));
+    }
+    DD8 result = add_D8_D8_DD8(s, c);
+    return result;
+}
+
+// p(DD8) -> DD8, compensated Horner at hi plus lo * p'(hi).
+static inline DD8
+comp_horner_DD8_DD8(const double* a, const int n, const DD8 x) {
+    __m512d s = _mm512_set1_pd(a[0]);
+    __m512d c = _mm512_setzero_pd();
+    __m512d d = _mm512_setzero_pd();
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 16
+#endif
+    for (int i = 1; i < n; i++) {
+        d = _mm512_fmadd_pd(d, DD8_HI(x), s);
+        DD8 p = mul_D8_D8_DD8(s, DD8_HI(x));
+        DD8 t = add_D8_D8_DD8(DD8_HI(p), _mm512_set1_pd(a[i]));
+        s = DD8_HI(t);
+        c = _mm512_fmadd_pd(c, DD8_HI(x), _mm512_add_pd(DD8_LO(p), DD8_LO(t)));
+    }
+    DD8 result = add_D8_D8_DD8(s, _mm512_fmadd_pd(DD8_LO(x), d, c));
+    return result;
+}
+
+// p(D8) -> DD8, Estrin's scheme with double-double accumulation.
+static inline DD8
+estrin_D8_DD8(const double* a, const int n, const __m512d x) {
+    DD8 t[(DD_POLY_MAX_COEFFS + 1) / 2];
+    int m = 0;
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 16
+#endif
+    for (int k = n - 1; k > 0; k -= 2) t[m++] = add_DD8_D8_DD8(mul_D8_D8_DD8(_mm512_set1_pd(a[k - 1]), x), _mm512_set1_pd(a[k]));
+    if (n % 2 != 0) t[m++] = load_D8_D8_DD8(_mm512_set1_pd(a[0]), _mm512_setzero_pd());
+    DD8 power = sqr_D8_DD8(x);
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 4
+#endif
+    while (m > 1) {
+        int j = 0;
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll 8
+#endif
+        for (int i = 0; i + 1 < m; i += 2) t[j++] = add_DD8_DD8_DD8(t[i], mul_DD8_DD8_DD8(t[i + 1], power));
+        if (m % 2 != 0) t[j++] = t[m - 1];
+        m = j;
+        if (m > 1) power = mul_DD8_DD8_DD8(power, power);
+    }
+    return t[0];
+}
+
+#endif // _DD_ARITHMETIC_AVX512_H
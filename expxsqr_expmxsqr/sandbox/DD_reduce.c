@@ -0,0 +1,199 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Double-double accurate sum, dot product and axpy of double arrays (see DD_reduce.h):  the scalar kernels and the multithreaded
+// drivers.
+
+// The drivers call the AVX-512 kernels if the compiler targets AVX-512F, the AVX2/FMA kernels if it targets AVX2 and FMA, otherwise
+// the scalar kernels.  (The sandbox Makefile compiles this file with $(ARRAY_ISA).)  The threads are C11 threads; if the
+// implementation does not provide them (__STDC_NO_THREADS__) or a thread cannot be started, the work is done by the calling thread.
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#if !defined(__STDC_NO_THREADS__)
+#include <threads.h>
+#endif
+
+#include "DD_arithmetic.h"
+#include "DD_reduce.h"
+
+#define DD_REDUCE_MAX_THREADS 256
+
+#if defined(__AVX512F__)
+#define SUM_KERNEL sum_dd_kernel_avx512
+#define DOT_KERNEL dot_dd_kernel_avx512
+#define AXPY_KERNEL axpy_dd_kernel_avx512
+#elif defined(__AVX2__) && defined(__FMA__)
+#define SUM_KERNEL sum_dd_kernel_avx2
+#define DOT_KERNEL dot_dd_kernel_avx2
+#define AXPY_KERNEL axpy_dd_kernel_avx2
+#else
+#define SUM_KERNEL sum_dd_kernel
+#define DOT_KERNEL dot_dd_kernel
+#define AXPY_KERNEL axpy_dd_kernel
+#endif
+
+DD
+sum_dd_kernel(const double* x, const size_t n) {
+    DD lanes[DD_REDUCE_LANES];
+    for (int j = 0; j < DD_REDUCE_LANES; j++) lanes[j] = load_D_D_DD(0.0, 0.0);
+    for (size_t i = 0; i < n; i += DD_REDUCE_LANES) {
+        for (int j = 0; j < DD_REDUCE_LANES; j++) {
+            double v = (i + j < n) ? x[i + j] : 0.0;
+            lanes[j] = add_DD_D_DD(lanes[j], v);
+        }
+    }
+    return reduce_lanes_DD(lanes);
+}
+
+DD
+dot_dd_kernel(const double* x, const double* y, const size_t n) {
+    DD lanes[DD_REDUCE_LANES];
+    for (int j = 0; j < DD_REDUCE_LANES; j++) lanes[j] = load_D_D_DD(0.0, 0.0);
+    for (size_t i = 0; i < n; i += DD_REDUCE_LANES) {
+        for (int j = 0; j < DD_REDUCE_LANES; j++) {
+            double u = (i + j < n) ? x[i + j] : 0.0;
+            double v = (i + j < n) ? y[i + j] : 0.0;
+            lanes[j] = add_DD_DD_DD(lanes[j], mul_D_D_DD(u, v));
+        }
+    }
+    return reduce_lanes_DD(lanes);
+}
+
+void
+axpy_dd_kernel(const double a, const double* x, double* y_hi, double* y_lo, const size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        DD y = add_DD_DD_DD(load_D_D_DD(y_hi[i], y_lo[i]), mul_D_D_DD(a, x[i]));
+        unpack_DD_D_D(y, &y_hi[i], &y_lo[i]);
+    }
+    return;
+}
+
+typedef enum { REDUCE_SUM, REDUCE_DOT, REDUCE_AXPY } reduce_op;
+
+// The share of one thread:  blocks first_block, first_block + block_step, ...
+typedef struct {
+    reduce_op op;
+    double a;
+    const double* x;
+    const double* y;
+    double* y_hi;
+    double* y_lo;
+    size_t n;
+    size_t n_blocks;
+    size_t first_block;
+    size_t block_step;
+    DD* partial; // The result of each block (sum and dot product).
+} reduce_job;
+
+// Run the kernel on block b; returns the block result of the sum or dot product.
+static DD
+run_block(const reduce_job* job, const size_t b) {
+    size_t start = b * DD_REDUCE_BLOCK;
+    size_t count = (job->n - start < DD_REDUCE_BLOCK) ? job->n - start : DD_REDUCE_BLOCK;
+    switch (job->op) {
+    case REDUCE_SUM:
+        return SUM_KERNEL(&job->x[start], count);
+    case REDUCE_DOT:
+        return DOT_KERNEL(&job->x[start], &job->y[start], count);
+    case REDUCE_AXPY:
+        AXPY_KERNEL(job->a, &job->x[start], &job->y_hi[start], &job->y_lo[start], count);
+        break;
+    }
+    return load_D_D_DD(0.0, 0.0);
+}
+
+static int
+reduce_worker(void* arg) {
+    const reduce_job* job = arg;
+    for (size_t b = job->first_block; b < job->n_blocks; b += job->block_step) {
+        DD block_result = run_block(job, b);
+        if (job->partial != NULL) job->partial[b] = block_result;
+    }
+    return 0;
+}
+
+// Share the blocks out among the threads and wait for them.  Returns the sum of the block results, added in block order.
+static DD
+run_reduce(reduce_job job, int threads) {
+    job.n_blocks = (job.n + DD_REDUCE_BLOCK - 1) / DD_REDUCE_BLOCK;
+    if (threads > DD_REDUCE_MAX_THREADS) threads = DD_REDUCE_MAX_THREADS;
+    if ((size_t)threads > job.n_blocks) threads = (int)job.n_blocks;
+    job.partial = NULL;
+    if (threads > 1 && job.op != REDUCE_AXPY) {
+        job.partial = malloc(job.n_blocks * sizeof(DD));
+        if (job.partial == NULL) threads = 1;
+    }
+
+    DD result = load_D_D_DD(0.0, 0.0);
+#if !defined(__STDC_NO_THREADS__)
+    if (threads > 1) {
+        reduce_job jobs[DD_REDUCE_MAX_THREADS];
+        thrd_t ids[DD_REDUCE_MAX_THREADS];
+        int started[DD_REDUCE_MAX_THREADS];
+        for (int t = 0; t < threads; t++) {
+            jobs[t] = job;
+            jobs[t].first_block = (size_t)t;
+            jobs[t].block_step = (size_t)threads;
+        }
+        for (int t = 1; t < threads; t++) started[t] = (thrd_create(&ids[t], reduce_worker, &jobs[t]) == thrd_success);
+        reduce_worker(&jobs[0]);
+        for (int t = 1; t < threads; t++) {
+            if (started[t]) {
+                thrd_join(ids[t], NULL);
+            } else {
+                reduce_worker(&jobs[t]);
+            }
+        }
+        if (job.partial != NULL) {
+            for (size_t b = 0; b < job.n_blocks; b++) result = add_DD_DD_DD(result, job.partial[b]);
+            free(job.partial);
+        }
+        return result;
+    }
+#endif
+    for (size_t b = 0; b < job.n_blocks; b++) {
+        DD block_result = run_block(&job, b);
+        if (job.op != REDUCE_AXPY) result = add_DD_DD_DD(result, block_result);
+    }
+    free(job.partial);
+    return result;
+}
+
+DD
+sum_dd(const double* x, const size_t n, const int threads) {
+    reduce_job job = {.op = REDUCE_SUM, .x = x, .n = n};
+    return run_reduce(job, threads);
+}
+
+DD
+dot_dd(const double* x, const double* y, const size_t n, const int threads) {
+    reduce_job job = {.op = REDUCE_DOT, .x = x, .y = y, .n = n};
+    return run_reduce(job, threads);
+}
+
+void
+axpy_dd(const double a, const double* x, double* y_hi, double* y_lo, const size_t n, const int threads) {
+    reduce_job job = {.op = REDUCE_AXPY, .a = a, .x = x, .y_hi = y_hi, .y_lo = y_lo, .n = n};
+    run_reduce(job, threads);
+    return;
+}
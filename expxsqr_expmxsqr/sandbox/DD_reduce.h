@@ -0,0 +1,70 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Double-double accurate reductions of double arrays:  sum, dot product and axpy (DD_reduce.c, DD_reduce_avx2.c and
+// DD_reduce_avx512.c).
+//
+// The sum and dot product accumulate in DD_REDUCE_LANES independent double-double lanes:  element i of a block goes to lane
+// i % DD_REDUCE_LANES (add_DD_D_DD for the sum, mul_D_D_DD and add_DD_DD_DD for the dot product), the last group of a block is
+// padded with zeros, and at the end of the block the lanes are combined pairwise (reduce_lanes_DD below).  The scalar, AVX2 and
+// AVX-512 kernels all follow this order so their results are bitwise identical.  The arrays are split into blocks of
+// DD_REDUCE_BLOCK elements which are shared out among the threads; the block results are added in block order, so the result does
+// not depend on the number of threads either.
+
+#if !defined(_DD_REDUCE_H)
+#define _DD_REDUCE_H 1
+
+#include <stddef.h>
+
+#include "DD_arithmetic.h"
+
+#define DD_REDUCE_LANES 32
+#define DD_REDUCE_BLOCK 65536 // A multiple of DD_REDUCE_LANES.
+
+// Combine the lanes pairwise:  lane j += lane j + w for w = DD_REDUCE_LANES/2, ... 2, 1.  The result is in lanes[0].
+static inline DD
+reduce_lanes_DD(DD lanes[DD_REDUCE_LANES]) {
+    for (int w = DD_REDUCE_LANES / 2; w > 0; w /= 2) {
+        for (int j = 0; j < w; j++) lanes[j] = add_DD_DD_DD(lanes[j], lanes[j + w]);
+    }
+    return lanes[0];
+}
+
+// sum of x[i], sum of x[i] * y[i] and (y_hi[i], y_lo[i]) += a * x[i] for i = 0, 1, ... n-1, using up to "threads" threads
+// (DD_reduce.c).  The kernel is chosen when DD_reduce.c is compiled, as for the array functions in expxsqr_array.c.
+DD sum_dd(const double* x, const size_t n, const int threads);
+DD dot_dd(const double* x, const double* y, const size_t n, const int threads);
+void axpy_dd(const double a, const double* x, double* y_hi, double* y_lo, const size_t n, const int threads);
+
+// Single-threaded kernels over one block (n <= DD_REDUCE_BLOCK for the sum and dot product).
+DD sum_dd_kernel(const double* x, const size_t n);
+DD dot_dd_kernel(const double* x, const double* y, const size_t n);
+void axpy_dd_kernel(const double a, const double* x, double* y_hi, double* y_lo, const size_t n);
+
+DD sum_dd_kernel_avx2(const double* x, const size_t n);
+DD dot_dd_kernel_avx2(const double* x, const double* y, const size_t n);
+void axpy_dd_kernel_avx2(const double a, const double* x, double* y_hi, double* y_lo, const size_t n);
+
+DD sum_dd_kernel_avx512(const double* x, const size_t n);
+DD dot_dd_kernel_avx512(const double* x, const double* y, const size_t n);
+void axpy_dd_kernel_avx512(const double a, const double* x, double* y_hi, double* y_lo, const size_t n);
+
+#endif // _DD_REDUCE_H
@@ -0,0 +1,118 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// AVX2/FMA kernels of the double-double sum, dot product and axpy (see DD_reduce.h).  The DD_REDUCE_LANES lanes of the sum and dot
+// product are held in 8 DD4 accumulators; each accumulator performs, lane by lane, the same operations as the scalar kernel in
+// DD_reduce.c, so the results are bitwise identical.
+
+#include <stddef.h>
+
+#include <immintrin.h>
+
+#include "DD_arithmetic.h"
+#include "DD_arithmetic_avx2.h"
+#include "DD_reduce.h"
+
+#define N_ACC (DD_REDUCE_LANES / 4)
+
+// Copy the accumulators to lanes and combine them as the scalar kernel does.
+static inline DD
+reduce_acc(const DD4 acc[N_ACC]) {
+    double hi[DD_REDUCE_LANES];
+    double lo[DD_REDUCE_LANES];
+    for (int k = 0; k < N_ACC; k++) {
+        _mm256_storeu_pd(&hi[k * 4], DD4_HI(acc[k]));
+        _mm256_storeu_pd(&lo[k * 4], DD4_LO(acc[k]));
+    }
+    DD lanes[DD_REDUCE_LANES];
+    for (int j = 0; j < DD_REDUCE_LANES; j++) lanes[j] = load_D_D_DD(hi[j], lo[j]);
+    return reduce_lanes_DD(lanes);
+}
+
+DD
+sum_dd_kernel_avx2(const double* x, const size_t n) {
+    DD4 acc[N_ACC];
+    for (int k = 0; k < N_ACC; k++) acc[k] = load_D4_D4_DD4(_mm256_setzero_pd(), _mm256_setzero_pd());
+    size_t i = 0;
+    for (; i + DD_REDUCE_LANES <= n; i += DD_REDUCE_LANES) {
+        for (int k = 0; k < N_ACC; k++) acc[k] = add_DD4_D4_DD4(acc[k], _mm256_loadu_pd(&x[i + k * 4]));
+    }
+    if (i < n) {
+        // The last group is padded with zeros.
+        long long remaining = (long long)(n - i);
+        for (int k = 0; k < N_ACC; k++) {
+            __m256i mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x(remaining - (long long)(k * 4)), _mm256_set_epi64x(3, 2, 1, 0));
+            acc[k] = add_DD4_D4_DD4(acc[k], _mm256_maskload_pd(&x[i + k * 4], mask));
+        }
+    }
+    return reduce_acc(acc);
+}
+
+DD
+dot_dd_kernel_avx2(const double* x, const double* y, const size_t n) {
+    DD4 acc[N_ACC];
+    for (int k = 0; k < N_ACC; k++) acc[k] = load_D4_D4_DD4(_mm256_setzero_pd(), _mm256_setzero_pd());
+    size_t i = 0;
+    for (; i + DD_REDUCE_LANES <= n; i += DD_REDUCE_LANES) {
+        for (int k = 0; k < N_ACC; k++) {
+            DD4 p = mul_D4_D4_DD4(_mm256_loadu_pd(&x[i + k * 4]), _mm256_loadu_pd(&y[i + k * 4]));
+            acc[k] = add_DD4_DD4_DD4(acc[k], p);
+        }
+    }
+    if (i < n) {
+        // The last group is padded with zeros.
+        long long remaining = (long long)(n - i);
+        for (int k = 0; k < N_ACC; k++) {
+            __m256i mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x(remaining - (long long)(k * 4)), _mm256_set_epi64x(3, 2, 1, 0));
+            DD4 p = mul_D4_D4_DD4(_mm256_maskload_pd(&x[i + k * 4], mask), _mm256_maskload_pd(&y[i + k * 4], mask));
+            acc[k] = add_DD4_DD4_DD4(acc[k], p);
+        }
+    }
+    return reduce_acc(acc);
+}
+
+// The last n%4 elements are handled with masked loads and stores.
+// While the arrays are in cache this runs at about 3.4-4x the time of a plain FMA axpy, above the 2-3x of the sum and dot product,
+// and unrolling does not help:  the loop is bound by throughput, not latency.  Per vector a plain axpy issues one FMA, two loads
+// and one store; this kernel issues 22 floating-point operations (mul_D4_D4_DD4 and add_DD4_DD4_DD4), three loads and two stores,
+// since the product is a double-double and so is y.  The sum can use add_DD4_D4_DD4, which takes about half the operations of
+// add_DD4_DD4_DD4.  Adding DD4_LO of the product to y_lo first and then DD4_HI with add_DD4_D4_DD4 would cost about as much as
+// the sum.  But its error would then only be bounded relative to |y| + |a * x|, not to the result, so it is not done.  Once the
+// arrays come from memory the loop is bound by bandwidth, 40 bytes per element against 24, and runs at about 1.8-1.9x plain.
+void
+axpy_dd_kernel_avx2(const double a, const double* x, double* y_hi, double* y_lo, const size_t n) {
+    const __m256d a_vec = _mm256_set1_pd(a);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        DD4 y = load_D4_D4_DD4(_mm256_loadu_pd(&y_hi[i]), _mm256_loadu_pd(&y_lo[i]));
+        y = add_DD4_DD4_DD4(y, mul_D4_D4_DD4(a_vec, _mm256_loadu_pd(&x[i])));
+        _mm256_storeu_pd(&y_hi[i], DD4_HI(y));
+        _mm256_storeu_pd(&y_lo[i], DD4_LO(y));
+    }
+    if (i < n) {
+        __m256i mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x((long long)(n - i)), _mm256_set_epi64x(3, 2, 1, 0));
+        DD4 y = load_D4_D4_DD4(_mm256_maskload_pd(&y_hi[i], mask), _mm256_maskload_pd(&y_lo[i], mask));
+        y = add_DD4_DD4_DD4(y, mul_D4_D4_DD4(a_vec, _mm256_maskload_pd(&x[i], mask)));
+        _mm256_maskstore_pd(&y_hi[i], mask, DD4_HI(y));
+        _mm256_maskstore_pd(&y_lo[i], mask, DD4_LO(y));
+    }
+    return;
+}
@@ -0,0 +1,114 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// AVX-512F kernels of the double-double sum, dot product and axpy (see DD_reduce.h).  The DD_REDUCE_LANES lanes of the sum and dot
+// product are held in 4 DD8 accumulators; each accumulator performs, lane by lane, the same operations as the scalar kernel in
+// DD_reduce.c, so the results are bitwise identical.
+
+#include <stddef.h>
+
+#include <immintrin.h>
+
+#include "DD_arithmetic.h"
+#include "DD_arithmetic_avx512.h"
+#include "DD_reduce.h"
+
+#define N_ACC (DD_REDUCE_LANES / 8)
+
+// Copy the accumulators to lanes and combine them as the scalar kernel does.
+static inline DD
+reduce_acc(const DD8 acc[N_ACC]) {
+    double hi[DD_REDUCE_LANES];
+    double lo[DD_REDUCE_LANES];
+    for (int k = 0; k < N_ACC; k++) {
+        _mm512_storeu_pd(&hi[k * 8], DD8_HI(acc[k]));
+        _mm512_storeu_pd(&lo[k * 8], DD8_LO(acc[k]));
+    }
+    DD lanes[DD_REDUCE_LANES];
+    for (int j = 0; j < DD_REDUCE_LANES; j++) lanes[j] = load_D_D_DD(hi[j], lo[j]);
+    return reduce_lanes_DD(lanes);
+}
+
+DD
+sum_dd_kernel_avx512(const double* x, const size_t n) {
+    DD8 acc[N_ACC];
+    for (int k = 0; k < N_ACC; k++) acc[k] = load_D8_D8_DD8(_mm512_setzero_pd(), _mm512_setzero_pd());
+    size_t i = 0;
+    for (; i + DD_REDUCE_LANES <= n; i += DD_REDUCE_LANES) {
+        for (int k = 0; k < N_ACC; k++) acc[k] = add_DD8_D8_DD8(acc[k], _mm512_loadu_pd(&x[i + k * 8]));
+    }
+    if (i < n) {
+        // The last group is padded with zeros.
+        long long remaining = (long long)(n - i);
+        for (int k = 0; k < N_ACC; k++) {
+            long long left = remaining - (long long)(k * 8);
+            __mmask8 mask = (left >= 8) ? 0xff : (left <= 0) ? 0 : (__mmask8)((1u << left) - 1);
+            acc[k] = add_DD8_D8_DD8(acc[k], _mm512_maskz_loadu_pd(mask, &x[i + k * 8]));
+        }
+    }
+    return reduce_acc(acc);
+}
+
+DD
+dot_dd_kernel_avx512(const double* x, const double* y, const size_t n) {
+    DD8 acc[N_ACC];
+    for (int k = 0; k < N_ACC; k++) acc[k] = load_D8_D8_DD8(_mm512_setzero_pd(), _mm512_setzero_pd());
+    size_t i = 0;
+    for (; i + DD_REDUCE_LANES <= n; i += DD_REDUCE_LANES) {
+        for (int k = 0; k < N_ACC; k++) {
+            DD8 p = mul_D8_D8_DD8(_mm512_loadu_pd(&x[i + k * 8]), _mm512_loadu_pd(&y[i + k * 8]));
+            acc[k] = add_DD8_DD8_DD8(acc[k], p);
+        }
+    }
+    if (i < n) {
+        // The last group is padded with zeros.
+        long long remaining = (long long)(n - i);
+        for (int k = 0; k < N_ACC; k++) {
+            long long left = remaining - (long long)(k * 8);
+            __mmask8 mask = (left >= 8) ? 0xff : (left <= 0) ? 0 : (__mmask8)((1u << left) - 1);
+            DD8 p = mul_D8_D8_DD8(_mm512_maskz_loadu_pd(mask, &x[i + k * 8]), _mm512_maskz_loadu_pd(mask, &y[i + k * 8]));
+            acc[k] = add_DD8_DD8_DD8(acc[k], p);
+        }
+    }
+    return reduce_acc(acc);
+}
+
+// The last n%8 elements are handled with masked loads and stores.  See axpy_dd_kernel_avx2() in DD_reduce_avx2.c for why this
+// takes longer relative to a plain axpy than the sum and dot product do.
+void
+axpy_dd_kernel_avx512(const double a, const double* x, double* y_hi, double* y_lo, const size_t n) {
+    const __m512d a_vec = _mm512_set1_pd(a);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        DD8 y = load_D8_D8_DD8(_mm512_loadu_pd(&y_hi[i]), _mm512_loadu_pd(&y_lo[i]));
+        y = add_DD8_DD8_DD8(y, mul_D8_D8_DD8(a_vec, _mm512_loadu_pd(&x[i])));
+        _mm512_storeu_pd(&y_hi[i], DD8_HI(y));
+        _mm512_storeu_pd(&y_lo[i], DD8_LO(y));
+    }
+    if (i < n) {
+        __mmask8 mask = (__mmask8)((1u << (n - i)) - 1);
+        DD8 y = load_D8_D8_DD8(_mm512_maskz_loadu_pd(mask, &y_hi[i]), _mm512_maskz_loadu_pd(mask, &y_lo[i]));
+        y = add_DD8_DD8_DD8(y, mul_D8_D8_DD8(a_vec, _mm512_maskz_loadu_pd(mask, &x[i])));
+        _mm512_mask_storeu_pd(&y_hi[i], mask, DD8_HI(y));
+        _mm512_mask_storeu_pd(&y_lo[i], mask, DD8_LO(y));
+    }
+    return;
+}
@@ -0,0 +1,217 @@
+// -*-  mode: C++;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// References:
+//   [1] M. M. Joldes, J.-M. Muller, and V. Popescu, "Tight and rigourous error bounds for basic building blocks of double-word arithmetic," ACM Transactions on Mathematical Software, vol. 44, no. 2, pp. 1-27, 2017.
+//   [3] V. Popescu, "Towards fast and certified multiple-precision librairies," Theses, Université de Lyon, 2017
+//   [4] C.-P. Jeannerod, J.-M. Muller, and P. Zimmermann, “On Various Ways to Split a Floating-Point Number,” in 2018 IEEE 25th Symposium on Computer Arithmetic (ARITH), Amherst, MA, Jun. 2018, pp. 53–60, doi: 10.1109/ARITH.2018.8464793.
+//   (The reference numbers are those of DD_arithmetic.h.)
+
+// Do not allow unsafe optimizations when compiling any source which uses this code.
+
+// C++ (C++17) counterpart of DD_arithmetic.h and FF_arithmetic.h:  DoubleWord<double> is a double-double and DoubleWord<float> a
+// float-float.  Every operation performs exactly the same sequence of operations as the C function named in its comment, so with
+// the same compiler options the results are bitwise identical and the generated code is the same (see bench_DoubleWord.cpp).
+// All the operations are constexpr; the FMAs use __builtin_fma and __builtin_fmaf, which GCC (and recent Clang) also evaluate at
+// compile time.
+
+#if !defined(_DOUBLEWORD_HPP)
+#define _DOUBLEWORD_HPP 1
+
+#include <limits>
+#include <type_traits>
+
+template <typename T>
+class DoubleWord {
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "DoubleWord<T> requires T = float or T = double");
+
+public:
+    T high;
+    T low;
+
+    constexpr DoubleWord() : high(0), low(0) {}
+    constexpr explicit DoubleWord(const T hi, const T lo = 0) : high(hi), low(lo) {}
+
+    // x * y + z with a single rounding.
+    static constexpr T
+    fma(const T x, const T y, const T z) {
+        if constexpr (std::is_same_v<T, float>) {
+            return __builtin_fmaf(x, y, z);
+        } else {
+            return __builtin_fma(x, y, z);
+        }
+    }
+
+    // T + T -> DoubleWord (add_D_D_DD).
+    // See Ref[1], algorithm 2.
+    static constexpr DoubleWord
+    two_sum(const T x, const T y) {
+        T hi = x + y;
+        T lo = (x - (hi - y)) + (y - (hi - (hi - y)));
+        return DoubleWord(hi, lo);
+    }
+
+    // T + T -> DoubleWord (fast_add_D_D_DD).
+    // See Ref[1], algorithm 1.
+    // Assumes |x| >= |y|.
+    static constexpr DoubleWord
+    fast_two_sum(const T x, const T y) {
+        T hi = x + y;
+        T lo = y - (hi - x);
+        return DoubleWord(hi, lo);
+    }
+
+    // T * T -> DoubleWord (mul_D_D_DD).
+    // See Ref [1], algorithm 3
+    static constexpr DoubleWord
+    two_prod(const T x, const T y) {
+        T hi = x * y;
+        T lo = fma(x, y, -hi);
+        return DoubleWord(hi, lo);
+    }
+
+    // T * T -> DoubleWord (sqr_D_DD).
+    static constexpr DoubleWord
+    two_sqr(const T x) {
+        T hi = x * x;
+        T lo = fma(x, x, -hi);
+        return DoubleWord(hi, lo);
+    }
+
+    // Split x into two halves using Veltkamp's splitting with FMA (split_D_D_D).
+    // See Ref [4], algorithm 4.
+    static constexpr DoubleWord
+    split(const T x) {
+        constexpr int s = (std::numeric_limits<T>::digits + 1) / 2;
+        const T C1 = -static_cast<T>(1ULL << s);    // -2^ceil(digits / 2)
+        const T C2 = static_cast<T>(1ULL << s) + 1; //  2^ceil(digits / 2) + 1
+        T t = C2 * x;
+        T hi = fma(C1, x, t);
+        T lo = fma(C2, x, -t); // Same as x - hi;
+        return DoubleWord(hi, lo);
+    }
+
+    // -DoubleWord -> DoubleWord (negate_DD_DD).
+    constexpr DoubleWord
+    operator-() const {
+        return DoubleWord(-high, -low);
+    }
+
+    // DoubleWord + T -> DoubleWord (add_DD_D_DD).
+    // See Ref[1], algorithm 4.
+    friend constexpr DoubleWord
+    operator+(const DoubleWord x, const T y) {
+        DoubleWord s = two_sum(x.high, y);
+        return fast_two_sum(s.high, x.low + s.low);
+    }
+
+    friend constexpr DoubleWord
+    operator+(const T x, const DoubleWord y) {
+        return y + x;
+    }
+
+    // DoubleWord + DoubleWord -> DoubleWord (add_DD_DD_DD).
+    // See Ref[1], algorithm 6.
+    friend constexpr DoubleWord
+    operator+(const DoubleWord x, const DoubleWord y) {
+        DoubleWord s = two_sum(x.high, y.high);
+        DoubleWord t = two_sum(x.low, y.low);
+        T c = s.low + t.high;
+        DoubleWord v = fast_two_sum(s.high, c);
+        T w = t.low + v.low;
+        return fast_two_sum(v.high, w);
+    }
+
+    friend constexpr DoubleWord
+    operator-(const DoubleWord x, const T y) {
+        return x + (-y);
+    }
+
+    friend constexpr DoubleWord
+    operator-(const DoubleWord x, const DoubleWord y) {
+        return x + (-y);
+    }
+
+    // DoubleWord * T -> DoubleWord (mul_DD_D_DD).
+    // See Ref [1], algorithm 9 or Ref [3], algorithm 12.
+    friend constexpr DoubleWord
+    operator*(const DoubleWord x, const T y) {
+        DoubleWord c = two_prod(x.high, y);
+        return fast_two_sum(c.high, fma(x.low, y, c.low));
+    }
+
+    friend constexpr DoubleWord
+    operator*(const T x, const DoubleWord y) {
+        return y * x;
+    }
+
+    // DoubleWord * DoubleWord -> DoubleWord (mul_DD_DD_DD).
+    // See Ref. [1], algorithm 12 or Ref. [3], algorithm 15.
+    friend constexpr DoubleWord
+    operator*(const DoubleWord x, const DoubleWord y) {
+        DoubleWord c = two_prod(x.high, y.high);
+        T tl0 = x.low * y.low;
+        T tl1 = fma(x.high, y.low, tl0);
+        T cl2 = fma(x.low, y.high, tl1);
+        T cl3 = c.low + cl2;
+        return fast_two_sum(c.high, cl3);
+    }
+
+    // DoubleWord / T -> DoubleWord (div_DD_D_DD).
+    // See Ref [1], algorithm 15 with the corrections of Ref. [3], algorithm 17.
+    friend constexpr DoubleWord
+    operator/(const DoubleWord x, const T y) {
+        T t_hi = x.high / y;
+        DoubleWord pi = two_prod(t_hi, y);
+        T delta_hi = x.high - pi.high;
+        T delta_lo = x.low - pi.low;
+        T delta = delta_hi + delta_lo;
+        T t_lo = delta / y;
+        return fast_two_sum(t_hi, t_lo);
+    }
+
+    // DoubleWord / DoubleWord -> DoubleWord (div_DD_DD_DD).
+    // See Ref [1], algorithm 18.  (Or algorithm 18 in Ref. [3].)
+    friend constexpr DoubleWord
+    operator/(const DoubleWord x, const DoubleWord y) {
+        T t = 1 / y.high;
+        T r_hi = fma(-y.high, t, 1);
+        T r_lo = -y.low * t;
+        DoubleWord e = fast_two_sum(r_hi, r_lo);
+        DoubleWord delta = e * t;
+        DoubleWord m = delta + t;
+        return x * m;
+    }
+
+    constexpr DoubleWord& operator+=(const T y) { return *this = *this + y; }
+    constexpr DoubleWord& operator+=(const DoubleWord y) { return *this = *this + y; }
+    constexpr DoubleWord& operator-=(const T y) { return *this = *this - y; }
+    constexpr DoubleWord& operator-=(const DoubleWord y) { return *this = *this - y; }
+    constexpr DoubleWord& operator*=(const T y) { return *this = *this * y; }
+    constexpr DoubleWord& operator*=(const DoubleWord y) { return *this = *this * y; }
+    constexpr DoubleWord& operator/=(const T y) { return *this = *this / y; }
+    constexpr DoubleWord& operator/=(const DoubleWord y) { return *this = *this / y; }
+};
+
+using DoubleDouble = DoubleWord<double>;
+using FloatFloat = DoubleWord<float>;
+
+#endif // _DOUBLEWORD_HPP
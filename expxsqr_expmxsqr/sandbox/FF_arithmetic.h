@@ -0,0 +1,94 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// References:
+//   [1] M. M. Joldes, J.-M. Muller, and V. Popescu, "Tight and rigourous error bounds for basic building blocks of double-word arithmetic," ACM Transactions on Mathematical Software, vol. 44, no. 2, pp. 1-27, 2017.
+
+// Do not allow unsafe optimizations when compiling any source which uses this code.
+
+// Float-float ("FF") counterparts of the DD_arithmetic.h operations needed by the single-precision functions.  Only the operations
+// that are used are provided; each is the DD_arithmetic.h algorithm with float in place of double.
+
+#if !defined(_FF_ARITHMETIC_H)
+#define _FF_ARITHMETIC_H 1
+
+#include <float.h>
+#include <math.h>
+
+typedef struct {
+    float high;
+    float low;
+} FF;
+
+#define FF_HI(x) ((x).high)
+#define FF_LO(x) ((x).low)
+
+// F, F -> FF
+static inline FF
+load_F_F_FF(const float hi, const float lo) {
+    FF result;
+    FF_HI(result) = hi;
+    FF_LO(result) = lo;
+    return result;
+}
+
+// F + F -> FF
+// See Ref[1], algorithm 2.
+static inline FF
+add_F_F_FF (const float x, const float y) {
+    FF result;
+    FF_HI(result) = x + y;
+    FF_LO(result) = (x - (FF_HI(result) - y)) + (y - (FF_HI(result) - (FF_HI(result) - y)));
+    return result;
+}
+
+// F + F -> FF
+// See Ref[1], algorithm 1.
+// Assumes |x| >= |y|.
+static inline FF
+fast_add_F_F_FF (const float x, const float y) {
+    FF result;
+    FF_HI(result) = x + y;
+    FF_LO(result) = y - (FF_HI(result) - x);
+    return result;
+}
+
+// F * F -> FF
+// See Ref [1], algorithm 3
+static inline FF
+mul_F_F_FF (const float x, const float y) {
+    FF result;
+    FF_HI(result) = x * y;
+    FF_LO(result) = fmaf(x, y, -FF_HI(result));
+    return result;
+}
+
+// F * F -> FF
+// Same as mul_F_F_FF except specialized for x = y.
+static inline FF
+sqr_F_FF (const float x) {
+    FF result;
+    FF_HI(result) = x * x;
+    FF_LO(result) = fmaf(x, x, -FF_HI(result));
+    return result;
+}
+
+#endif // _FF_ARITHMETIC_H
@@ -0,0 +1,100 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// References:
+//   [1] M. M. Joldes, J.-M. Muller, and V. Popescu, "Tight and rigourous error bounds for basic building blocks of double-word arithmetic," ACM Transactions on Mathematical Software, vol. 44, no. 2, pp. 1-27, 2017.
+
+// Do not allow unsafe optimizations when compiling any source which uses this code.
+
+// Eight-lane versions of the operations in FF_arithmetic.h.  An FF8 holds Eight float-float values with the high parts in one __m256
+// and the low parts in another.  Each function performs, lane by lane, exactly the same sequence of operations as the scalar
+// function of the same name so the results are bitwise identical.
+
+#if !defined(_FF_ARITHMETIC_AVX2_H)
+#define _FF_ARITHMETIC_AVX2_H 1
+
+#include <immintrin.h>
+
+#if !defined(__AVX2__) || !defined(__FMA__)
+#error "FF_arithmetic_avx2.h requires AVX2 and FMA"
+#endif
+
+typedef struct {
+    __m256 high;
+    __m256 low;
+} FF8;
+
+#define FF8_HI(x) ((x).high)
+#define FF8_LO(x) ((x).low)
+
+// F8, F8 -> FF8
+static inline FF8
+load_F8_F8_FF8(const __m256 hi, const __m256 lo) {
+    FF8 result;
+    FF8_HI(result) = hi;
+    FF8_LO(result) = lo;
+    return result;
+}
+
+// F8 + F8 -> FF8
+// See Ref[1], algorithm 2.
+static inline FF8
+add_F8_F8_FF8(const __m256 x, const __m256 y) {
+    FF8 result;
+    FF8_HI(result) = _mm256_add_ps(x, y);
+    __m256 x_virt = _mm256_sub_ps(FF8_HI(result), y);
+    __m256 y_virt = _mm256_sub_ps(FF8_HI(result), x_virt);
+    FF8_LO(result) = _mm256_add_ps(_mm256_sub_ps(x, x_virt), _mm256_sub_ps(y, y_virt));
+    return result;
+}
+
+// F8 + F8 -> FF8
+// See Ref[1], algorithm 1.
+// Assumes |x| >= |y| in every lane.
+static inline FF8
+fast_add_F8_F8_FF8(const __m256 x, const __m256 y) {
+    FF8 result;
+    FF8_HI(result) = _mm256_add_ps(x, y);
+    FF8_LO(result) = _mm256_sub_ps(y, _mm256_sub_ps(FF8_HI(result), x));
+    return result;
+}
+
+// F8 * F8 -> FF8
+// See Ref [1], algorithm 3
+static inline FF8
+mul_F8_F8_FF8(const __m256 x, const __m256 y) {
+    FF8 result;
+    FF8_HI(result) = _mm256_mul_ps(x, y);
+    FF8_LO(result) = _mm256_fmsub_ps(x, y, FF8_HI(result));
+    return result;
+}
+
+// F8 * F8 -> FF8
+// Same as mul_F8_F8_FF8 except specialized for x = y.
+static inline FF8
+sqr_F8_FF8(const __m256 x) {
+    FF8 result;
+    FF8_HI(result) = _mm256_mul_ps(x, x);
+    FF8_LO(result) = _mm256_fmsub_ps(x, x, FF8_HI(result));
+    return result;
+}
+
+#endif // _FF_ARITHMETIC_AVX2_H
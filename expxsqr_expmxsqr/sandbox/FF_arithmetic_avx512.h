@@ -0,0 +1,100 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// References:
+//   [1] M. M. Joldes, J.-M. Muller, and V. Popescu, "Tight and rigourous error bounds for basic building blocks of double-word arithmetic," ACM Transactions on Mathematical Software, vol. 44, no. 2, pp. 1-27, 2017.
+
+// Do not allow unsafe optimizations when compiling any source which uses this code.
+
+// Sixteen-lane versions of the operations in FF_arithmetic.h.  An FF16 holds Sixteen float-float values with the high parts in one __m512
+// and the low parts in another.  Each function performs, lane by lane, exactly the same sequence of operations as the scalar
+// function of the same name so the results are bitwise identical.
+
+#if !defined(_FF_ARITHMETIC_AVX512_H)
+#define _FF_ARITHMETIC_AVX512_H 1
+
+#include <immintrin.h>
+
+#if !defined(__AVX512F__)
+#error "FF_arithmetic_avx512.h requires AVX-512F"
+#endif
+
+typedef struct {
+    __m512 high;
+    __m512 low;
+} FF16;
+
+#define FF16_HI(x) ((x).high)
+#define FF16_LO(x) ((x).low)
+
+// F16, F16 -> FF16
+static inline FF16
+load_F16_F16_FF16(const __m512 hi, const __m512 lo) {
+    FF16 result;
+    FF16_HI(result) = hi;
+    FF16_LO(result) = lo;
+    return result;
+}
+
+// F16 + F16 -> FF16
+// See Ref[1], algorithm 2.
+static inline FF16
+add_F16_F16_FF16(const __m512 x, const __m512 y) {
+    FF16 result;
+    FF16_HI(result) = _mm512_add_ps(x, y);
+    __m512 x_virt = _mm512_sub_ps(FF16_HI(result), y);
+    __m512 y_virt = _mm512_sub_ps(FF16_HI(result), x_virt);
+    FF16_LO(result) = _mm512_add_ps(_mm512_sub_ps(x, x_virt), _mm512_sub_ps(y, y_virt));
+    return result;
+}
+
+// F16 + F16 -> FF16
+// See Ref[1], algorithm 1.
+// Assumes |x| >= |y| in every lane.
+static inline FF16
+fast_add_F16_F16_FF16(const __m512 x, const __m512 y) {
+    FF16 result;
+    FF16_HI(result) = _mm512_add_ps(x, y);
+    FF16_LO(result) = _mm512_sub_ps(y, _mm512_sub_ps(FF16_HI(result), x));
+    return result;
+}
+
+// F16 * F16 -> FF16
+// See Ref [1], algorithm 3
+static inline FF16
+mul_F16_F16_FF16(const __m512 x, const __m512 y) {
+    FF16 result;
+    FF16_HI(result) = _mm512_mul_ps(x, y);
+    FF16_LO(result) = _mm512_fmsub_ps(x, y, FF16_HI(result));
+    return result;
+}
+
+// F16 * F16 -> FF16
+// Same as mul_F16_F16_FF16 except specialized for x = y.
+static inline FF16
+sqr_F16_FF16(const __m512 x) {
+    FF16 result;
+    FF16_HI(result) = _mm512_mul_ps(x, x);
+    FF16_LO(result) = _mm512_fmsub_ps(x, x, FF16_HI(result));
+    return result;
+}
+
+#endif // _FF_ARITHMETIC_AVX512_H
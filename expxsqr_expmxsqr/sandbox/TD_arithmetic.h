@@ -0,0 +1,149 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Triple-double arithmetic:  a TD is the unevaluated sum hi + mid + lo of three non-overlapping doubles, giving about 159 bits of
+// precision.  It extends DD_arithmetic.h (whose error-free transformations it is built on) for the few places where double-double
+// is not enough, such as the fallback of the correctly rounded tier (see expxsqr_td.c).  Since that code runs rarely, the functions
+// favour simplicity and accuracy over speed.
+//
+// renormalize_D_D_D_TD() is exact, so the only errors are the roundings of the sums of the lowest-order terms:  add_TD_D_TD() and
+// add_TD_TD_TD() are accurate to a few units in 2^-156 of the largest operand, and mul_TD_D_TD() and mul_TD_TD_TD() to a few units
+// in 2^-156 of the product.
+
+// References:
+//   [1] N. Fabiano, J.-M. Muller, and J. Picot, "Algorithms for Triple-Word Arithmetic," IEEE Transactions on Computers, vol. 68, no. 11, pp. 1573-1583, 2019.
+//   [2] S. Boldo and G. Melquiond, "Emulation of FMA and Correctly Rounded Sums: Proved Algorithms Using Rounding to Odd," IEEE Transactions on Computers, vol. 57, no. 4, pp. 462-471, 2008.
+
+// Do not allow unsafe optimizations when compiling any source which uses this code.
+
+#if !defined(_TD_ARITHMETIC_H)
+#define _TD_ARITHMETIC_H 1
+
+#include <math.h>
+#include <stdint.h>
+
+#include "DD_arithmetic.h"
+
+typedef struct {
+    double high;
+    double mid;
+    double low;
+} TD;
+
+#define TD_HI(x) ((x).high)
+#define TD_MI(x) ((x).mid)
+#define TD_LO(x) ((x).low)
+
+// All the following functions are declared "static inline". It is assumed that the compiler will inline them wherever they are called.
+
+// D, D, D -> TD
+static inline TD
+load_D_D_D_TD(const double hi, const double mid, const double lo) {
+    TD result;
+    TD_HI(result) = hi;
+    TD_MI(result) = mid;
+    TD_LO(result) = lo;
+    return result;
+}
+
+// -TD -> TD
+static inline TD
+negate_TD_TD(const TD x) {
+    return load_D_D_D_TD(-TD_HI(x), -TD_MI(x), -TD_LO(x));
+}
+
+// D + D + D -> TD
+// Exact:  hi + mid + lo = a + b + c.  The result is non-overlapping, with hi = RN(hi + mid), provided that |a| >= |b| >= |c| to
+// within a few bits.  A chain of error-free additions in the manner of VecSum (see Ref [1], section 2).
+static inline TD
+renormalize_D_D_D_TD(const double a, const double b, const double c) {
+    DD s = add_D_D_DD(b, c);
+    DD t = add_D_D_DD(a, DD_HI(s));
+    DD u = add_D_D_DD(DD_LO(t), DD_LO(s));
+    DD v = add_D_D_DD(DD_HI(t), DD_HI(u));
+    DD w = add_D_D_DD(DD_LO(v), DD_LO(u));
+    return load_D_D_D_TD(DD_HI(v), DD_HI(w), DD_LO(w));
+}
+
+// TD + D -> TD
+static inline TD
+add_TD_D_TD(const TD x, const double y) {
+    DD s = add_D_D_DD(TD_HI(x), y);
+    DD t = add_D_D_DD(TD_MI(x), DD_LO(s));
+    return renormalize_D_D_D_TD(DD_HI(s), DD_HI(t), DD_LO(t) + TD_LO(x));
+}
+
+// TD + TD -> TD
+static inline TD
+add_TD_TD_TD(const TD x, const TD y) {
+    DD s = add_D_D_DD(TD_HI(x), TD_HI(y));
+    DD t = add_D_D_DD(TD_MI(x), TD_MI(y));
+    DD u = add_D_D_DD(DD_LO(s), DD_HI(t));
+    double v = (TD_LO(x) + TD_LO(y)) + (DD_LO(t) + DD_LO(u));
+    return renormalize_D_D_D_TD(DD_HI(s), DD_HI(u), v);
+}
+
+// TD * D -> TD
+// Requires FMA instruction
+static inline TD
+mul_TD_D_TD(const TD x, const double y) {
+    DD p0 = mul_D_D_DD(TD_HI(x), y);
+    DD p1 = mul_D_D_DD(TD_MI(x), y);
+    DD t = add_D_D_DD(DD_LO(p0), DD_HI(p1));
+    double v = fma(TD_LO(x), y, DD_LO(p1) + DD_LO(t));
+    return renormalize_D_D_D_TD(DD_HI(p0), DD_HI(t), v);
+}
+
+// TD * TD -> TD
+// The partial products of order 2^-106 and above are formed exactly; those of order 2^-212 and below are dropped.
+// Requires FMA instruction
+static inline TD
+mul_TD_TD_TD(const TD x, const TD y) {
+    DD p00 = mul_D_D_DD(TD_HI(x), TD_HI(y));
+    DD p01 = mul_D_D_DD(TD_HI(x), TD_MI(y));
+    DD p10 = mul_D_D_DD(TD_MI(x), TD_HI(y));
+    DD s = add_D_D_DD(DD_HI(p01), DD_HI(p10));
+    DD t = add_D_D_DD(DD_LO(p00), DD_HI(s));
+    double v = fma(TD_HI(x), TD_LO(y), fma(TD_MI(x), TD_MI(y), TD_LO(x) * TD_HI(y)));
+    v += (DD_LO(p01) + DD_LO(p10)) + (DD_LO(s) + DD_LO(t));
+    return renormalize_D_D_D_TD(DD_HI(p00), DD_HI(t), v);
+}
+
+// TD -> D, correctly rounded to nearest.
+// Assumes x is normalized (as returned by the functions above).  hi + mid is split exactly into s + e with s = RN(hi + mid), and
+// e + lo is rounded to odd.  Since its ulp is far below that of s, rounding to odd keeps e + lo on the same side of every
+// rounding boundary of s as the exact value, so that RN(s + RO(e + lo)) = RN(hi + mid + lo).  See Ref [2], section 5.
+static inline double
+round_TD_D(const TD x) {
+    DD s = add_D_D_DD(TD_HI(x), TD_MI(x));
+    DD t = add_D_D_DD(DD_LO(s), TD_LO(x));
+    union {
+        double d;
+        uint64_t ui64;
+    } odd = {DD_HI(t)};
+    // If DD_HI(t) is inexact and even, replace it with its neighbour in the direction of DD_LO(t).
+    if (DD_LO(t) != 0.0 && (odd.ui64 & 1) == 0) {
+        odd.ui64 = ((DD_LO(t) < 0.0) == (DD_HI(t) < 0.0)) ? odd.ui64 + 1 : odd.ui64 - 1;
+    }
+    return DD_HI(s) + odd.d;
+}
+
+#endif // _TD_ARITHMETIC_H
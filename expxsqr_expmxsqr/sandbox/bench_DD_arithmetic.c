@@ -0,0 +1,282 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Throughput of each double-double operation in its scalar (DD_arithmetic.h), four-lane (DD_arithmetic_avx2.h) and eight-lane
+// (DD_arithmetic_avx512.h) form, and a check that the vector results are bitwise identical to the scalar ones.  The operands are
+// random normalized double-doubles held in L1-sized arrays; each timing runs the operation over the arrays enough times to do about
+// 2^16 operations and the time per operation is the best of the repeats.  The AVX-512 versions are skipped if the processor does
+// not support AVX-512F.  The program returns 1 if any vector result differs from the scalar one.
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "DD_arithmetic.h"
+#include "bench_DD_arithmetic.h"
+
+#define OPS_PER_TIMING 65536
+
+const char* const DD_op_names[DD_OP_COUNT] = {
+    "negate_DD",  "split_D",  "add_D_D",  "fast_add_D_D", "add_DD_D",  "add_DD_DD",
+    "mul_D_D",    "sqr_D",    "mul_DD_D", "mul_DD_DD",    "div_DD_D",  "div_DD_DD",
+    "rcp_DD",     "rsqrt_DD", "sqrt_DD",
+};
+
+static void
+negate_DD_DD_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi, double* z_lo,
+                   const size_t n) {
+    (void)y_hi; (void)y_lo;
+    for (size_t i = 0; i < n; i++) unpack_DD_D_D(negate_DD_DD(load_D_D_DD(x_hi[i], x_lo[i])), &z_hi[i], &z_lo[i]);
+}
+
+static void
+split_D_D_D_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi, double* z_lo,
+                  const size_t n) {
+    (void)x_lo; (void)y_hi; (void)y_lo;
+    for (size_t i = 0; i < n; i++) split_D_D_D(x_hi[i], &z_hi[i], &z_lo[i]);
+}
+
+static void
+add_D_D_DD_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi, double* z_lo,
+                 const size_t n) {
+    (void)x_lo; (void)y_lo;
+    for (size_t i = 0; i < n; i++) unpack_DD_D_D(add_D_D_DD(x_hi[i], y_hi[i]), &z_hi[i], &z_lo[i]);
+}
+
+static void
+fast_add_D_D_DD_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi, double* z_lo,
+                      const size_t n) {
+    (void)x_lo; (void)y_lo;
+    for (size_t i = 0; i < n; i++) unpack_DD_D_D(fast_add_D_D_DD(x_hi[i], y_hi[i]), &z_hi[i], &z_lo[i]);
+}
+
+static void
+add_DD_D_DD_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi, double* z_lo,
+                  const size_t n) {
+    (void)y_lo;
+    for (size_t i = 0; i < n; i++) unpack_DD_D_D(add_DD_D_DD(load_D_D_DD(x_hi[i], x_lo[i]), y_hi[i]), &z_hi[i], &z_lo[i]);
+}
+
+static void
+add_DD_DD_DD_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi, double* z_lo,
+                   const size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        unpack_DD_D_D(add_DD_DD_DD(load_D_D_DD(x_hi[i], x_lo[i]), load_D_D_DD(y_hi[i], y_lo[i])), &z_hi[i], &z_lo[i]);
+    }
+}
+
+static void
+mul_D_D_DD_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi, double* z_lo,
+                 const size_t n) {
+    (void)x_lo; (void)y_lo;
+    for (size_t i = 0; i < n; i++) unpack_DD_D_D(mul_D_D_DD(x_hi[i], y_hi[i]), &z_hi[i], &z_lo[i]);
+}
+
+static void
+sqr_D_DD_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi, double* z_lo,
+               const size_t n) {
+    (void)x_lo; (void)y_hi; (void)y_lo;
+    for (size_t i = 0; i < n; i++) unpack_DD_D_D(sqr_D_DD(x_hi[i]), &z_hi[i], &z_lo[i]);
+}
+
+static void
+mul_DD_D_DD_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi, double* z_lo,
+                  const size_t n) {
+    (void)y_lo;
+    for (size_t i = 0; i < n; i++) unpack_DD_D_D(mul_DD_D_DD(load_D_D_DD(x_hi[i], x_lo[i]), y_hi[i]), &z_hi[i], &z_lo[i]);
+}
+
+static void
+mul_DD_DD_DD_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi, double* z_lo,
+                   const size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        unpack_DD_D_D(mul_DD_DD_DD(load_D_D_DD(x_hi[i], x_lo[i]), load_D_D_DD(y_hi[i], y_lo[i])), &z_hi[i], &z_lo[i]);
+    }
+}
+
+static void
+div_DD_D_DD_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi, double* z_lo,
+                  const size_t n) {
+    (void)y_lo;
+    for (size_t i = 0; i < n; i++) unpack_DD_D_D(div_DD_D_DD(load_D_D_DD(x_hi[i], x_lo[i]), y_hi[i]), &z_hi[i], &z_lo[i]);
+}
+
+static void
+div_DD_DD_DD_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi, double* z_lo,
+                   const size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        unpack_DD_D_D(div_DD_DD_DD(load_D_D_DD(x_hi[i], x_lo[i]), load_D_D_DD(y_hi[i], y_lo[i])), &z_hi[i], &z_lo[i]);
+    }
+}
+
+static void
+rcp_DD_DD_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi, double* z_lo,
+                const size_t n) {
+    (void)x_hi; (void)x_lo;
+    for (size_t i = 0; i < n; i++) unpack_DD_D_D(rcp_DD_DD(load_D_D_DD(y_hi[i], y_lo[i])), &z_hi[i], &z_lo[i]);
+}
+
+static void
+rsqrt_DD_DD_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi, double* z_lo,
+                  const size_t n) {
+    (void)x_hi; (void)x_lo;
+    for (size_t i = 0; i < n; i++) unpack_DD_D_D(rsqrt_DD_DD(load_D_D_DD(y_hi[i], y_lo[i])), &z_hi[i], &z_lo[i]);
+}
+
+static void
+sqrt_DD_DD_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi, double* z_lo,
+                 const size_t n) {
+    (void)x_hi; (void)x_lo;
+    for (size_t i = 0; i < n; i++) unpack_DD_D_D(sqrt_DD_DD(load_D_D_DD(y_hi[i], y_lo[i])), &z_hi[i], &z_lo[i]);
+}
+
+const DD_op_func DD_ops_scalar[DD_OP_COUNT] = {
+    negate_DD_DD_array, split_D_D_D_array,  add_D_D_DD_array,  fast_add_D_D_DD_array, add_DD_D_DD_array,  add_DD_DD_DD_array,
+    mul_D_D_DD_array,   sqr_D_DD_array,     mul_DD_D_DD_array, mul_DD_DD_DD_array,    div_DD_D_DD_array,  div_DD_DD_DD_array,
+    rcp_DD_DD_array,    rsqrt_DD_DD_array,  sqrt_DD_DD_array,
+};
+
+// xorshift64* (Vigna); a fixed seed makes the operands reproducible.
+static uint64_t rng_state = 0x9e3779b97f4a7c15ULL;
+
+static inline uint64_t
+next_random(void) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545f4914f6cdd1dULL;
+}
+
+// A random normalized double-double with |hi| in [2^-8, 2^8), and a random sign unless it must be positive.
+static void
+random_DD(double* hi, double* lo, const int positive) {
+    double sign = (!positive && (next_random() & 1)) ? -1.0 : 1.0;
+    double h = sign * ldexp(1.0 + (double)(next_random() >> 11) * 0x1.0p-53, (int)(next_random() % 16) - 8);
+    double l = h * ((double)(next_random() >> 11) * 0x1.0p-53 - 0.5) * 0x1.0p-52;
+    DD x = fast_add_D_D_DD(h, l);
+    unpack_DD_D_D(x, hi, lo);
+}
+
+static double
+elapsed_ns(const struct timespec* start, const struct timespec* stop) {
+    return 1.0e9 * (double)(stop->tv_sec - start->tv_sec) + (double)(stop->tv_nsec - start->tv_nsec);
+}
+
+static double
+time_op(DD_op_func op, const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi, double* z_lo,
+        const size_t n, const int passes) {
+    struct timespec start, stop;
+    timespec_get(&start, TIME_UTC);
+    for (int p = 0; p < passes; p++) op(x_hi, x_lo, y_hi, y_lo, z_hi, z_lo, n);
+    timespec_get(&stop, TIME_UTC);
+    return elapsed_ns(&start, &stop);
+}
+
+static size_t
+count_mismatches(const char* name, const char* isa, const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo,
+                 const double* ref_hi, const double* ref_lo, const double* z_hi, const double* z_lo, const size_t n) {
+    size_t mismatches = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (memcmp(&ref_hi[i], &z_hi[i], sizeof(double)) != 0 || memcmp(&ref_lo[i], &z_lo[i], sizeof(double)) != 0) {
+            if (mismatches == 0) {
+                printf("%s %s(%.13a + %.13a, %.13a + %.13a):  scalar = %.13a + %.13a  vector = %.13a + %.13a\n", isa, name, x_hi[i],
+                       x_lo[i], y_hi[i], y_lo[i], ref_hi[i], ref_lo[i], z_hi[i], z_lo[i]);
+            }
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+int
+main(int argc, char* argv[]) {
+    if (argc != 3) {
+        printf("Usage:  %s arg_cnt repeats\n", argv[0]);
+        return -1;
+    }
+    long arg_cnt = atol(argv[1]);
+    int repeats = atoi(argv[2]);
+    if (arg_cnt <= 0 || arg_cnt % 8 != 0 || repeats <= 0) {
+        printf("Bad arguments:  arg_cnt = %ld (must be a multiple of 8)  repeats = %d\n", arg_cnt, repeats);
+        return -1;
+    }
+    size_t n = (size_t)arg_cnt;
+    int passes = (n < OPS_PER_TIMING) ? (int)(OPS_PER_TIMING / n) : 1;
+    int have_avx512 = __builtin_cpu_supports("avx512f");
+
+    double* buffer = malloc(8 * n * sizeof(double));
+    if (buffer == NULL) {
+        printf("Failed to allocate %zu points\n", n);
+        return -1;
+    }
+    double* x_hi = buffer;
+    double* x_lo = x_hi + n;
+    double* y_hi = x_lo + n;
+    double* y_lo = y_hi + n;
+    double* ref_hi = y_lo + n;
+    double* ref_lo = ref_hi + n;
+    double* z_hi = ref_lo + n;
+    double* z_lo = z_hi + n;
+    for (size_t i = 0; i < n; i++) {
+        random_DD(&x_hi[i], &x_lo[i], 0);
+        random_DD(&y_hi[i], &y_lo[i], 1);
+    }
+
+    printf("%zu operands, %d passes per timing%s\n", n, passes, have_avx512 ? "" : ", avx512 skipped (no AVX-512F)");
+    printf("%-12s  %12s  %12s  %12s\n", "operation", "scalar ns/op", "avx2 ns/op", "avx512 ns/op");
+    size_t mismatches = 0;
+    for (int k = 0; k < DD_OP_COUNT; k++) {
+        // The versions alternate so that all of them see the same machine load.
+        double ns_scalar = INFINITY;
+        double ns_avx2 = INFINITY;
+        double ns_avx512 = INFINITY;
+        for (int r = 0; r < repeats; r++) {
+            ns_scalar = fmin(ns_scalar, time_op(DD_ops_scalar[k], x_hi, x_lo, y_hi, y_lo, ref_hi, ref_lo, n, passes));
+            ns_avx2 = fmin(ns_avx2, time_op(DD_ops_avx2[k], x_hi, x_lo, y_hi, y_lo, z_hi, z_lo, n, passes));
+            if (have_avx512) ns_avx512 = fmin(ns_avx512, time_op(DD_ops_avx512[k], x_hi, x_lo, y_hi, y_lo, z_hi, z_lo, n, passes));
+        }
+        size_t ops = n * (size_t)passes;
+
+        size_t op_mismatches = 0;
+        DD_ops_avx2[k](x_hi, x_lo, y_hi, y_lo, z_hi, z_lo, n);
+        op_mismatches += count_mismatches(DD_op_names[k], "avx2", x_hi, x_lo, y_hi, y_lo, ref_hi, ref_lo, z_hi, z_lo, n);
+        if (have_avx512) {
+            DD_ops_avx512[k](x_hi, x_lo, y_hi, y_lo, z_hi, z_lo, n);
+            op_mismatches += count_mismatches(DD_op_names[k], "avx512", x_hi, x_lo, y_hi, y_lo, ref_hi, ref_lo, z_hi, z_lo, n);
+        }
+        mismatches += op_mismatches;
+
+        printf("%-12s  %12.3f  %12.3f  %12.3f  mismatches = %zu\n", DD_op_names[k], ns_scalar / (double)ops,
+               ns_avx2 / (double)ops, ns_avx512 / (double)ops, op_mismatches);
+    }
+
+    free(buffer);
+
+    if (mismatches != 0) {
+        printf("FAILED:  the vector results differ from the scalar ones\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,43 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Array wrappers around the operations of DD_arithmetic.h, DD_arithmetic_avx2.h and DD_arithmetic_avx512.h for bench_DD_arithmetic.
+// Every wrapper has the same signature:  operand x is (x_hi, x_lo), operand y is (y_hi, y_lo) and the result is (z_hi, z_lo); an
+// operation that takes a double instead of a double-double uses only the high array of that operand.  The one-operand reciprocal
+// and square root operations take y, which is positive.  n must be a multiple of 8.
+
+#if !defined(_BENCH_DD_ARITHMETIC_H)
+#define _BENCH_DD_ARITHMETIC_H 1
+
+#include <stddef.h>
+
+typedef void (*DD_op_func)(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi, double* z_lo,
+                           const size_t n);
+
+// The operations, in the order of the tables below.
+#define DD_OP_COUNT 15
+extern const char* const DD_op_names[DD_OP_COUNT];
+
+extern const DD_op_func DD_ops_scalar[DD_OP_COUNT];  // bench_DD_arithmetic.c
+extern const DD_op_func DD_ops_avx2[DD_OP_COUNT];    // bench_DD_arithmetic_avx2.c
+extern const DD_op_func DD_ops_avx512[DD_OP_COUNT];  // bench_DD_arithmetic_avx512.c
+
+#endif // _BENCH_DD_ARITHMETIC_H
@@ -0,0 +1,133 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// AVX2/FMA array wrappers for bench_DD_arithmetic (see bench_DD_arithmetic.h):  each one runs a DD_arithmetic_avx2.h operation over
+// four lanes at a time.
+
+#include <stddef.h>
+
+#include <immintrin.h>
+
+#include "DD_arithmetic_avx2.h"
+#include "bench_DD_arithmetic.h"
+
+#define LOAD(p) _mm256_loadu_pd(p)
+#define STORE(p, v) _mm256_storeu_pd((p), (v))
+
+#define WRAP_DD_DD(op)                                                                                                             \
+    static void op##_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi,           \
+                           double* z_lo, const size_t n) {                                                                         \
+        (void)y_hi; (void)y_lo;                                                                                                    \
+        for (size_t i = 0; i < n; i += 4) {                                                                                        \
+            DD4 z = op(load_D4_D4_DD4(LOAD(&x_hi[i]), LOAD(&x_lo[i])));                                                            \
+            STORE(&z_hi[i], DD4_HI(z));                                                                                            \
+            STORE(&z_lo[i], DD4_LO(z));                                                                                            \
+        }                                                                                                                          \
+    }
+
+#define WRAP_Y_DD_DD(op)                                                                                                           \
+    static void op##_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi,           \
+                           double* z_lo, const size_t n) {                                                                         \
+        (void)x_hi; (void)x_lo;                                                                                                    \
+        for (size_t i = 0; i < n; i += 4) {                                                                                        \
+            DD4 z = op(load_D4_D4_DD4(LOAD(&y_hi[i]), LOAD(&y_lo[i])));                                                            \
+            STORE(&z_hi[i], DD4_HI(z));                                                                                            \
+            STORE(&z_lo[i], DD4_LO(z));                                                                                            \
+        }                                                                                                                          \
+    }
+
+#define WRAP_D_D_D(op)                                                                                                             \
+    static void op##_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi,           \
+                           double* z_lo, const size_t n) {                                                                         \
+        (void)x_lo; (void)y_hi; (void)y_lo;                                                                                        \
+        for (size_t i = 0; i < n; i += 4) {                                                                                        \
+            __m256d hi, lo;                                                                                                        \
+            op(LOAD(&x_hi[i]), &hi, &lo);                                                                                          \
+            STORE(&z_hi[i], hi);                                                                                                   \
+            STORE(&z_lo[i], lo);                                                                                                   \
+        }                                                                                                                          \
+    }
+
+#define WRAP_D_DD(op)                                                                                                              \
+    static void op##_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi,           \
+                           double* z_lo, const size_t n) {                                                                         \
+        (void)x_lo; (void)y_hi; (void)y_lo;                                                                                        \
+        for (size_t i = 0; i < n; i += 4) {                                                                                        \
+            DD4 z = op(LOAD(&x_hi[i]));                                                                                            \
+            STORE(&z_hi[i], DD4_HI(z));                                                                                            \
+            STORE(&z_lo[i], DD4_LO(z));                                                                                            \
+        }                                                                                                                          \
+    }
+
+#define WRAP_D_D_DD(op)                                                                                                            \
+    static void op##_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi,           \
+                           double* z_lo, const size_t n) {                                                                         \
+        (void)x_lo; (void)y_lo;                                                                                                    \
+        for (size_t i = 0; i < n; i += 4) {                                                                                        \
+            DD4 z = op(LOAD(&x_hi[i]), LOAD(&y_hi[i]));                                                                            \
+            STORE(&z_hi[i], DD4_HI(z));                                                                                            \
+            STORE(&z_lo[i], DD4_LO(z));                                                                                            \
+        }                                                                                                                          \
+    }
+
+#define WRAP_DD_D_DD(op)                                                                                                           \
+    static void op##_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi,           \
+                           double* z_lo, const size_t n) {                                                                         \
+        (void)y_lo;                                                                                                                \
+        for (size_t i = 0; i < n; i += 4) {                                                                                        \
+            DD4 z = op(load_D4_D4_DD4(LOAD(&x_hi[i]), LOAD(&x_lo[i])), LOAD(&y_hi[i]));                                            \
+            STORE(&z_hi[i], DD4_HI(z));                                                                                            \
+            STORE(&z_lo[i], DD4_LO(z));                                                                                            \
+        }                                                                                                                          \
+    }
+
+#define WRAP_DD_DD_DD(op)                                                                                                          \
+    static void op##_array(const double* x_hi, const double* x_lo, const double* y_hi, const double* y_lo, double* z_hi,           \
+                           double* z_lo, const size_t n) {                                                                         \
+        for (size_t i = 0; i < n; i += 4) {                                                                                        \
+            DD4 z = op(load_D4_D4_DD4(LOAD(&x_hi[i]), LOAD(&x_lo[i])), load_D4_D4_DD4(LOAD(&y_hi[i]), LOAD(&y_lo[i])));            \
+            STORE(&z_hi[i], DD4_HI(z));                                                                                            \
+            STORE(&z_lo[i], DD4_LO(z));                                                                                            \
+        }                                                                                                                          \
+    }
+
+WRAP_DD_DD(negate_DD4_DD4)
+WRAP_D_D_D(split_D4_D4_D4)
+WRAP_D_D_DD(add_D4_D4_DD4)
+WRAP_D_D_DD(fast_add_D4_D4_DD4)
+WRAP_DD_D_DD(add_DD4_D4_DD4)
+WRAP_DD_DD_DD(add_DD4_DD4_DD4)
+WRAP_D_D_DD(mul_D4_D4_DD4)
+WRAP_D_DD(sqr_D4_DD4)
+WRAP_DD_D_DD(mul_DD4_D4_DD4)
+WRAP_DD_DD_DD(mul_DD4_DD4_DD4)
+WRAP_DD_D_DD(div_DD4_D4_DD4)
+WRAP_DD_DD_DD(div_DD4_DD4_DD4)
+WRAP_Y_DD_DD(rcp_DD4_DD4)
+WRAP_Y_DD_DD(rsqrt_DD4_DD4)
+WRAP_Y_DD_DD(sqrt_DD4_DD4)
+
+const DD_op_func DD_ops_avx2[DD_OP_COUNT] = {
+    negate_DD4_DD4_array, split_D4_D4_D4_array, add_D4_D4_DD4_array, fast_add_D4_D4_DD4_array,
+    add_DD4_D4_DD4_array, add_DD4_DD4_DD4_array, mul_D4_D4_DD4_array, sqr_D4_DD4_array,
+    mul_DD4_D4_DD4_array, mul_DD4_DD4_DD4_array, div_DD4_D4_DD4_array, div_DD4_DD4_DD4_array,
+    rcp_DD4_DD4_array, rsqrt_DD4_DD4_array, sqrt_DD4_DD4_array,
+};
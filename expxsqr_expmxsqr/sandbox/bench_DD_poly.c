@@ -0,0 +1,330 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+
+// Benchmark and check of the polynomial evaluators of DD_arithmetic.h:  plain Horner, compensated Horner with a double or a
+// double-double argument, and Estrin's scheme with double-double accumulation.  Two polynomials with BENCH_POLY_COEFFS coefficients
+// are used:  e^r - 1 = r + r^2 * P(r) with P from expxsqr_coeffs on the reduced range of expxsqr, which is well conditioned, and
+// (x - 3/4)^6 expanded, evaluated at 2^-8 <= |x - 3/4| <= 2^-3 where the condition number p~(|x|) / |p(x)| is 2^21 to 2^52.
+//
+// Cost:  the time per evaluation (best of the repeats) of the scalar, AVX2 and AVX-512 versions over an array, and the latency of
+// the scalar versions measured on a chain of calls where each argument depends on the previous result, all relative to Horner.
+//
+// Accuracy:  the largest error of each evaluator against the exact value computed with MPFR, in ulps of the exact value rounded to
+// double.  The error of a double-double result must not exceed the bound of the compensated Horner scheme, gamma(2d)^2 * p~(|x|)
+// with d the degree (gamma(2d + 2)^2 with a double-double argument); the error of the result rounded to double is shown as well.
+//
+// Bitwise identity:  the AVX2 and AVX-512 results must be identical to the scalar ones.  AVX-512 is skipped if the processor does
+// not support AVX-512F.
+//
+// The program returns 1 if any check fails.
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "mpfr.h"
+
+#include "DD_arithmetic.h"
+#include "bench_DD_poly.h"
+#include "expxsqr_tables.h"
+#include "utils.h"
+
+#define REF_MPFR_PREC 1024 // The reference polynomial values are exact.
+
+const char* const poly_op_names[POLY_OP_COUNT] = {"horner", "comp_horner", "comp_horner_DD", "estrin"};
+
+static void
+horner_array(const double* a, const double* x_hi, const double* x_lo, double* y_hi, double* y_lo, const size_t n) {
+    (void)x_lo;
+    for (size_t i = 0; i < n; i++) {
+        y_hi[i] = horner_D_D(a, BENCH_POLY_COEFFS, x_hi[i]);
+        y_lo[i] = 0.0;
+    }
+}
+
+static void
+comp_horner_array(const double* a, const double* x_hi, const double* x_lo, double* y_hi, double* y_lo, const size_t n) {
+    (void)x_lo;
+    for (size_t i = 0; i < n; i++) unpack_DD_D_D(comp_horner_D_DD(a, BENCH_POLY_COEFFS, x_hi[i]), &y_hi[i], &y_lo[i]);
+}
+
+static void
+comp_horner_DD_array(const double* a, const double* x_hi, const double* x_lo, double* y_hi, double* y_lo, const size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        unpack_DD_D_D(comp_horner_DD_DD(a, BENCH_POLY_COEFFS, load_D_D_DD(x_hi[i], x_lo[i])), &y_hi[i], &y_lo[i]);
+    }
+}
+
+static void
+estrin_array(const double* a, const double* x_hi, const double* x_lo, double* y_hi, double* y_lo, const size_t n) {
+    (void)x_lo;
+    for (size_t i = 0; i < n; i++) unpack_DD_D_D(estrin_D_DD(a, BENCH_POLY_COEFFS, x_hi[i]), &y_hi[i], &y_lo[i]);
+}
+
+const poly_func poly_ops_scalar[POLY_OP_COUNT] = {horner_array, comp_horner_array, comp_horner_DD_array, estrin_array};
+
+// Dependent chains:  0.0 * result cannot be folded away without -ffast-math, so each call waits for the previous one.
+static double
+horner_chain(const double* a, const double* x_hi, const double* x_lo, const size_t n) {
+    (void)x_lo;
+    double y = 0.0;
+    for (size_t i = 0; i < n; i++) y = horner_D_D(a, BENCH_POLY_COEFFS, x_hi[i] + 0.0 * y);
+    return y;
+}
+
+static double
+comp_horner_chain(const double* a, const double* x_hi, const double* x_lo, const size_t n) {
+    (void)x_lo;
+    double y = 0.0;
+    for (size_t i = 0; i < n; i++) y = DD_HI(comp_horner_D_DD(a, BENCH_POLY_COEFFS, x_hi[i] + 0.0 * y));
+    return y;
+}
+
+static double
+comp_horner_DD_chain(const double* a, const double* x_hi, const double* x_lo, const size_t n) {
+    double y = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        y = DD_HI(comp_horner_DD_DD(a, BENCH_POLY_COEFFS, load_D_D_DD(x_hi[i] + 0.0 * y, x_lo[i])));
+    }
+    return y;
+}
+
+static double
+estrin_chain(const double* a, const double* x_hi, const double* x_lo, const size_t n) {
+    (void)x_lo;
+    double y = 0.0;
+    for (size_t i = 0; i < n; i++) y = DD_HI(estrin_D_DD(a, BENCH_POLY_COEFFS, x_hi[i] + 0.0 * y));
+    return y;
+}
+
+typedef double (*chain_func)(const double* a, const double* x_hi, const double* x_lo, const size_t n);
+
+static const chain_func poly_chains[POLY_OP_COUNT] = {horner_chain, comp_horner_chain, comp_horner_DD_chain, estrin_chain};
+
+// xorshift64* (Vigna); a fixed seed makes the arguments reproducible.
+static uint64_t rng_state = 0x9e3779b97f4a7c15ULL;
+
+static inline uint64_t
+next_random(void) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545f4914f6cdd1dULL;
+}
+
+// Uniform in [0, 1).
+static inline double
+next_uniform(void) {
+    return (double)(next_random() >> 11) * 0x1.0p-53;
+}
+
+static double
+elapsed_ns(const struct timespec* start, const struct timespec* stop) {
+    return 1.0e9 * (double)(stop->tv_sec - start->tv_sec) + (double)(stop->tv_nsec - start->tv_nsec);
+}
+
+// The timing loops; "sink" keeps the results live.
+static volatile double sink;
+
+#define TIME_BEST(best, repeats, statement)                                                                                        \
+    do {                                                                                                                           \
+        for (int r_ = 0; r_ < (repeats); r_++) {                                                                                   \
+            struct timespec start_, stop_;                                                                                         \
+            timespec_get(&start_, TIME_UTC);                                                                                       \
+            statement;                                                                                                             \
+            timespec_get(&stop_, TIME_UTC);                                                                                        \
+            (best) = fmin((best), elapsed_ns(&start_, &stop_));                                                                    \
+        }                                                                                                                          \
+    } while (0)
+
+static double
+gamma_k(const int k) {
+    return (double)k * DBL_EPSILON / 2.0 / (1.0 - (double)k * DBL_EPSILON / 2.0);
+}
+
+// Exact p(x_hi + x_lo).
+static void
+mpfr_poly(mpfr_ptr ref, const double* a, const double x_hi, const double x_lo) {
+    mpfr_t x;
+    mpfr_init2(x, REF_MPFR_PREC);
+    mpfr_set_d(x, x_hi, MPFR_RNDN);
+    mpfr_add_d(x, x, x_lo, MPFR_RNDN);
+    mpfr_set_d(ref, a[0], MPFR_RNDN);
+    for (int i = 1; i < BENCH_POLY_COEFFS; i++) {
+        mpfr_mul(ref, ref, x, MPFR_RNDN);
+        mpfr_add_d(ref, ref, a[i], MPFR_RNDN);
+    }
+    mpfr_clear(x);
+    return;
+}
+
+static size_t
+count_mismatches(const char* op, const char* isa, const double* x_hi, const double* ref_hi, const double* ref_lo,
+                 const double* y_hi, const double* y_lo, const size_t n) {
+    size_t mismatches = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (memcmp(&ref_hi[i], &y_hi[i], sizeof(double)) != 0 || memcmp(&ref_lo[i], &y_lo[i], sizeof(double)) != 0) {
+            if (mismatches == 0) {
+                printf("%s %s(%.13a):  scalar = %.13a + %.13a  %s = %.13a + %.13a\n", op, isa, x_hi[i], ref_hi[i], ref_lo[i], isa,
+                       y_hi[i], y_lo[i]);
+            }
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+// Time, check and print every evaluator on one polynomial; returns the number of failed checks.
+static size_t
+run_poly(const char* name, const double* a, const double* x_hi, const double* x_lo, const size_t n, const int repeats,
+         const int have_avx512, double* y_hi, double* y_lo, double* z_hi, double* z_lo) {
+    double abs_a[BENCH_POLY_COEFFS];
+    for (int i = 0; i < BENCH_POLY_COEFFS; i++) abs_a[i] = fabs(a[i]);
+    const int degree = BENCH_POLY_COEFFS - 1;
+
+    printf("%s\n", name);
+    printf("%-14s  %-19s  %-19s  %-19s  %-19s  %-12s  %-12s  %s\n", "", "scalar ns/eval", "AVX2 ns/eval", "AVX-512 ns/eval",
+           "latency ns/eval", "max err ulp", "rounded ulp", "err/bound");
+    size_t failures = 0;
+    double ns_horner[4] = {0.0, 0.0, 0.0, 0.0};
+    mpfr_t ref;
+    mpfr_init2(ref, REF_MPFR_PREC);
+    for (int k = 0; k < POLY_OP_COUNT; k++) {
+        // The versions alternate so that all of them see the same machine load.
+        double ns[4] = {INFINITY, INFINITY, INFINITY, INFINITY};
+        for (int r = 0; r < repeats; r++) {
+            TIME_BEST(ns[0], 1, poly_ops_scalar[k](a, x_hi, x_lo, y_hi, y_lo, n));
+            TIME_BEST(ns[1], 1, poly_ops_avx2[k](a, x_hi, x_lo, z_hi, z_lo, n));
+            if (have_avx512) TIME_BEST(ns[2], 1, poly_ops_avx512[k](a, x_hi, x_lo, z_hi, z_lo, n));
+            TIME_BEST(ns[3], 1, sink = poly_chains[k](a, x_hi, x_lo, n));
+        }
+        if (k == 0) memcpy(ns_horner, ns, sizeof(ns));
+
+        // Bitwise identity; y holds the scalar results.
+        poly_ops_scalar[k](a, x_hi, x_lo, y_hi, y_lo, n);
+        poly_ops_avx2[k](a, x_hi, x_lo, z_hi, z_lo, n);
+        size_t mismatches = count_mismatches(poly_op_names[k], "avx2", x_hi, y_hi, y_lo, z_hi, z_lo, n);
+        if (have_avx512) {
+            poly_ops_avx512[k](a, x_hi, x_lo, z_hi, z_lo, n);
+            mismatches += count_mismatches(poly_op_names[k], "avx512", x_hi, y_hi, y_lo, z_hi, z_lo, n);
+        }
+
+        // Accuracy.  Only comp_horner_DD uses x_lo.
+        int uses_lo = (k == 2);
+        double gamma = gamma_k(2 * degree + (uses_lo ? 2 : 0));
+        double max_err = 0.0, max_rounded = 0.0, max_ratio = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            double lo = uses_lo ? x_lo[i] : 0.0;
+            mpfr_poly(ref, a, x_hi[i], lo);
+            double err = compare_DD(ref, load_D_D_DD(y_hi[i], y_lo[i]));
+            double rounded = compare(ref, y_hi[i]);
+            double bound = gamma * gamma * horner_D_D(abs_a, BENCH_POLY_COEFFS, fabs(x_hi[i]) + fabs(lo)) * (1.0 + 0x1.0p-40) /
+                           ulp(mpfr_get_d(ref, MPFR_RNDN));
+            if (!(err <= max_err)) max_err = err;
+            if (!(rounded <= max_rounded)) max_rounded = rounded;
+            if (!(err / bound <= max_ratio)) max_ratio = err / bound;
+        }
+        // Plain Horner has no double-double bound to meet.
+        int failed = (k != 0) && !(max_ratio <= 1.0);
+
+        char cols[5][32];
+        for (int v = 0; v < 4; v++) {
+            if (v == 2 && !have_avx512) snprintf(cols[v], sizeof(cols[v]), "-");
+            else snprintf(cols[v], sizeof(cols[v]), "%7.3f (%5.2fx)", ns[v] / (double)n, ns[v] / ns_horner[v]);
+        }
+        if (k == 0) snprintf(cols[4], sizeof(cols[4]), "-");
+        else snprintf(cols[4], sizeof(cols[4]), "%.3f", max_ratio);
+        printf("%-14s  %-19s  %-19s  %-19s  %-19s  %-12.3g  %-12.3g  %-9s  mismatches = %zu%s\n", poly_op_names[k], cols[0],
+               cols[1], cols[2], cols[3], max_err, max_rounded, cols[4], mismatches, failed ? "  (bound exceeded)" : "");
+        failures += mismatches + (size_t)failed;
+    }
+    mpfr_clear(ref);
+    printf("\n");
+    return failures;
+}
+
+int
+main(int argc, char* argv[]) {
+    if (argc != 3) {
+        printf("Usage:  %s arg_cnt repeats\n", argv[0]);
+        return -1;
+    }
+    long arg_cnt = atol(argv[1]);
+    int repeats = atoi(argv[2]);
+    if (arg_cnt <= 0 || repeats <= 0) {
+        printf("Bad arguments:  arg_cnt = %ld  repeats = %d\n", arg_cnt, repeats);
+        return -1;
+    }
+    size_t n = ((size_t)arg_cnt + 7) / 8 * 8;
+    int have_avx512 = __builtin_cpu_supports("avx512f");
+
+    double* buffer = malloc(6 * n * sizeof(double));
+    if (buffer == NULL) {
+        printf("Failed to allocate %zu points\n", n);
+        return -1;
+    }
+    double* x_hi = buffer;
+    double* x_lo = x_hi + n;
+    double* y_hi = x_lo + n;
+    double* y_lo = y_hi + n;
+    double* z_hi = y_lo + n;
+    double* z_lo = z_hi + n;
+
+    printf("%zu arguments, %d coefficients%s\n\n", n, BENCH_POLY_COEFFS, have_avx512 ? "" : ", AVX-512 skipped (no AVX-512F)");
+
+    // e^r - 1 for |r| <= log(2)/64, the range of the reduced argument in expxsqr.  x_lo is below half an ulp of x_hi.
+    double expm1_coeffs[BENCH_POLY_COEFFS];
+    const int N = sizeof(expxsqr_coeffs) / sizeof(expxsqr_coeffs[0]);
+    _Static_assert(sizeof(expxsqr_coeffs) / sizeof(expxsqr_coeffs[0]) + 2 == BENCH_POLY_COEFFS, "e^r - 1 = r + r^2 * P(r)");
+    for (int i = 0; i < N; i++) expm1_coeffs[i] = expxsqr_coeffs[i];
+    expm1_coeffs[N] = 1.0;
+    expm1_coeffs[N + 1] = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        x_hi[i] = (2.0 * next_uniform() - 1.0) * 0.5 * EXPXSQR_C1;
+        x_lo[i] = (next_uniform() - 0.5) * ulp(x_hi[i]);
+    }
+    size_t failures = run_poly("e^r - 1 = r + r^2 * P(r), |r| <= log(2)/64", expm1_coeffs, x_hi, x_lo, n, repeats, have_avx512,
+                               y_hi, y_lo, z_hi, z_lo);
+
+    // (x - 3/4)^6; the coefficients binomial(6, k) * (-3/4)^(6-k) are exact.
+    const double root_coeffs[BENCH_POLY_COEFFS] = {1.0, -4.5, 8.4375, -8.4375, 4.74609375, -1.423828125, 0.177978515625};
+    for (size_t i = 0; i < n; i++) {
+        double sign = (next_random() & 1) ? -1.0 : 1.0;
+        x_hi[i] = 0.75 + sign * exp2(-8.0 + 5.0 * next_uniform());
+        x_lo[i] = (next_uniform() - 0.5) * ulp(x_hi[i]);
+    }
+    failures += run_poly("(x - 3/4)^6, 2^-8 <= |x - 3/4| <= 2^-3", root_coeffs, x_hi, x_lo, n, repeats, have_avx512, y_hi, y_lo,
+                         z_hi, z_lo);
+
+    free(buffer);
+
+    if (failures != 0) {
+        printf("FAILED:  %zu checks (an error above its bound or vector results different from the scalar ones)\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,45 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+
+// Array wrappers around the polynomial evaluators of DD_arithmetic.h, DD_arithmetic_avx2.h and DD_arithmetic_avx512.h for
+// bench_DD_poly.  Every wrapper evaluates the polynomial with the BENCH_POLY_COEFFS coefficients a[] at (x_hi[i], x_lo[i]) and
+// stores the result in (y_hi[i], y_lo[i]).  The evaluators that take a double use only x_hi, and Horner stores 0.0 in y_lo.  The
+// number of coefficients is a compile-time constant so the loops are unrolled as they are in expxsqr.  n must be a multiple of 8.
+
+#if !defined(_BENCH_DD_POLY_H)
+#define _BENCH_DD_POLY_H 1
+
+#include <stddef.h>
+
+#define BENCH_POLY_COEFFS 7
+
+typedef void (*poly_func)(const double* a, const double* x_hi, const double* x_lo, double* y_hi, double* y_lo, const size_t n);
+
+// The evaluators, in the order of the tables below.
+#define POLY_OP_COUNT 4
+extern const char* const poly_op_names[POLY_OP_COUNT];
+
+extern const poly_func poly_ops_scalar[POLY_OP_COUNT];  // bench_DD_poly.c
+extern const poly_func poly_ops_avx2[POLY_OP_COUNT];    // bench_DD_poly_avx2.c
+extern const poly_func poly_ops_avx512[POLY_OP_COUNT];  // bench_DD_poly_avx512.c
+
+#endif // _BENCH_DD_POLY_H
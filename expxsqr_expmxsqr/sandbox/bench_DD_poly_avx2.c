@@ -0,0 +1,74 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+
+// AVX2/FMA array wrappers for bench_DD_poly (see bench_DD_poly.h):  each one runs a DD_arithmetic_avx2.h evaluator over 4 lanes at
+// a time.
+
+#include <stddef.h>
+
+#include <immintrin.h>
+
+#include "DD_arithmetic_avx2.h"
+#include "bench_DD_poly.h"
+
+#define LOAD(p) _mm256_loadu_pd(p)
+#define STORE(p, v) _mm256_storeu_pd((p), (v))
+
+static void
+horner_array(const double* a, const double* x_hi, const double* x_lo, double* y_hi, double* y_lo, const size_t n) {
+    (void)x_lo;
+    for (size_t i = 0; i < n; i += 4) {
+        STORE(&y_hi[i], horner_D4_D4(a, BENCH_POLY_COEFFS, LOAD(&x_hi[i])));
+        STORE(&y_lo[i], _mm256_setzero_pd());
+    }
+}
+
+static void
+comp_horner_array(const double* a, const double* x_hi, const double* x_lo, double* y_hi, double* y_lo, const size_t n) {
+    (void)x_lo;
+    for (size_t i = 0; i < n; i += 4) {
+        DD4 y = comp_horner_D4_DD4(a, BENCH_POLY_COEFFS, LOAD(&x_hi[i]));
+        STORE(&y_hi[i], DD4_HI(y));
+        STORE(&y_lo[i], DD4_LO(y));
+    }
+}
+
+static void
+comp_horner_DD_array(const double* a, const double* x_hi, const double* x_lo, double* y_hi, double* y_lo, const size_t n) {
+    for (size_t i = 0; i < n; i += 4) {
+        DD4 y = comp_horner_DD4_DD4(a, BENCH_POLY_COEFFS, load_D4_D4_DD4(LOAD(&x_hi[i]), LOAD(&x_lo[i])));
+        STORE(&y_hi[i], DD4_HI(y));
+        STORE(&y_lo[i], DD4_LO(y));
+    }
+}
+
+static void
+estrin_array(const double* a, const double* x_hi, const double* x_lo, double* y_hi, double* y_lo, const size_t n) {
+    (void)x_lo;
+    for (size_t i = 0; i < n; i += 4) {
+        DD4 y = estrin_D4_DD4(a, BENCH_POLY_COEFFS, LOAD(&x_hi[i]));
+        STORE(&y_hi[i], DD4_HI(y));
+        STORE(&y_lo[i], DD4_LO(y));
+    }
+}
+
+const poly_func poly_ops_avx2[POLY_OP_COUNT] = {horner_array, comp_horner_array, comp_horner_DD_array, estrin_array};
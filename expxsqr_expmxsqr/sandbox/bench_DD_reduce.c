@@ -0,0 +1,326 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Benchmark and check of the double-double sum, dot product and axpy (DD_reduce.h).
+//
+// Throughput:  the time per element (best of the repeats) of sum_dd, dot_dd and axpy_dd with one thread and with the requested
+// number of threads, next to a plain AVX2 double loop (four accumulators for the sum and dot product, an FMA for axpy) and a
+// scalar double-double loop with a single accumulator.
+//
+// Accuracy:  the error of each result against the exact value computed with MPFR, in ulps of the exact value rounded to double; it
+// must not exceed MAX_ERR_ULP.  The error of the plain double loop is shown for comparison.  The operands are the use case that
+// motivated these functions, e^(-x*x) weights for the sum, and random values in [-1, 1] for the dot product.
+//
+// Bitwise identity:  the scalar, AVX2 and AVX-512 kernels must give the same result for every block, and the drivers the same
+// result for 1, 2, 3 and the requested number of threads.  AVX-512 is skipped if the processor does not support AVX-512F.
+//
+// The program returns 1 if any check fails.
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <immintrin.h>
+
+#include "mpfr.h"
+
+#include "DD_arithmetic.h"
+#include "DD_reduce.h"
+#include "utils.h"
+
+#if !defined(MAX_ERR_ULP)
+#define MAX_ERR_ULP 0.001
+#endif
+
+#define DEFAULT_MPFR_PREC (4 * DBL_MANT_DIG)
+
+// xorshift64* (Vigna); a fixed seed makes the operands reproducible.
+static uint64_t rng_state = 0x9e3779b97f4a7c15ULL;
+
+static inline uint64_t
+next_random(void) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545f4914f6cdd1dULL;
+}
+
+// Uniform in [0, 1).
+static inline double
+next_uniform(void) {
+    return (double)(next_random() >> 11) * 0x1.0p-53;
+}
+
+static double
+elapsed_ns(const struct timespec* start, const struct timespec* stop) {
+    return 1.0e9 * (double)(stop->tv_sec - start->tv_sec) + (double)(stop->tv_nsec - start->tv_nsec);
+}
+
+// The plain double loops.
+static double
+plain_sum(const double* x, const size_t n) {
+    __m256d acc[4] = {_mm256_setzero_pd(), _mm256_setzero_pd(), _mm256_setzero_pd(), _mm256_setzero_pd()};
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        for (int k = 0; k < 4; k++) acc[k] = _mm256_add_pd(acc[k], _mm256_loadu_pd(&x[i + 4 * k]));
+    }
+    __m256d v = _mm256_add_pd(_mm256_add_pd(acc[0], acc[1]), _mm256_add_pd(acc[2], acc[3]));
+    double lanes[4];
+    _mm256_storeu_pd(lanes, v);
+    double s = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; i < n; i++) s += x[i];
+    return s;
+}
+
+static double
+plain_dot(const double* x, const double* y, const size_t n) {
+    __m256d acc[4] = {_mm256_setzero_pd(), _mm256_setzero_pd(), _mm256_setzero_pd(), _mm256_setzero_pd()};
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        for (int k = 0; k < 4; k++) {
+            acc[k] = _mm256_fmadd_pd(_mm256_loadu_pd(&x[i + 4 * k]), _mm256_loadu_pd(&y[i + 4 * k]), acc[k]);
+        }
+    }
+    __m256d v = _mm256_add_pd(_mm256_add_pd(acc[0], acc[1]), _mm256_add_pd(acc[2], acc[3]));
+    double lanes[4];
+    _mm256_storeu_pd(lanes, v);
+    double s = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    for (; i < n; i++) s = fma(x[i], y[i], s);
+    return s;
+}
+
+static void
+plain_axpy(const double a, const double* x, double* y, const size_t n) {
+    const __m256d a_vec = _mm256_set1_pd(a);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(&y[i], _mm256_fmadd_pd(a_vec, _mm256_loadu_pd(&x[i]), _mm256_loadu_pd(&y[i])));
+    for (; i < n; i++) y[i] = fma(a, x[i], y[i]);
+    return;
+}
+
+// The scalar double-double loops with a single accumulator.
+static DD
+serial_sum_dd(const double* x, const size_t n) {
+    DD s = load_D_D_DD(0.0, 0.0);
+    for (size_t i = 0; i < n; i++) s = add_DD_D_DD(s, x[i]);
+    return s;
+}
+
+static DD
+serial_dot_dd(const double* x, const double* y, const size_t n) {
+    DD s = load_D_D_DD(0.0, 0.0);
+    for (size_t i = 0; i < n; i++) s = add_DD_DD_DD(s, mul_D_D_DD(x[i], y[i]));
+    return s;
+}
+
+static int
+same_DD(const DD x, const DD y) {
+    return memcmp(&DD_HI(x), &DD_HI(y), sizeof(double)) == 0 && memcmp(&DD_LO(x), &DD_LO(y), sizeof(double)) == 0;
+}
+
+// The timing loops; "sink" keeps the results live.
+static volatile double sink;
+
+#define TIME_BEST(best, repeats, statement)                                                                                        \
+    do {                                                                                                                           \
+        for (int r_ = 0; r_ < (repeats); r_++) {                                                                                   \
+            struct timespec start_, stop_;                                                                                         \
+            timespec_get(&start_, TIME_UTC);                                                                                       \
+            statement;                                                                                                             \
+            timespec_get(&stop_, TIME_UTC);                                                                                        \
+            (best) = fmin((best), elapsed_ns(&start_, &stop_));                                                                    \
+        }                                                                                                                          \
+    } while (0)
+
+static void
+print_time(const char* op, const char* version, const double ns, const double plain_ns, const size_t n) {
+    printf("%-5s  %-22s  %7.3f ns/element  (%5.2fx plain)\n", op, version, ns / (double)n, ns / plain_ns);
+}
+
+// Exact sum of x[i] * y[i] (y = NULL for the sum of x[i]), rounded to DEFAULT_MPFR_PREC bits.
+static void
+mpfr_reference(mpfr_ptr ref, const double* x, const double* y, const size_t n) {
+    mpfr_t* terms = malloc(n * sizeof(mpfr_t));
+    mpfr_ptr* term_ptrs = malloc(n * sizeof(mpfr_ptr));
+    if (terms == NULL || term_ptrs == NULL) {
+        printf("Failed to allocate %zu MPFR terms\n", n);
+        exit(-1);
+    }
+    for (size_t i = 0; i < n; i++) {
+        mpfr_init2(terms[i], 2 * DBL_MANT_DIG);
+        mpfr_set_d(terms[i], x[i], MPFR_RNDN);
+        if (y != NULL) mpfr_mul_d(terms[i], terms[i], y[i], MPFR_RNDN); // Exact with 2 * DBL_MANT_DIG bits.
+        term_ptrs[i] = terms[i];
+    }
+    mpfr_sum(ref, term_ptrs, n, MPFR_RNDN);
+    for (size_t i = 0; i < n; i++) mpfr_clear(terms[i]);
+    free(term_ptrs);
+    free(terms);
+    return;
+}
+
+// Check that the kernels of every ISA agree on each block and that the drivers agree for several thread counts.
+static size_t
+check_identity(const double* x, const double* y, const size_t n, const int threads, const int have_avx512) {
+    size_t mismatches = 0;
+    for (size_t start = 0; start < n; start += DD_REDUCE_BLOCK) {
+        size_t count = (n - start < DD_REDUCE_BLOCK) ? n - start : DD_REDUCE_BLOCK;
+        DD s = sum_dd_kernel(&x[start], count);
+        DD d = dot_dd_kernel(&x[start], &y[start], count);
+        if (!same_DD(s, sum_dd_kernel_avx2(&x[start], count))) mismatches++;
+        if (!same_DD(d, dot_dd_kernel_avx2(&x[start], &y[start], count))) mismatches++;
+        if (have_avx512 && !same_DD(s, sum_dd_kernel_avx512(&x[start], count))) mismatches++;
+        if (have_avx512 && !same_DD(d, dot_dd_kernel_avx512(&x[start], &y[start], count))) mismatches++;
+    }
+    const int thread_counts[] = {2, 3, threads};
+    DD s1 = sum_dd(x, n, 1);
+    DD d1 = dot_dd(x, y, n, 1);
+    for (size_t k = 0; k < sizeof(thread_counts) / sizeof(thread_counts[0]); k++) {
+        if (!same_DD(s1, sum_dd(x, n, thread_counts[k]))) mismatches++;
+        if (!same_DD(d1, dot_dd(x, y, n, thread_counts[k]))) mismatches++;
+    }
+    return mismatches;
+}
+
+int
+main(int argc, char* argv[]) {
+    if (argc < 3 || argc > 4) {
+        printf("Usage:  %s arg_cnt repeats [threads]\n", argv[0]);
+        return -1;
+    }
+    long arg_cnt = atol(argv[1]);
+    int repeats = atoi(argv[2]);
+    int threads = (argc == 4) ? atoi(argv[3]) : 4;
+    if (arg_cnt <= 0 || repeats <= 0 || threads <= 0) {
+        printf("Bad arguments:  arg_cnt = %ld  repeats = %d  threads = %d\n", arg_cnt, repeats, threads);
+        return -1;
+    }
+    size_t n = (size_t)arg_cnt;
+    int have_avx512 = __builtin_cpu_supports("avx512f");
+
+    double* w = malloc(n * sizeof(double));
+    double* x = malloc(n * sizeof(double));
+    double* y = malloc(n * sizeof(double));
+    double* y_plain = malloc(n * sizeof(double));
+    double* y_hi = malloc(n * sizeof(double));
+    double* y_lo = malloc(n * sizeof(double));
+    if (w == NULL || x == NULL || y == NULL || y_plain == NULL || y_hi == NULL || y_lo == NULL) {
+        printf("Failed to allocate %zu points\n", n);
+        return -1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        double t = 6.0 * next_uniform();
+        w[i] = exp(-t * t);
+        x[i] = 2.0 * next_uniform() - 1.0;
+        y[i] = 2.0 * next_uniform() - 1.0;
+    }
+
+    printf("%zu elements, %d threads%s\n", n, threads, have_avx512 ? "" : ", AVX-512 skipped (no AVX-512F)");
+    double ns_plain = INFINITY, ns_serial = INFINITY, ns_one = INFINITY, ns_many = INFINITY;
+    TIME_BEST(ns_plain, repeats, sink = plain_sum(w, n));
+    TIME_BEST(ns_serial, repeats, sink = DD_HI(serial_sum_dd(w, n)));
+    TIME_BEST(ns_one, repeats, sink = DD_HI(sum_dd(w, n, 1)));
+    TIME_BEST(ns_many, repeats, sink = DD_HI(sum_dd(w, n, threads)));
+    print_time("sum", "plain double (AVX2)", ns_plain, ns_plain, n);
+    print_time("sum", "serial double-double", ns_serial, ns_plain, n);
+    print_time("sum", "sum_dd, 1 thread", ns_one, ns_plain, n);
+    print_time("sum", "sum_dd, threads", ns_many, ns_plain, n);
+
+    ns_plain = ns_serial = ns_one = ns_many = INFINITY;
+    TIME_BEST(ns_plain, repeats, sink = plain_dot(x, y, n));
+    TIME_BEST(ns_serial, repeats, sink = DD_HI(serial_dot_dd(x, y, n)));
+    TIME_BEST(ns_one, repeats, sink = DD_HI(dot_dd(x, y, n, 1)));
+    TIME_BEST(ns_many, repeats, sink = DD_HI(dot_dd(x, y, n, threads)));
+    print_time("dot", "plain double (AVX2)", ns_plain, ns_plain, n);
+    print_time("dot", "serial double-double", ns_serial, ns_plain, n);
+    print_time("dot", "dot_dd, 1 thread", ns_one, ns_plain, n);
+    print_time("dot", "dot_dd, threads", ns_many, ns_plain, n);
+
+    // axpy updates y in place; the arrays are not reset between repeats since only the time matters here.
+    ns_plain = ns_one = ns_many = INFINITY;
+    memcpy(y_plain, y, n * sizeof(double));
+    memcpy(y_hi, y, n * sizeof(double));
+    memset(y_lo, 0, n * sizeof(double));
+    TIME_BEST(ns_plain, repeats, plain_axpy(0x1.0p-20, x, y_plain, n));
+    TIME_BEST(ns_one, repeats, axpy_dd(0x1.0p-20, x, y_hi, y_lo, n, 1));
+    TIME_BEST(ns_many, repeats, axpy_dd(0x1.0p-20, x, y_hi, y_lo, n, threads));
+    print_time("axpy", "plain double (AVX2)", ns_plain, ns_plain, n);
+    print_time("axpy", "axpy_dd, 1 thread", ns_one, ns_plain, n);
+    print_time("axpy", "axpy_dd, threads", ns_many, ns_plain, n);
+
+    // Accuracy.
+    int failed = 0;
+    mpfr_t ref;
+    mpfr_init2(ref, DEFAULT_MPFR_PREC);
+
+    mpfr_reference(ref, w, NULL, n);
+    double err_dd = compare_DD(ref, sum_dd(w, n, threads));
+    double err_plain = compare(ref, plain_sum(w, n));
+    printf("sum   err = %.2e ulp (plain double %.3f ulp)\n", err_dd, err_plain);
+    if (!(err_dd <= MAX_ERR_ULP)) failed = 1;
+
+    mpfr_reference(ref, x, y, n);
+    err_dd = compare_DD(ref, dot_dd(x, y, n, threads));
+    err_plain = compare(ref, plain_dot(x, y, n));
+    printf("dot   err = %.2e ulp (plain double %.3f ulp)\n", err_dd, err_plain);
+    if (!(err_dd <= MAX_ERR_ULP)) failed = 1;
+
+    // axpy:  (y_hi, y_lo) = y + 3 * x, once, against the exact value of each element.
+    const double a = 3.0;
+    memcpy(y_hi, y, n * sizeof(double));
+    memset(y_lo, 0, n * sizeof(double));
+    axpy_dd(a, x, y_hi, y_lo, n, threads);
+    double axpy_err = 0.0;
+    mpfr_t term;
+    mpfr_init2(term, DEFAULT_MPFR_PREC);
+    for (size_t i = 0; i < n; i++) {
+        mpfr_set_d(term, x[i], MPFR_RNDN);
+        mpfr_mul_d(term, term, a, MPFR_RNDN);
+        mpfr_add_d(ref, term, y[i], MPFR_RNDN);
+        double err = compare_DD(ref, load_D_D_DD(y_hi[i], y_lo[i]));
+        if (!(err <= axpy_err)) axpy_err = err;
+    }
+    mpfr_clear(term);
+    printf("axpy  max err = %.2e ulp\n", axpy_err);
+    if (!(axpy_err <= MAX_ERR_ULP)) failed = 1;
+    mpfr_clear(ref);
+
+    size_t mismatches = check_identity(w, x, n, threads, have_avx512) + check_identity(x, y, n, threads, have_avx512);
+    printf("mismatches between ISAs and thread counts = %zu\n", mismatches);
+
+    free(y_lo);
+    free(y_hi);
+    free(y_plain);
+    free(y);
+    free(x);
+    free(w);
+
+    if (failed || mismatches != 0) {
+        printf("FAILED:  %s\n", failed ? "an error exceeds the bound" : "the results differ between ISAs or thread counts");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,260 @@
+// -*-  mode: C++;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Compare DoubleWord<T> (DoubleWord.hpp) with the C headers it generalizes:  DoubleWord<double> against every operation of
+// DD_arithmetic.h and DoubleWord<float> against the operations of FF_arithmetic.h.  Both are compiled here with the same options
+// (-O2 -mfma by default), so any difference in the time per operation is overhead of the C++ wrapper.  The operands are random
+// normalized double-words held in L1-sized arrays; each timing runs the operation over the arrays enough times to do about 2^16
+// operations and the time per operation is the best of the repeats.  The results must be bitwise identical; the program returns 1
+// if they are not.  A few static_asserts check that the operations can be evaluated at compile time.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+#include "DD_arithmetic.h"
+#include "FF_arithmetic.h"
+#include "DoubleWord.hpp"
+
+static constexpr size_t OPS_PER_TIMING = 65536;
+
+// Compile-time evaluation.
+static constexpr DoubleDouble dd_third = DoubleDouble(1.0) / DoubleDouble(3.0);
+static_assert(dd_third.high == 1.0 / 3.0 && dd_third.low == 0x1.5555555555555p-56, "constexpr DoubleDouble division");
+static_assert(DoubleDouble::two_prod(0x1.0000001p0, 0x1.0000001p0).low == 0x1.0p-56, "constexpr DoubleDouble::two_prod");
+static_assert(FloatFloat::two_sqr(0x1.001p0f).low == 0x1.0p-24f, "constexpr FloatFloat::two_sqr");
+static_assert(DoubleDouble::split(0x1.0000000000001p0).low == 0x1.0p-52, "constexpr DoubleDouble::split");
+
+template <typename T>
+struct Operands {
+    std::vector<T> x_hi, x_lo, y_hi, y_lo;
+};
+
+template <typename T>
+struct Results {
+    std::vector<T> hi, lo;
+};
+
+template <typename T>
+using op_func = void (*)(const Operands<T>& a, Results<T>& z, const size_t n);
+
+template <typename T>
+struct op_entry {
+    const char* name;
+    op_func<T> c_func;
+    op_func<T> cpp_func;
+};
+
+static inline DD
+split_D_DD(const double x) {
+    DD result;
+    split_D_D_D(x, &DD_HI(result), &DD_LO(result));
+    return result;
+}
+
+// The loops of one operation in its C and C++ forms.  Within the expressions xh and yh are the high parts of the operands, x and
+// y the operands as DD (C) or DoubleWord (C++).
+#define DD_OP(name, c_expr, cpp_expr)                                                                                              \
+    op_entry<double> {                                                                                                             \
+        name,                                                                                                                      \
+        +[](const Operands<double>& a, Results<double>& z, const size_t n) {                                                       \
+            for (size_t i = 0; i < n; i++) {                                                                                       \
+                [[maybe_unused]] const double xh = a.x_hi[i];                                                                      \
+                [[maybe_unused]] const double yh = a.y_hi[i];                                                                      \
+                [[maybe_unused]] const DD x = load_D_D_DD(a.x_hi[i], a.x_lo[i]);                                                   \
+                [[maybe_unused]] const DD y = load_D_D_DD(a.y_hi[i], a.y_lo[i]);                                                   \
+                const DD r = c_expr;                                                                                               \
+                z.hi[i] = DD_HI(r);                                                                                                \
+                z.lo[i] = DD_LO(r);                                                                                                \
+            }                                                                                                                      \
+        },                                                                                                                         \
+        +[](const Operands<double>& a, Results<double>& z, const size_t n) {                                                       \
+            for (size_t i = 0; i < n; i++) {                                                                                       \
+                [[maybe_unused]] const double xh = a.x_hi[i];                                                                      \
+                [[maybe_unused]] const double yh = a.y_hi[i];                                                                      \
+                [[maybe_unused]] const DoubleDouble x(a.x_hi[i], a.x_lo[i]);                                                       \
+                [[maybe_unused]] const DoubleDouble y(a.y_hi[i], a.y_lo[i]);                                                       \
+                const DoubleDouble r = cpp_expr;                                                                                   \
+                z.hi[i] = r.high;                                                                                                  \
+                z.lo[i] = r.low;                                                                                                   \
+            }                                                                                                                      \
+        }                                                                                                                          \
+    }
+
+#define FF_OP(name, c_expr, cpp_expr)                                                                                              \
+    op_entry<float> {                                                                                                              \
+        name,                                                                                                                      \
+        +[](const Operands<float>& a, Results<float>& z, const size_t n) {                                                         \
+            for (size_t i = 0; i < n; i++) {                                                                                       \
+                [[maybe_unused]] const float xh = a.x_hi[i];                                                                       \
+                [[maybe_unused]] const float yh = a.y_hi[i];                                                                       \
+                const FF r = c_expr;                                                                                               \
+                z.hi[i] = FF_HI(r);                                                                                                \
+                z.lo[i] = FF_LO(r);                                                                                                \
+            }                                                                                                                      \
+        },                                                                                                                         \
+        +[](const Operands<float>& a, Results<float>& z, const size_t n) {                                                         \
+            for (size_t i = 0; i < n; i++) {                                                                                       \
+                [[maybe_unused]] const float xh = a.x_hi[i];                                                                       \
+                [[maybe_unused]] const float yh = a.y_hi[i];                                                                       \
+                const FloatFloat r = cpp_expr;                                                                                     \
+                z.hi[i] = r.high;                                                                                                  \
+                z.lo[i] = r.low;                                                                                                   \
+            }                                                                                                                      \
+        }                                                                                                                          \
+    }
+
+static const op_entry<double> dd_ops[] = {
+    DD_OP("negate_DD", negate_DD_DD(x), -x),
+    DD_OP("split_D", split_D_DD(xh), DoubleDouble::split(xh)),
+    DD_OP("add_D_D", add_D_D_DD(xh, yh), DoubleDouble::two_sum(xh, yh)),
+    DD_OP("fast_add_D_D", fast_add_D_D_DD(xh, yh), DoubleDouble::fast_two_sum(xh, yh)),
+    DD_OP("add_DD_D", add_DD_D_DD(x, yh), x + yh),
+    DD_OP("add_DD_DD", add_DD_DD_DD(x, y), x + y),
+    DD_OP("mul_D_D", mul_D_D_DD(xh, yh), DoubleDouble::two_prod(xh, yh)),
+    DD_OP("sqr_D", sqr_D_DD(xh), DoubleDouble::two_sqr(xh)),
+    DD_OP("mul_DD_D", mul_DD_D_DD(x, yh), x * yh),
+    DD_OP("mul_DD_DD", mul_DD_DD_DD(x, y), x * y),
+    DD_OP("div_DD_D", div_DD_D_DD(x, yh), x / yh),
+    DD_OP("div_DD_DD", div_DD_DD_DD(x, y), x / y),
+};
+
+static const op_entry<float> ff_ops[] = {
+    FF_OP("add_F_F", add_F_F_FF(xh, yh), FloatFloat::two_sum(xh, yh)),
+    FF_OP("fast_add_F_F", fast_add_F_F_FF(xh, yh), FloatFloat::fast_two_sum(xh, yh)),
+    FF_OP("mul_F_F", mul_F_F_FF(xh, yh), FloatFloat::two_prod(xh, yh)),
+    FF_OP("sqr_F", sqr_F_FF(xh), FloatFloat::two_sqr(xh)),
+};
+
+// xorshift64* (Vigna); a fixed seed makes the operands reproducible.
+static uint64_t rng_state = 0x9e3779b97f4a7c15ULL;
+
+static inline uint64_t
+next_random(void) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545f4914f6cdd1dULL;
+}
+
+// A random normalized double-word with a random sign and |hi| in [2^-8, 2^8).
+template <typename T>
+static DoubleWord<T>
+random_double_word(void) {
+    constexpr int digits = std::numeric_limits<T>::digits;
+    T sign = (next_random() & 1) ? -1 : 1;
+    T h = sign * std::ldexp(1 + std::ldexp(static_cast<T>(next_random() >> (64 - digits)), -digits),
+                            static_cast<int>(next_random() % 16) - 8);
+    T l = h * (std::ldexp(static_cast<T>(next_random() >> (64 - digits)), -digits) - static_cast<T>(0.5)) *
+          std::ldexp(static_cast<T>(1), 1 - digits);
+    return DoubleWord<T>::fast_two_sum(h, l);
+}
+
+static double
+elapsed_ns(const struct timespec* start, const struct timespec* stop) {
+    return 1.0e9 * (double)(stop->tv_sec - start->tv_sec) + (double)(stop->tv_nsec - start->tv_nsec);
+}
+
+template <typename T>
+static double
+time_op(op_func<T> func, const Operands<T>& a, Results<T>& z, const size_t n, const size_t passes) {
+    struct timespec start, stop;
+    timespec_get(&start, TIME_UTC);
+    for (size_t p = 0; p < passes; p++) func(a, z, n);
+    timespec_get(&stop, TIME_UTC);
+    return elapsed_ns(&start, &stop);
+}
+
+// Time the C and C++ forms of each operation and count the results that are not bitwise identical.
+template <typename T, size_t N>
+static size_t
+compare_ops(const char* type, const op_entry<T> (&op_table)[N], const size_t n, const int repeats) {
+    Operands<T> a;
+    for (size_t i = 0; i < n; i++) {
+        DoubleWord<T> x = random_double_word<T>();
+        DoubleWord<T> y = random_double_word<T>();
+        a.x_hi.push_back(x.high);
+        a.x_lo.push_back(x.low);
+        a.y_hi.push_back(y.high);
+        a.y_lo.push_back(y.low);
+    }
+    Results<T> c_results{std::vector<T>(n), std::vector<T>(n)};
+    Results<T> cpp_results{std::vector<T>(n), std::vector<T>(n)};
+    const size_t passes = (n < OPS_PER_TIMING) ? OPS_PER_TIMING / n : 1;
+    const double ops = static_cast<double>(n * passes);
+
+    printf("%s:  %zu operands, %zu passes per timing\n", type, n, passes);
+    size_t mismatches = 0;
+    for (const op_entry<T>& op : op_table) {
+        // The two forms alternate so that both see the same machine load.
+        double ns_c = INFINITY;
+        double ns_cpp = INFINITY;
+        for (int r = 0; r < repeats; r++) {
+            ns_c = std::fmin(ns_c, time_op(op.c_func, a, c_results, n, passes));
+            ns_cpp = std::fmin(ns_cpp, time_op(op.cpp_func, a, cpp_results, n, passes));
+        }
+        size_t op_mismatches = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (std::memcmp(&c_results.hi[i], &cpp_results.hi[i], sizeof(T)) != 0 ||
+                std::memcmp(&c_results.lo[i], &cpp_results.lo[i], sizeof(T)) != 0) {
+                if (op_mismatches == 0) {
+                    printf("%s(%.13a + %.13a, %.13a + %.13a):  C = %.13a + %.13a  C++ = %.13a + %.13a\n", op.name,
+                           (double)a.x_hi[i], (double)a.x_lo[i], (double)a.y_hi[i], (double)a.y_lo[i], (double)c_results.hi[i],
+                           (double)c_results.lo[i], (double)cpp_results.hi[i], (double)cpp_results.lo[i]);
+                }
+                op_mismatches++;
+            }
+        }
+        mismatches += op_mismatches;
+        printf("%-12s  C %7.3f ns/op  C++ %7.3f ns/op  (%+.1f%%)  mismatches = %zu\n", op.name, ns_c / ops, ns_cpp / ops,
+               100.0 * (ns_cpp - ns_c) / ns_c, op_mismatches);
+    }
+    return mismatches;
+}
+
+int
+main(int argc, char* argv[]) {
+    if (argc != 3) {
+        printf("Usage:  %s arg_cnt repeats\n", argv[0]);
+        return -1;
+    }
+    long arg_cnt = atol(argv[1]);
+    int repeats = atoi(argv[2]);
+    if (arg_cnt <= 0 || repeats <= 0) {
+        printf("Bad arguments:  arg_cnt = %ld  repeats = %d\n", arg_cnt, repeats);
+        return -1;
+    }
+
+    size_t mismatches = 0;
+    mismatches += compare_ops("DoubleWord<double> vs DD_arithmetic.h", dd_ops, static_cast<size_t>(arg_cnt), repeats);
+    mismatches += compare_ops("DoubleWord<float> vs FF_arithmetic.h", ff_ops, static_cast<size_t>(arg_cnt), repeats);
+
+    if (mismatches != 0) {
+        printf("FAILED:  the DoubleWord results differ from those of the C headers\n");
+        return 1;
+    }
+    return 0;
+}
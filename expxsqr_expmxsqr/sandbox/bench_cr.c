@@ -0,0 +1,148 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+
+// Compare the cost of the correctly rounded tier (expxsqr_cr and expmxsqr_cr) with the default accurate tier on normal arguments
+// drawn uniformly over the whole range where the results are normal, and subnormal for expmxsqr.  The time per result is the best
+// of the repeats, and the fraction of the arguments for which the rounding test failed and expxsqr_td() was called is reported.
+// Both tiers are within one ulp of the exact result, so the program returns 1 if any two results are more than one ulp apart.
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "expxsqr.h"
+
+typedef double (*scalar_func)(const double x);
+
+// xorshift64* (Vigna); a fixed seed makes the argument stream reproducible.
+static uint64_t rng_state = 0x9e3779b97f4a7c15ULL;
+
+static inline uint64_t
+next_random(void) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545f4914f6cdd1dULL;
+}
+
+// Uniform in [0, 1).
+static inline double
+next_uniform(void) {
+    return (double)(next_random() >> 11) * 0x1.0p-53;
+}
+
+static double
+elapsed_ns(const struct timespec* start, const struct timespec* stop) {
+    return 1.0e9 * (double)(stop->tv_sec - start->tv_sec) + (double)(stop->tv_nsec - start->tv_nsec);
+}
+
+static double
+time_function(scalar_func func, const double* x, double* y, const size_t n) {
+    struct timespec start, stop;
+    timespec_get(&start, TIME_UTC);
+    for (size_t i = 0; i < n; i++) y[i] = func(x[i]);
+    timespec_get(&stop, TIME_UTC);
+    return elapsed_ns(&start, &stop);
+}
+
+// Time both tiers of one function and count the results that differ, and those that differ by more than one ulp.
+static size_t
+compare_tiers(const char* name, scalar_func accurate, scalar_func correctly_rounded, const double* x, double* y_accurate,
+              double* y_cr, const size_t n, const int repeats) {
+    // The two tiers alternate so that both see the same machine load.  The escalations are counted over the last repeat only.
+    double ns_accurate = INFINITY;
+    double ns_cr = INFINITY;
+    unsigned long long escalations = 0;
+    for (int r = 0; r < repeats; r++) {
+        ns_accurate = fmin(ns_accurate, time_function(accurate, x, y_accurate, n) / (double)n);
+        unsigned long long before = expxsqr_cr_escalations();
+        ns_cr = fmin(ns_cr, time_function(correctly_rounded, x, y_cr, n) / (double)n);
+        escalations = expxsqr_cr_escalations() - before;
+    }
+    size_t differences = 0;
+    size_t failures = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (y_accurate[i] == y_cr[i]) continue;
+        differences++;
+        if (nextafter(y_accurate[i], y_cr[i]) != y_cr[i]) {
+            if (failures == 0) {
+                printf("%s(%.17e):  accurate = %.17e (%.13a)  correctly rounded = %.17e (%.13a)\n", name, x[i], y_accurate[i],
+                       y_accurate[i], y_cr[i], y_cr[i]);
+            }
+            failures++;
+        }
+    }
+    printf("%-8s  accurate %7.3f ns/result  correctly rounded %7.3f ns/result  (%+.1f%%)  escalations = %llu (%.3f%%)  "
+           "differences = %zu  mismatches = %zu\n",
+           name, ns_accurate, ns_cr, 100.0 * (ns_cr - ns_accurate) / ns_accurate, escalations,
+           100.0 * (double)escalations / (double)n, differences, failures);
+    return failures;
+}
+
+int
+main(int argc, char* argv[]) {
+    if (argc != 3) {
+        printf("Usage:  %s arg_cnt repeats\n", argv[0]);
+        return -1;
+    }
+    long arg_cnt = atol(argv[1]);
+    int repeats = atoi(argv[2]);
+    if (arg_cnt <= 0 || repeats <= 0) {
+        printf("Bad arguments:  arg_cnt = %ld  repeats = %d\n", arg_cnt, repeats);
+        return -1;
+    }
+    size_t n = (size_t)arg_cnt;
+
+    double* x_exp = malloc(n * sizeof(double));
+    double* x_expm = malloc(n * sizeof(double));
+    double* y_accurate = malloc(n * sizeof(double));
+    double* y_cr = malloc(n * sizeof(double));
+    if (x_exp == NULL || x_expm == NULL || y_accurate == NULL || y_cr == NULL) {
+        printf("Failed to allocate %zu points\n", n);
+        return -1;
+    }
+    // The same upper limits as test1:  the largest x for which expxsqr does not overflow and expmxsqr does not underflow to zero.
+    for (size_t i = 0; i < n; i++) {
+        double sign = (next_random() & 1) ? -1.0 : 1.0;
+        x_exp[i] = sign * (0x1.0p-26 + next_uniform() * 0x1.aa4499161cd48p+4);
+        x_expm[i] = sign * (0x1.0p-26 + next_uniform() * 0x1.b4c109b69b1bap+4);
+    }
+
+    printf("%zu arguments\n", n);
+    size_t mismatches = 0;
+    mismatches += compare_tiers("expxsqr", expxsqr, expxsqr_cr, x_exp, y_accurate, y_cr, n, repeats);
+    mismatches += compare_tiers("expmxsqr", expmxsqr, expmxsqr_cr, x_expm, y_accurate, y_cr, n, repeats);
+
+    free(y_cr);
+    free(y_accurate);
+    free(x_expm);
+    free(x_exp);
+
+    if (mismatches != 0) {
+        printf("FAILED:  the correctly rounded results differ from the accurate ones by more than one ulp\n");
+        return 1;
+    }
+    return 0;
+}
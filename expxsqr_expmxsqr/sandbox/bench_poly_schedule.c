@@ -0,0 +1,159 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+
+// Compare the Horner (default) and Estrin (-DEXPXSQR_POLY=EXPXSQR_POLY_ESTRIN) polynomial schemes of the scalar expxsqr and
+// expmxsqr, in the default and the fast tier.  Latency is measured on a dependent chain of calls, where each argument is
+// x[i] + 0.0 * (previous result) so that a call cannot start before the previous one has finished; throughput is measured on
+// independent calls over the same arguments.  The time per call is the best of the repeats.  The two schemes round the polynomial
+// differently, so the results may differ in the last bit; the accuracy of each is checked by test_accuracy (see test1).  Here,
+// results that differ by more than 1 ulp make the program return 1.
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "expxsqr.h"
+
+typedef double (*scalar_func)(const double x);
+
+// xorshift64* (Vigna); a fixed seed makes the argument stream reproducible.
+static uint64_t rng_state = 0x9e3779b97f4a7c15ULL;
+
+static inline uint64_t
+next_random(void) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545f4914f6cdd1dULL;
+}
+
+// Uniform in [0, 1).
+static inline double
+next_uniform(void) {
+    return (double)(next_random() >> 11) * 0x1.0p-53;
+}
+
+static double
+elapsed_ns(const struct timespec* start, const struct timespec* stop) {
+    return 1.0e9 * (double)(stop->tv_sec - start->tv_sec) + (double)(stop->tv_nsec - start->tv_nsec);
+}
+
+// "sink" keeps the result of the chain live.
+static volatile double sink;
+
+static double
+time_chain(scalar_func func, const double* x, const size_t n) {
+    struct timespec start, stop;
+    double y = 0.0;
+    timespec_get(&start, TIME_UTC);
+    for (size_t i = 0; i < n; i++) y = func(x[i] + 0.0 * y);
+    timespec_get(&stop, TIME_UTC);
+    sink = y;
+    return elapsed_ns(&start, &stop);
+}
+
+static double
+time_independent(scalar_func func, const double* x, double* y, const size_t n) {
+    struct timespec start, stop;
+    timespec_get(&start, TIME_UTC);
+    for (size_t i = 0; i < n; i++) y[i] = func(x[i]);
+    timespec_get(&stop, TIME_UTC);
+    return elapsed_ns(&start, &stop);
+}
+
+// Time both schemes of one function and compare their results; returns the number of results more than 1 ulp apart.
+static size_t
+compare_schemes(const char* name, scalar_func horner, scalar_func estrin, const double* x, double* y_horner, double* y_estrin,
+                const size_t n, const int repeats) {
+    // The two schemes alternate so that both see the same machine load.
+    double chain_horner = INFINITY, chain_estrin = INFINITY, indep_horner = INFINITY, indep_estrin = INFINITY;
+    for (int r = 0; r < repeats; r++) {
+        chain_horner = fmin(chain_horner, time_chain(horner, x, n) / (double)n);
+        chain_estrin = fmin(chain_estrin, time_chain(estrin, x, n) / (double)n);
+        indep_horner = fmin(indep_horner, time_independent(horner, x, y_horner, n) / (double)n);
+        indep_estrin = fmin(indep_estrin, time_independent(estrin, x, y_estrin, n) / (double)n);
+    }
+    size_t differ = 0, far = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (y_horner[i] == y_estrin[i]) continue;
+        differ++;
+        if (y_estrin[i] != nextafter(y_horner[i], y_estrin[i])) {
+            if (far == 0) {
+                printf("%s(%.17e):  Horner = %.17e (%.13a)  Estrin = %.17e (%.13a)\n", name, x[i], y_horner[i], y_horner[i],
+                       y_estrin[i], y_estrin[i]);
+            }
+            far++;
+        }
+    }
+    printf("%-13s  latency:     Horner %7.3f ns  Estrin %7.3f ns  (%+.1f%%)\n", name, chain_horner, chain_estrin,
+           100.0 * (chain_estrin - chain_horner) / chain_horner);
+    printf("%-13s  throughput:  Horner %7.3f ns  Estrin %7.3f ns  (%+.1f%%)\n", name, indep_horner, indep_estrin,
+           100.0 * (indep_estrin - indep_horner) / indep_horner);
+    printf("%-13s  results differing in the last bit:  %zu of %zu (%.3f%%)  more than 1 ulp apart = %zu\n", name, differ, n,
+           100.0 * (double)differ / (double)n, far);
+    return far;
+}
+
+int
+main(int argc, char* argv[]) {
+    if (argc != 3) {
+        printf("Usage:  %s arg_cnt repeats\n", argv[0]);
+        return -1;
+    }
+    long arg_cnt = atol(argv[1]);
+    int repeats = atoi(argv[2]);
+    if (arg_cnt <= 0 || repeats <= 0) {
+        printf("Bad arguments:  arg_cnt = %ld  repeats = %d\n", arg_cnt, repeats);
+        return -1;
+    }
+    size_t n = (size_t)arg_cnt;
+
+    double* x = malloc(n * sizeof(double));
+    double* y_horner = malloc(n * sizeof(double));
+    double* y_estrin = malloc(n * sizeof(double));
+    if (x == NULL || y_horner == NULL || y_estrin == NULL) {
+        printf("Failed to allocate %zu points\n", n);
+        return -1;
+    }
+    // Arguments with normal results for both functions.
+    for (size_t i = 0; i < n; i++) x[i] = ((next_random() & 1) ? -1.0 : 1.0) * (0x1.0p-26 + next_uniform() * 26.6);
+
+    printf("%zu arguments, time per call\n", n);
+    size_t far = 0;
+    far += compare_schemes("expxsqr", expxsqr, expxsqr_estrin, x, y_horner, y_estrin, n, repeats);
+    far += compare_schemes("expmxsqr", expmxsqr, expmxsqr_estrin, x, y_horner, y_estrin, n, repeats);
+    far += compare_schemes("expxsqr_fast", expxsqr_fast, expxsqr_fast_estrin, x, y_horner, y_estrin, n, repeats);
+    far += compare_schemes("expmxsqr_fast", expmxsqr_fast, expmxsqr_fast_estrin, x, y_horner, y_estrin, n, repeats);
+
+    free(y_estrin);
+    free(y_horner);
+    free(x);
+
+    if (far != 0) {
+        printf("FAILED:  the Horner and Estrin results differ by more than 1 ulp\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,181 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+
+// e^x for a double-double x, evaluated in double-double arithmetic:  the engine of expxsqr_dd() and expmxsqr_dd(), and of any
+// other function whose exponent is available as a double-double (products, differences of logarithms, ...).
+
+// |x| is reduced by C = log(2)/T to r = |x| - k*C with k = m*T + j, using the tables of expxsqr_tables.h:  e^r - 1 is the minimax
+// polynomial, evaluated in double with a double-double head, and 2^(j/T) (2^(-j/T) for negative x) is read from expxsqr_power_2
+// (expmxsqr_power_2), so that e^x = 2^(+-m) * 2^(+-j/T) * e^(+-r) involves no division.  The relative error is bounded by the error
+// of the polynomial (EXPXSQR_COEFFS_MAX_ERR, ~9.1e-20 with the default tables), i.e. about 2^-63.  Where e^x is below 2^-969, the
+// low part is scaled into the subnormal range and the extra precision is progressively lost.  exp_DD_avx2.h and exp_DD_avx512.h
+// contain the vector versions, which give bitwise identical results.
+
+// reduce_D(), reduced_arg_DD() and the two reconstructions, reconstruct_accurate_DD() with a single correction and reconstruct_DD()
+// in full double-double, are also the reduction and reconstruction of expxsqr() and expmxsqr() (all tiers), expxsqr_pair() and
+// gaussian_kernel(), and their vector counterparts are those of the AVX2 and AVX-512 kernels.
+
+// Requires FMA instruction.
+// Uses #pragma GCC unroll N
+
+// References:
+//  [1] S. Boldo, M. Daumas, and R.-C. Li, “Formally Verified Argument Reduction with a Fused Multiply-Add,” IEEE Transactions on Computers, vol. 58, no. 8, pp. 1139–1145, 2009, doi: 10.1109/TC.2008.216.
+//  [2] J. M. Muller, Elementary functions: algorithms and implementation, Third edition. Boston: Birkhäuser, 2016.
+
+#if !defined(_EXP_DD_H)
+#define _EXP_DD_H 1
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+
+#include "DD_arithmetic.h"
+#include "expxsqr_tables.h"
+
+// e^x is Inf if hi(x) > EXP_DD_MAX and 0.0 if hi(x) < EXP_DD_MIN; in between, 0 <= m <= 1024 for x >= 0 and 0 <= m <= 1075 for
+// x < 0.
+#define EXP_DD_MAX (0x1.62e42fefa39eep+9)
+#define EXP_DD_MIN (-0x1.74910d52d3051p+9)
+
+// Multiply both parts of x by 2^e for -1076 <= e <= 1024.  The factor is applied as 2^(e/2) * 2^(e - e/2) so that both powers of 2
+// are normal doubles; the first multiplication is exact and the second rounds only if the result is subnormal.
+static inline DD
+scale_DD(const DD x, const int e) {
+    union {
+        double d;
+        uint64_t ui64;
+    } s1, s2;
+    s1.ui64 = (uint64_t)(e / 2 + DBL_MAX_EXP - 1) << (DBL_MANT_DIG - 1);
+    s2.ui64 = (uint64_t)(e - e / 2 + DBL_MAX_EXP - 1) << (DBL_MANT_DIG - 1);
+    return load_D_D_DD((DD_HI(x) * s1.d) * s2.d, (DD_LO(x) * s1.d) * s2.d);
+}
+
+// Calculate k = nearestint(a/C) = m*T + j for 0 <= a < 2^31 * C, where C = log(2)/T; returns k as a double.  With
+// reduced_arg_DD(), this is the argument reduction of all the functions built on the tables of expxsqr_tables.h.
+static inline double
+reduce_D(const double a, int* m, int* j) {
+    const double CONST = 0x1.8p52;                                // 3.0 * 2^(DBL_MANT_DIG - 2) = 6755399441055744.
+    const double R = EXPXSQR_R;                                  // 1 / (log(2)/T).
+    double k_dbl = nearbyint((fma(a, R, CONST) - CONST));         // Round to nearest integer.
+    int k = (int)k_dbl;
+    *m = k / EXPXSQR_TABLE_SIZE;
+    *j = k % EXPXSQR_TABLE_SIZE;
+    return k_dbl;
+}
+
+// Calculate the reduced argument a - k*C = r_hi + r_lo for k_dbl = reduce_D(a, ...); |r_hi| <= log(2)/(2T).  This is kept apart
+// from reduce_D() because the fast tier of expxsqr() and expmxsqr() needs only r_hi, and the compiler drops the rest.
+static inline DD
+reduced_arg_DD(const double a, const double k_dbl) {
+    // See see Ref [2], section 11.2.2, algorithm 23.  Also see Ref [1], algorithms 5.1 and 5.2.
+    const double C1 = EXPXSQR_C1;                                // 1/R rounded to DBL_MANT_DIG - 2 digits.
+    const double C2 = EXPXSQR_C2;                                // C - C1.
+    double temp1 = fma(-k_dbl, C1, a);
+    double r_hi = fma(-k_dbl, C2, temp1);
+    DD temp2 = mul_D_D_DD(k_dbl, C2);
+    DD temp3 = fast_add_D_D_DD(temp1, -DD_HI(temp2));
+    return load_D_D_DD(r_hi, ((DD_HI(temp3) - r_hi) + DD_LO(temp3)) - DD_LO(temp2));
+}
+
+// Calculate p(r) such that e^r - 1 = r + r^2 * p(r), with the coefficients expxsqr_coeffs.  Horner's scheme is used unless the
+// including file defines EXP_DD_POLY_ESTRIN (expxsqr.c and expmxsqr.c built with -DEXPXSQR_POLY=EXPXSQR_POLY_ESTRIN).
+static inline double
+poly_D(const double r) {
+    const int N = sizeof(expxsqr_coeffs) / sizeof(expxsqr_coeffs[0]);
+#if defined(EXP_DD_POLY_ESTRIN)
+    return estrin_D_D(expxsqr_coeffs, N, r);
+#else
+    double p = expxsqr_coeffs[0];
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll N
+#endif
+    for (int i = 1; i < N; i++) {
+        p = fma(r, p, expxsqr_coeffs[i]);
+    }
+    return p;
+#endif
+}
+
+// Calculate 2^(+-j/T) * e^(+-(r_hi + r_lo + lo)) for r = r_hi + r_lo, where power_2 is 2^(+-j/T) and sign is +1.0 or -1.0, with a
+// single correction:  e^(+-r_hi) - 1 is formed in double and added to 2^(+-j/T) with add_DD_D_DD(), so that only the high part of
+// the result is accurate.  This is the reconstruction of expxsqr(), expmxsqr(), expxsqr_pair() and gaussian_kernel(); with a
+// constant sign, the multiplications by sign are exact negations, which the compiler folds.
+static inline DD
+reconstruct_accurate_DD(const DD r, const double lo, const DD power_2, const double sign) {
+    const double s_hi = sign * DD_HI(r);
+    const double s_lo = sign * DD_LO(r);
+
+    // Evaluate e^(+-j/T) * e^(+-r_hi).
+    double temp1 = poly_D(s_hi);
+    temp1 = s_hi + (s_lo + (s_hi * s_hi * temp1));                       // temp1 = e^+-r_hi - 1.
+    DD temp4 = add_DD_D_DD(power_2, DD_HI(power_2) * temp1);            // temp4 = e^(+-j/T) * e^+-r_hi.
+
+    // Evaluate e^+-(r_lo + lo).
+    double temp6 = sign * (DD_LO(r) + lo);
+    DD temp5 = add_D_D_DD(1.0, temp6 + 0.5 * temp6 * temp6);
+
+    return mul_DD_DD_DD(temp4, temp5);
+}
+
+// Calculate 2^(+-j/T) * e^(+-(r_hi + r_lo + lo)) in double-double for r = r_hi + r_lo, where power_2 is 2^(+-j/T) and sign is +1.0
+// or -1.0:  unlike reconstruct_accurate_DD(), e^(+-r_hi) - 1 and its product with 2^(+-j/T) are kept in double-double, so that the
+// relative error of the result is bounded by that of the polynomial, about 2^-63 (see EXPXSQR_CR_MAX_ERR in expxsqr_tables.h).
+static inline DD
+reconstruct_DD(const DD r, const double lo, const DD power_2, const double sign) {
+    const double s_hi = sign * DD_HI(r);
+    const double s_lo = sign * DD_LO(r);
+
+    // Evaluate e^(+-j/T) * e^(+-r_hi).
+    double temp1 = poly_D(s_hi);
+    DD temp7 = fast_add_D_D_DD(s_hi, s_hi * s_hi * temp1);               // temp7 = e^+-r_hi - 1.
+    DD temp4 = add_DD_DD_DD(power_2, mul_DD_DD_DD(power_2, temp7));     // temp4 = e^(+-j/T) * e^+-r_hi.
+
+    // Evaluate e^+-(r_lo + lo).  |temp6| < 2^-43, so the cubic term is below 2^-130.
+    double temp6 = s_lo + sign * lo;
+    DD temp5 = add_D_D_DD(1.0, temp6 + 0.5 * temp6 * temp6);
+
+    return mul_DD_DD_DD(temp4, temp5);
+}
+
+// e^x -> DD
+// x is expected to be normalized (|lo| <= ulp(hi)/2).  A NaN gives NaN, hi(x) > EXP_DD_MAX gives Inf and hi(x) < EXP_DD_MIN gives
+// 0.0, each with a low part of 0.0.
+static inline DD
+exp_DD_DD(const DD x) {
+    if (isnan(DD_HI(x))) return load_D_D_DD(DD_HI(x) + DD_HI(x), 0.0); // Raise FE_INVALID if x is a signalling NaN.
+    if (DD_HI(x) > EXP_DD_MAX) return load_D_D_DD(INFINITY, 0.0);
+    if (DD_HI(x) < EXP_DD_MIN) return load_D_D_DD(0.0, 0.0);
+
+    // a = |x|; the sign of -0.0 is kept, as in the vector versions.
+    const double sign = copysign(1.0, DD_HI(x));
+    DD a = load_D_D_DD(sign * DD_HI(x), sign * DD_LO(x));
+
+    // Reduce a = k*C + r + DD_LO(a) with k = m*T + j, combine to make 2^(+-j/T) * e^(+-r) = 2^(-+m) * e^x and apply the scale
+    // factor 2^(+-m).
+    int m, j;
+    double k_dbl = reduce_D(DD_HI(a), &m, &j);
+    DD r = reduced_arg_DD(DD_HI(a), k_dbl);
+    if (sign > 0.0) return scale_DD(reconstruct_DD(r, DD_LO(a), expxsqr_power_2[j], 1.0), m);
+    return scale_DD(reconstruct_DD(r, DD_LO(a), expmxsqr_power_2[j], -1.0), -m);
+}
+
+#endif // _EXP_DD_H
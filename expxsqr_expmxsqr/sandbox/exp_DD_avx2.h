@@ -0,0 +1,194 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+
+// Four-lane AVX2/FMA versions of exp_DD.h:  e^x for double-double arguments, evaluated in double-double arithmetic.  Each lane
+// produces the same bits as exp_DD_DD().  reduce_D4(), reduced_arg_DD4(), gather_power_2_DD4() and reconstruct_DD4() are also used
+// directly by callers whose arguments all have the same sign (expxsqr_dd_avx2.c), which saves the second table gather of
+// exp_DD4_DD4(); reduce_D4(), reduced_arg_DD4() and reconstruct_accurate_DD4() are the reduction and reconstruction of the AVX2
+// expxsqr, pair and Gaussian kernels.
+
+// Requires AVX2 and FMA instructions.
+// Uses #pragma GCC unroll N
+
+// References:
+//  [1] S. Boldo, M. Daumas, and R.-C. Li, “Formally Verified Argument Reduction with a Fused Multiply-Add,” IEEE Transactions on Computers, vol. 58, no. 8, pp. 1139–1145, 2009, doi: 10.1109/TC.2008.216.
+//  [2] J. M. Muller, Elementary functions: algorithms and implementation, Third edition. Boston: Birkhäuser, 2016.
+
+#if !defined(_EXP_DD_AVX2_H)
+#define _EXP_DD_AVX2_H 1
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "DD_arithmetic_avx2.h"
+#include "exp_DD.h"
+#include "expxsqr_tables.h"
+
+// 2^e for -1022 <= e <= 1023, built in the exponent field.
+static inline __m256d
+pow2_D4(const __m256i e) {
+    return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(e, _mm256_set1_epi64x(DBL_MAX_EXP - 1)), DBL_MANT_DIG - 1));
+}
+
+// Multiply both parts of x by 2^e1 * 2^e2; see scale_DD() in exp_DD.h.
+static inline DD4
+scale_DD4(const DD4 x, const __m256i e1, const __m256i e2) {
+    __m256d s1 = pow2_D4(e1);
+    __m256d s2 = pow2_D4(e2);
+    return load_D4_D4_DD4(_mm256_mul_pd(_mm256_mul_pd(DD4_HI(x), s1), s2), _mm256_mul_pd(_mm256_mul_pd(DD4_LO(x), s1), s2));
+}
+
+// Calculate k = nearestint(a/C) = m*T + j for 0 <= a < 2^31 * C; returns k as a double.  See reduce_D() in exp_DD.h.  Since k >= 0,
+// k/T and k%T are a shift and a mask, and k is read directly from the low bits of the significand of fma(a, R, CONST).
+static inline __m256d
+reduce_D4(const __m256d a, __m256i* m, __m256i* j) {
+    const __m256d CONST = _mm256_set1_pd(0x1.8p52);               // 3.0 * 2^(DBL_MANT_DIG - 2) = 6755399441055744.
+    const __m256d R = _mm256_set1_pd(EXPXSQR_R);                // 1 / (log(2)/T).
+    __m256d k_shifted = _mm256_fmadd_pd(a, R, CONST);
+    __m256i k = _mm256_sub_epi64(_mm256_castpd_si256(k_shifted), _mm256_castpd_si256(CONST));
+    *m = _mm256_srli_epi64(k, EXPXSQR_TABLE_BITS);
+    *j = _mm256_and_si256(k, _mm256_set1_epi64x(EXPXSQR_TABLE_SIZE - 1));
+    return _mm256_sub_pd(k_shifted, CONST);
+}
+
+// Calculate the reduced argument a - k*C = r_hi + r_lo for k_dbl = reduce_D4(a, ...); see reduced_arg_DD() in exp_DD.h.
+static inline DD4
+reduced_arg_DD4(const __m256d a, const __m256d k_dbl) {
+    const __m256d C1 = _mm256_set1_pd(EXPXSQR_C1);               // 1/R rounded to DBL_MANT_DIG - 2 digits.
+    const __m256d C2 = _mm256_set1_pd(EXPXSQR_C2);               // C - C1.
+    __m256d temp1 = _mm256_fnmadd_pd(k_dbl, C1, a);
+    __m256d r_hi = _mm256_fnmadd_pd(k_dbl, C2, temp1);
+    DD4 temp2 = mul_D4_D4_DD4(k_dbl, C2);
+    DD4 temp3 = fast_add_D4_D4_DD4(temp1, _mm256_xor_pd(DD4_HI(temp2), _mm256_set1_pd(-0.0)));
+    return load_D4_D4_DD4(r_hi, _mm256_sub_pd(_mm256_add_pd(_mm256_sub_pd(DD4_HI(temp3), r_hi), DD4_LO(temp3)), DD4_LO(temp2)));
+}
+
+// Calculate p(r) such that e^r - 1 = r + r^2 * p(r) by Horner's scheme; see poly_D() in exp_DD.h.
+static inline __m256d
+poly_D4(const __m256d r) {
+    const int N = sizeof(expxsqr_coeffs) / sizeof(expxsqr_coeffs[0]);
+    __m256d p = _mm256_set1_pd(expxsqr_coeffs[0]);
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll N
+#endif
+    for (int i = 1; i < N; i++) {
+        p = _mm256_fmadd_pd(r, p, _mm256_set1_pd(expxsqr_coeffs[i]));
+    }
+    return p;
+}
+
+// Gather power_2[j] from expxsqr_power_2 or expmxsqr_power_2 viewed as a double[].
+static inline DD4
+gather_power_2_DD4(const double* power_2, const __m256i j) {
+    __m256i j2 = _mm256_slli_epi64(j, 1);
+    return load_D4_D4_DD4(_mm256_i64gather_pd(power_2, j2, 8), _mm256_i64gather_pd(power_2 + 1, j2, 8));
+}
+
+// Calculate 2^(+-j/T) * e^(+-(r_hi + r_lo + lo)) for r = r_hi + r_lo with a single correction, where power_2 is expxsqr_power_2
+// or expmxsqr_power_2 and sign is +1.0 or -1.0 to match; see reconstruct_accurate_DD() in exp_DD.h.  The gather is issued after the
+// polynomial, as it was in each kernel before this was shared:  gathering first costs about 25% in expxsqr_array_avx2().
+static inline DD4
+reconstruct_accurate_DD4(const DD4 r, const __m256d lo, const double* power_2, const __m256i j, const __m256d sign) {
+    const __m256d s_hi = _mm256_mul_pd(sign, DD4_HI(r));
+    const __m256d s_lo = _mm256_mul_pd(sign, DD4_LO(r));
+
+    // Evaluate e^(+-j/T) * e^(+-r_hi).
+    __m256d temp1 = poly_D4(s_hi);
+    temp1 = _mm256_add_pd(s_hi, _mm256_add_pd(s_lo, _mm256_mul_pd(_mm256_mul_pd(s_hi, s_hi), temp1))); // temp1 = e^+-r_hi - 1.
+    DD4 power_2_j = gather_power_2_DD4(power_2, j);
+    DD4 temp4 = add_DD4_D4_DD4(power_2_j, _mm256_mul_pd(DD4_HI(power_2_j), temp1)); // temp4 = e^(+-j/T) * e^+-r_hi.
+
+    // Evaluate e^+-(r_lo + lo).
+    __m256d temp6 = _mm256_mul_pd(sign, _mm256_add_pd(DD4_LO(r), lo));
+    __m256d temp8 = _mm256_add_pd(temp6, _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(0.5), temp6), temp6));
+    DD4 temp5 = add_D4_D4_DD4(_mm256_set1_pd(1.0), temp8);
+
+    return mul_DD4_DD4_DD4(temp4, temp5);
+}
+
+// Calculate 2^(+-j/T) * e^(+-(r_hi + r_lo + lo)) in double-double for r = r_hi + r_lo, where power_2_j is 2^(+-j/T) and sign is
+// +1.0 or -1.0 in each lane; see reconstruct_DD() in exp_DD.h.
+static inline DD4
+reconstruct_DD4(const DD4 r, const __m256d lo, const DD4 power_2_j, const __m256d sign) {
+    const __m256d s_hi = _mm256_mul_pd(sign, DD4_HI(r));
+    const __m256d s_lo = _mm256_mul_pd(sign, DD4_LO(r));
+
+    // Evaluate e^(+-j/T) * e^(+-r_hi).
+    __m256d temp1 = poly_D4(s_hi);
+    DD4 temp7 = fast_add_D4_D4_DD4(s_hi, _mm256_mul_pd(_mm256_mul_pd(s_hi, s_hi), temp1)); // temp7 = e^+-r_hi - 1.
+    DD4 temp4 = add_DD4_DD4_DD4(power_2_j, mul_DD4_DD4_DD4(power_2_j, temp7)); // temp4 = e^(+-j/T) * e^+-r_hi.
+
+    // Evaluate e^+-(r_lo + lo).
+    __m256d temp6 = _mm256_fmadd_pd(sign, lo, s_lo);
+    __m256d temp8 = _mm256_add_pd(temp6, _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(0.5), temp6), temp6));
+    DD4 temp5 = add_D4_D4_DD4(_mm256_set1_pd(1.0), temp8);
+
+    return mul_DD4_DD4_DD4(temp4, temp5);
+}
+
+// e^x -> DD4, see exp_DD_DD().
+// Always inlined:  out of line, the DD4 argument and result are passed in memory, which doubles the time of expxy_avx2().  GCC's
+// -O2 inlining limits leave it just on the edge, so that small changes to the helpers above can tip it either way.
+static inline __attribute__((always_inline)) DD4
+exp_DD4_DD4(const DD4 x) {
+    // Screen for special values.
+    __m256d is_nan = _mm256_cmp_pd(DD4_HI(x), DD4_HI(x), _CMP_UNORD_Q);
+    __m256d is_inf = _mm256_cmp_pd(DD4_HI(x), _mm256_set1_pd(EXP_DD_MAX), _CMP_GT_OQ);
+    __m256d is_zero = _mm256_cmp_pd(DD4_HI(x), _mm256_set1_pd(EXP_DD_MIN), _CMP_LT_OQ);
+    __m256d is_special = _mm256_or_pd(is_nan, _mm256_or_pd(is_inf, is_zero));
+
+    // a = |x| and sign = +-1.0; the sign of -0.0 is kept.
+    __m256d sign_bit = _mm256_and_pd(DD4_HI(x), _mm256_set1_pd(-0.0));
+    __m256d is_negative = _mm256_castsi256_pd(_mm256_cmpgt_epi64(_mm256_setzero_si256(), _mm256_castpd_si256(DD4_HI(x))));
+    __m256d sign = _mm256_or_pd(_mm256_set1_pd(1.0), sign_bit);
+    DD4 a = load_D4_D4_DD4(_mm256_andnot_pd(is_special, _mm256_xor_pd(DD4_HI(x), sign_bit)),
+                           _mm256_andnot_pd(is_special, _mm256_xor_pd(DD4_LO(x), sign_bit)));
+
+    __m256i m, j;
+    __m256d k_dbl = reduce_D4(DD4_HI(a), &m, &j);
+    DD4 r = reduced_arg_DD4(DD4_HI(a), k_dbl);
+    DD4 power_2_pos = gather_power_2_DD4((const double*)expxsqr_power_2, j);
+    DD4 power_2_neg = gather_power_2_DD4((const double*)expmxsqr_power_2, j);
+    DD4 power_2_j = load_D4_D4_DD4(_mm256_blendv_pd(DD4_HI(power_2_pos), DD4_HI(power_2_neg), is_negative),
+                                   _mm256_blendv_pd(DD4_LO(power_2_pos), DD4_LO(power_2_neg), is_negative));
+    DD4 result = reconstruct_DD4(r, DD4_LO(a), power_2_j, sign);
+
+    // Apply the scale factor 2^(+-m) = 2^(+-m/2) * 2^(+-(m - m/2)).
+    __m256i m1 = _mm256_srli_epi64(m, 1);
+    __m256i m2 = _mm256_sub_epi64(m, m1);
+    __m256i negative = _mm256_castpd_si256(is_negative);
+    m1 = _mm256_sub_epi64(_mm256_xor_si256(m1, negative), negative);
+    m2 = _mm256_sub_epi64(_mm256_xor_si256(m2, negative), negative);
+    result = scale_DD4(result, m1, m2);
+
+    // Patch in the results for the special lanes.
+    __m256d result_hi = _mm256_blendv_pd(DD4_HI(result), _mm256_set1_pd(INFINITY), is_inf);
+    result_hi = _mm256_andnot_pd(is_zero, result_hi);
+    result_hi = _mm256_blendv_pd(result_hi, _mm256_add_pd(DD4_HI(x), DD4_HI(x)), is_nan); // Raise FE_INVALID for a signalling NaN.
+    __m256d result_lo = _mm256_andnot_pd(is_special, DD4_LO(result));
+    return load_D4_D4_DD4(result_hi, result_lo);
+}
+
+#endif // _EXP_DD_AVX2_H
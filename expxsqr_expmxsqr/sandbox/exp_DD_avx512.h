@@ -0,0 +1,194 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+
+// Eight-lane AVX-512F versions of exp_DD.h:  e^x for double-double arguments, evaluated in double-double arithmetic.  Each lane
+// produces the same bits as exp_DD_DD().  reduce_D8(), reduced_arg_DD8(), gather_power_2_DD8() and reconstruct_DD8() are also used
+// directly by callers whose arguments all have the same sign (expxsqr_dd_avx512.c), which saves the second table gather of
+// exp_DD8_DD8(); reduce_D8(), reduced_arg_DD8() and reconstruct_accurate_DD8() are the reduction and reconstruction of the AVX-512
+// expxsqr, pair and Gaussian kernels.
+
+// Requires AVX-512F instructions.
+// Uses #pragma GCC unroll N
+
+// References:
+//  [1] S. Boldo, M. Daumas, and R.-C. Li, “Formally Verified Argument Reduction with a Fused Multiply-Add,” IEEE Transactions on Computers, vol. 58, no. 8, pp. 1139–1145, 2009, doi: 10.1109/TC.2008.216.
+//  [2] J. M. Muller, Elementary functions: algorithms and implementation, Third edition. Boston: Birkhäuser, 2016.
+
+#if !defined(_EXP_DD_AVX512_H)
+#define _EXP_DD_AVX512_H 1
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "DD_arithmetic_avx512.h"
+#include "exp_DD.h"
+#include "expxsqr_tables.h"
+
+// 2^e for -1022 <= e <= 1023, built in the exponent field.
+static inline __m512d
+pow2_D8(const __m512i e) {
+    return _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_add_epi64(e, _mm512_set1_epi64(DBL_MAX_EXP - 1)), DBL_MANT_DIG - 1));
+}
+
+// Multiply both parts of x by 2^e1 * 2^e2; see scale_DD() in exp_DD.h.
+static inline DD8
+scale_DD8(const DD8 x, const __m512i e1, const __m512i e2) {
+    __m512d s1 = pow2_D8(e1);
+    __m512d s2 = pow2_D8(e2);
+    return load_D8_D8_DD8(_mm512_mul_pd(_mm512_mul_pd(DD8_HI(x), s1), s2), _mm512_mul_pd(_mm512_mul_pd(DD8_LO(x), s1), s2));
+}
+
+// Calculate k = nearestint(a/C) = m*T + j for 0 <= a < 2^31 * C; returns k as a double.  See reduce_D() in exp_DD.h.  Since k >= 0,
+// k/T and k%T are a shift and a mask, and k is read directly from the low bits of the significand of fma(a, R, CONST).
+static inline __m512d
+reduce_D8(const __m512d a, __m512i* m, __m512i* j) {
+    const __m512d CONST = _mm512_set1_pd(0x1.8p52);               // 3.0 * 2^(DBL_MANT_DIG - 2) = 6755399441055744.
+    const __m512d R = _mm512_set1_pd(EXPXSQR_R);                // 1 / (log(2)/T).
+    __m512d k_shifted = _mm512_fmadd_pd(a, R, CONST);
+    __m512i k = _mm512_sub_epi64(_mm512_castpd_si512(k_shifted), _mm512_castpd_si512(CONST));
+    *m = _mm512_srli_epi64(k, EXPXSQR_TABLE_BITS);
+    *j = _mm512_and_epi64(k, _mm512_set1_epi64(EXPXSQR_TABLE_SIZE - 1));
+    return _mm512_sub_pd(k_shifted, CONST);
+}
+
+// Calculate the reduced argument a - k*C = r_hi + r_lo for k_dbl = reduce_D8(a, ...); see reduced_arg_DD() in exp_DD.h.
+static inline DD8
+reduced_arg_DD8(const __m512d a, const __m512d k_dbl) {
+    const __m512d C1 = _mm512_set1_pd(EXPXSQR_C1);               // 1/R rounded to DBL_MANT_DIG - 2 digits.
+    const __m512d C2 = _mm512_set1_pd(EXPXSQR_C2);               // C - C1.
+    __m512d temp1 = _mm512_fnmadd_pd(k_dbl, C1, a);
+    __m512d r_hi = _mm512_fnmadd_pd(k_dbl, C2, temp1);
+    DD8 temp2 = mul_D8_D8_DD8(k_dbl, C2);
+    __m512d neg_temp2_hi = _mm512_castsi512_pd(_mm512_xor_epi64(_mm512_castpd_si512(DD8_HI(temp2)), _mm512_set1_epi64(INT64_MIN)));
+    DD8 temp3 = fast_add_D8_D8_DD8(temp1, neg_temp2_hi);
+    return load_D8_D8_DD8(r_hi, _mm512_sub_pd(_mm512_add_pd(_mm512_sub_pd(DD8_HI(temp3), r_hi), DD8_LO(temp3)), DD8_LO(temp2)));
+}
+
+// Calculate p(r) such that e^r - 1 = r + r^2 * p(r) by Horner's scheme; see poly_D() in exp_DD.h.
+static inline __m512d
+poly_D8(const __m512d r) {
+    const int N = sizeof(expxsqr_coeffs) / sizeof(expxsqr_coeffs[0]);
+    __m512d p = _mm512_set1_pd(expxsqr_coeffs[0]);
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll N
+#endif
+    for (int i = 1; i < N; i++) {
+        p = _mm512_fmadd_pd(r, p, _mm512_set1_pd(expxsqr_coeffs[i]));
+    }
+    return p;
+}
+
+// Gather power_2[j] from expxsqr_power_2 or expmxsqr_power_2 viewed as a double[].
+static inline DD8
+gather_power_2_DD8(const double* power_2, const __m512i j) {
+    __m512i j2 = _mm512_slli_epi64(j, 1);
+    return load_D8_D8_DD8(_mm512_i64gather_pd(j2, power_2, 8), _mm512_i64gather_pd(j2, power_2 + 1, 8));
+}
+
+// Calculate 2^(+-j/T) * e^(+-(r_hi + r_lo + lo)) for r = r_hi + r_lo with a single correction, where power_2 is expxsqr_power_2
+// or expmxsqr_power_2 and sign is +1.0 or -1.0 to match; see reconstruct_accurate_DD() in exp_DD.h.  The gather is issued after the
+// polynomial, as it was in each kernel before this was shared:  gathering first costs about 25% in expxsqr_array_avx512().
+static inline DD8
+reconstruct_accurate_DD8(const DD8 r, const __m512d lo, const double* power_2, const __m512i j, const __m512d sign) {
+    const __m512d s_hi = _mm512_mul_pd(sign, DD8_HI(r));
+    const __m512d s_lo = _mm512_mul_pd(sign, DD8_LO(r));
+
+    // Evaluate e^(+-j/T) * e^(+-r_hi).
+    __m512d temp1 = poly_D8(s_hi);
+    temp1 = _mm512_add_pd(s_hi, _mm512_add_pd(s_lo, _mm512_mul_pd(_mm512_mul_pd(s_hi, s_hi), temp1))); // temp1 = e^+-r_hi - 1.
+    DD8 power_2_j = gather_power_2_DD8(power_2, j);
+    DD8 temp4 = add_DD8_D8_DD8(power_2_j, _mm512_mul_pd(DD8_HI(power_2_j), temp1)); // temp4 = e^(+-j/T) * e^+-r_hi.
+
+    // Evaluate e^+-(r_lo + lo).
+    __m512d temp6 = _mm512_mul_pd(sign, _mm512_add_pd(DD8_LO(r), lo));
+    __m512d temp8 = _mm512_add_pd(temp6, _mm512_mul_pd(_mm512_mul_pd(_mm512_set1_pd(0.5), temp6), temp6));
+    DD8 temp5 = add_D8_D8_DD8(_mm512_set1_pd(1.0), temp8);
+
+    return mul_DD8_DD8_DD8(temp4, temp5);
+}
+
+// Calculate 2^(+-j/T) * e^(+-(r_hi + r_lo + lo)) in double-double for r = r_hi + r_lo, where power_2_j is 2^(+-j/T) and sign is
+// +1.0 or -1.0 in each lane; see reconstruct_DD() in exp_DD.h.
+static inline DD8
+reconstruct_DD8(const DD8 r, const __m512d lo, const DD8 power_2_j, const __m512d sign) {
+    const __m512d s_hi = _mm512_mul_pd(sign, DD8_HI(r));
+    const __m512d s_lo = _mm512_mul_pd(sign, DD8_LO(r));
+
+    // Evaluate e^(+-j/T) * e^(+-r_hi).
+    __m512d temp1 = poly_D8(s_hi);
+    DD8 temp7 = fast_add_D8_D8_DD8(s_hi, _mm512_mul_pd(_mm512_mul_pd(s_hi, s_hi), temp1)); // temp7 = e^+-r_hi - 1.
+    DD8 temp4 = add_DD8_DD8_DD8(power_2_j, mul_DD8_DD8_DD8(power_2_j, temp7)); // temp4 = e^(+-j/T) * e^+-r_hi.
+
+    // Evaluate e^+-(r_lo + lo).
+    __m512d temp6 = _mm512_fmadd_pd(sign, lo, s_lo);
+    __m512d temp8 = _mm512_add_pd(temp6, _mm512_mul_pd(_mm512_mul_pd(_mm512_set1_pd(0.5), temp6), temp6));
+    DD8 temp5 = add_D8_D8_DD8(_mm512_set1_pd(1.0), temp8);
+
+    return mul_DD8_DD8_DD8(temp4, temp5);
+}
+
+// e^x -> DD8, see exp_DD_DD().
+// Always inlined, as exp_DD4_DD4() in exp_DD_avx2.h:  out of line, the DD8 argument and result are passed in memory.
+static inline __attribute__((always_inline)) DD8
+exp_DD8_DD8(const DD8 x) {
+    // Screen for special values.
+    __mmask8 is_nan = _mm512_cmp_pd_mask(DD8_HI(x), DD8_HI(x), _CMP_UNORD_Q);
+    __mmask8 is_inf = _mm512_cmp_pd_mask(DD8_HI(x), _mm512_set1_pd(EXP_DD_MAX), _CMP_GT_OQ);
+    __mmask8 is_zero = _mm512_cmp_pd_mask(DD8_HI(x), _mm512_set1_pd(EXP_DD_MIN), _CMP_LT_OQ);
+    __mmask8 is_normal = ~(is_nan | is_inf | is_zero);
+
+    // a = |x| and sign = +-1.0; the sign of -0.0 is kept.
+    __mmask8 is_negative = _mm512_cmplt_epi64_mask(_mm512_castpd_si512(DD8_HI(x)), _mm512_setzero_si512());
+    __m512i sign_bit = _mm512_maskz_mov_epi64(is_negative, _mm512_set1_epi64(INT64_MIN));
+    __m512d sign = _mm512_mask_blend_pd(is_negative, _mm512_set1_pd(1.0), _mm512_set1_pd(-1.0));
+    __m512d abs_hi = _mm512_castsi512_pd(_mm512_xor_epi64(_mm512_castpd_si512(DD8_HI(x)), sign_bit));
+    __m512d abs_lo = _mm512_castsi512_pd(_mm512_xor_epi64(_mm512_castpd_si512(DD8_LO(x)), sign_bit));
+    DD8 a = load_D8_D8_DD8(_mm512_maskz_mov_pd(is_normal, abs_hi), _mm512_maskz_mov_pd(is_normal, abs_lo));
+
+    __m512i m, j;
+    __m512d k_dbl = reduce_D8(DD8_HI(a), &m, &j);
+    DD8 r = reduced_arg_DD8(DD8_HI(a), k_dbl);
+    DD8 power_2_pos = gather_power_2_DD8((const double*)expxsqr_power_2, j);
+    DD8 power_2_neg = gather_power_2_DD8((const double*)expmxsqr_power_2, j);
+    DD8 power_2_j = load_D8_D8_DD8(_mm512_mask_blend_pd(is_negative, DD8_HI(power_2_pos), DD8_HI(power_2_neg)),
+                                   _mm512_mask_blend_pd(is_negative, DD8_LO(power_2_pos), DD8_LO(power_2_neg)));
+    DD8 result = reconstruct_DD8(r, DD8_LO(a), power_2_j, sign);
+
+    // Apply the scale factor 2^(+-m) = 2^(+-m/2) * 2^(+-(m - m/2)).
+    __m512i m1 = _mm512_srli_epi64(m, 1);
+    __m512i m2 = _mm512_sub_epi64(m, m1);
+    m1 = _mm512_mask_sub_epi64(m1, is_negative, _mm512_setzero_si512(), m1);
+    m2 = _mm512_mask_sub_epi64(m2, is_negative, _mm512_setzero_si512(), m2);
+    result = scale_DD8(result, m1, m2);
+
+    // Merge in the results for the special lanes.
+    __m512d result_hi = _mm512_mask_mov_pd(DD8_HI(result), is_inf, _mm512_set1_pd(INFINITY));
+    result_hi = _mm512_mask_mov_pd(result_hi, is_zero, _mm512_setzero_pd());
+    result_hi = _mm512_mask_add_pd(result_hi, is_nan, DD8_HI(x), DD8_HI(x)); // Raise FE_INVALID for a signalling NaN.
+    __m512d result_lo = _mm512_maskz_mov_pd(is_normal, DD8_LO(result));
+    return load_D8_D8_DD8(result_hi, result_lo);
+}
+
+#endif // _EXP_DD_AVX512_H
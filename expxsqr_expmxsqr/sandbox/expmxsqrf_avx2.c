@@ -0,0 +1,133 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Calculate e^(-x*x) in single precision for eight arguments at a time using AVX2 and FMA instructions.
+
+// This is a lane-by-lane transcription of expmxsqrf() in expmxsqrf.c; each lane produces the same bits as the scalar function.  As in
+// expmxsqr_avx2.c, the special lanes are zeroed before the reduction and their results are blended in at the end.  The 16-entry
+// power_2 table is looked up with two in-register permutes and a blend instead of a gather.
+
+// Requires AVX2 and FMA instructions.
+// Uses #pragma GCC unroll N
+
+// References:
+//  [1] S. Boldo, M. Daumas, and R.-C. Li, “Formally Verified Argument Reduction with a Fused Multiply-Add,” IEEE Transactions on Computers, vol. 58, no. 8, pp. 1139–1145, 2009, doi: 10.1109/TC.2008.216.
+//  [2] J. M. Muller, Elementary functions: algorithms and implementation, Third edition. Boston: Birkhäuser, 2016.
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "FF_arithmetic.h"
+#include "FF_arithmetic_avx2.h"
+#include "expxsqr_tables.h"
+
+// Look up table[j] for 0 <= j < 16 in every lane.  Bit 3 of j, shifted into the sign bit, selects the upper half of the table.
+static inline __m256
+lookup16_avx2(const float* table, const __m256i j) {
+    __m256 lower = _mm256_permutevar8x32_ps(_mm256_load_ps(table), j);
+    __m256 upper = _mm256_permutevar8x32_ps(_mm256_load_ps(table + 8), j);
+    return _mm256_blendv_ps(lower, upper, _mm256_castsi256_ps(_mm256_slli_epi32(j, 28)));
+}
+
+__m256
+expmxsqrf_avx2(const __m256 x) {
+
+    // Screen for special values.
+    __m256 is_nan = _mm256_cmp_ps(x, x, _CMP_UNORD_Q);
+    FF8 x_sqr = sqr_F8_FF8(x);
+    // For |x| < 1.72633492e-04 (x^2 < 2.98023224e-08 = 2^-25), expmxsqrf(x) is 1.0
+    __m256 is_one = _mm256_cmp_ps(FF8_HI(x_sqr), _mm256_set1_ps(0x1.000002p-25f), _CMP_LT_OQ);
+    // For |x| > 10.1966696 (x^2 > 103.972070), expmxsqrf(x) is 0.0.  This also handles the case where |x| == INFINITY.
+    __m256 abs_x = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+    __m256 is_zero = _mm256_cmp_ps(abs_x, _mm256_set1_ps(0x1.464b1ep+3f), _CMP_GT_OQ);
+    __m256 is_special = _mm256_or_ps(is_nan, _mm256_or_ps(is_one, is_zero));
+    x_sqr = load_F8_F8_FF8(_mm256_andnot_ps(is_special, FF8_HI(x_sqr)), _mm256_andnot_ps(is_special, FF8_LO(x_sqr)));
+
+    // Calculate the reduced argument:  r = x - k * C where C = log(2)/16 and k = nearestint(x/C).  Thus |r| <= log(2)/32.
+    // See see Ref [2], section 11.2.2, algorithm 23.  Also see Ref [1], algorithms 5.1 and 5.2.
+    // Since x_sqr >= 0, k >= 0 and k/16 and k%16 are a shift and a mask.  k is read directly from the low bits of the significand
+    // of fma(x_sqr, R, CONST).
+    const __m256 CONST = _mm256_set1_ps(0x1.8p23f);             // 3.0 * 2^(FLT_MANT_DIG - 2) = 12582912.
+    const __m256 R = _mm256_set1_ps(0x1.715476p4f);             // 1 / (log(2)/16) = 23.083120346069336.
+    const __m256 C1 = _mm256_set1_ps(0x1.62e43p-5f);            // 1/R rounded to FLT_MANT_DIG - 2 digits.
+    const __m256 C2 = _mm256_set1_ps(-0x1.05c61p-33f);          // C - C1.
+    __m256 k_shifted = _mm256_fmadd_ps(FF8_HI(x_sqr), R, CONST);
+    __m256 k_flt = _mm256_sub_ps(k_shifted, CONST);
+    __m256i k = _mm256_sub_epi32(_mm256_castps_si256(k_shifted), _mm256_castps_si256(CONST));
+    __m256i m = _mm256_srli_epi32(k, 4);
+    __m256i j = _mm256_and_si256(k, _mm256_set1_epi32(15));
+    __m256 temp1 = _mm256_fnmadd_ps(k_flt, C1, FF8_HI(x_sqr));
+    __m256 r_hi = _mm256_fnmadd_ps(k_flt, C2, temp1);
+    FF8 temp2 = mul_F8_F8_FF8(k_flt, C2);
+    FF8 temp3 = fast_add_F8_F8_FF8(temp1, _mm256_xor_ps(FF8_HI(temp2), _mm256_set1_ps(-0.0f)));
+    __m256 r_lo = _mm256_sub_ps(_mm256_add_ps(_mm256_sub_ps(FF8_HI(temp3), r_hi), FF8_LO(temp3)), FF8_LO(temp2));
+    FF8 r = add_F8_F8_FF8(r_hi, _mm256_add_ps(r_lo, FF8_LO(x_sqr)));
+
+    // Evaluate e^(-j/16)*e^-r.
+    const int N = sizeof(expxsqrf_coeffs) / sizeof(expxsqrf_coeffs[0]);
+    __m256 minus_r_hi = _mm256_xor_ps(FF8_HI(r), _mm256_set1_ps(-0.0f));
+    temp1 = _mm256_set1_ps(expxsqrf_coeffs[0]);
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll N
+#endif
+    for (int i = 1; i < N; i++) {
+        temp1 = _mm256_fmadd_ps(minus_r_hi, temp1, _mm256_set1_ps(expxsqrf_coeffs[i]));
+    }
+    __m256 minus_r_lo = _mm256_xor_ps(FF8_LO(r), _mm256_set1_ps(-0.0f));
+    temp1 = _mm256_add_ps(minus_r_hi, _mm256_add_ps(minus_r_lo, _mm256_mul_ps(_mm256_mul_ps(FF8_HI(r), FF8_HI(r)), temp1))); // temp1 = e^-r - 1.
+    __m256 power_2_hi = lookup16_avx2(expmxsqrf_power_2_hi, j);
+    __m256 power_2_lo = lookup16_avx2(expmxsqrf_power_2_lo, j);
+    __m256 temp4 = _mm256_add_ps(power_2_hi, _mm256_fmadd_ps(power_2_hi, temp1, power_2_lo));
+
+    // Apply scale factor of 2^-m carefully so as to properly handle those cases where the result is subnormal.
+    // In the lanes where m >= 126, subtract m - 126 from the exponent field and then multiply by 2^-126; elsewhere subtract m and
+    // multiply by 1.0.  See expmxsqrf() for why this cannot produce a subnormal result before the multiplication.
+    const int scale_expo = -126;
+    __m256i use_scale = _mm256_cmpgt_epi32(m, _mm256_set1_epi32(-scale_expo - 1));
+    __m256i mm = _mm256_add_epi32(m, _mm256_and_si256(use_scale, _mm256_set1_epi32(scale_expo)));
+    __m256 result = _mm256_castsi256_ps(_mm256_sub_epi32(_mm256_castps_si256(temp4), _mm256_slli_epi32(mm, FLT_MANT_DIG - 1)));
+    result = _mm256_mul_ps(result, _mm256_blendv_ps(_mm256_set1_ps(1.0f), _mm256_set1_ps(0x1.0p-126f), _mm256_castsi256_ps(use_scale)));
+
+    // Patch in the results for the special lanes.
+    result = _mm256_blendv_ps(result, _mm256_set1_ps(1.0f), is_one);
+    result = _mm256_blendv_ps(result, _mm256_setzero_ps(), is_zero);
+    result = _mm256_blendv_ps(result, _mm256_add_ps(x, x), is_nan); // Raise FE_INVALID if x is a signalling NaN.
+
+    return result;
+}
+
+// Calculate y[i] = e^(-x[i]*x[i]) for i = 0, 1, ... n-1.  The last n%8 elements are handled with masked loads and stores.
+void
+expmxsqrf_array_avx2(const float* x, float* y, const size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(&y[i], expmxsqrf_avx2(_mm256_loadu_ps(&x[i])));
+    }
+    if (i < n) {
+        __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)(n - i)), _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+        _mm256_maskstore_ps(&y[i], mask, expmxsqrf_avx2(_mm256_maskload_ps(&x[i], mask)));
+    }
+    return;
+}
@@ -0,0 +1,127 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Calculate e^(-x*x) in single precision for sixteen arguments at a time using AVX-512 instructions.
+
+// This is a lane-by-lane transcription of expmxsqrf() in expmxsqrf.c; each lane produces the same bits as the scalar function.  As in
+// expmxsqr_avx512.c, the special lanes are screened with k-masks.  Each half of the 16-entry power_2 table fills one register,
+// so the lookup is a single permute.
+
+// Requires AVX-512F instructions.
+// Uses #pragma GCC unroll N
+
+// References:
+//  [1] S. Boldo, M. Daumas, and R.-C. Li, “Formally Verified Argument Reduction with a Fused Multiply-Add,” IEEE Transactions on Computers, vol. 58, no. 8, pp. 1139–1145, 2009, doi: 10.1109/TC.2008.216.
+//  [2] J. M. Muller, Elementary functions: algorithms and implementation, Third edition. Boston: Birkhäuser, 2016.
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "FF_arithmetic.h"
+#include "FF_arithmetic_avx512.h"
+#include "expxsqr_tables.h"
+
+__m512
+expmxsqrf_avx512(const __m512 x) {
+
+    // Screen for special values.
+    __mmask16 is_nan = _mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q);
+    FF16 x_sqr = sqr_F16_FF16(x);
+    // For |x| < 1.72633492e-04 (x^2 < 2.98023224e-08 = 2^-25), expmxsqrf(x) is 1.0
+    __mmask16 is_one = _mm512_cmp_ps_mask(FF16_HI(x_sqr), _mm512_set1_ps(0x1.000002p-25f), _CMP_LT_OQ);
+    // For |x| > 10.1966696 (x^2 > 103.972070), expmxsqrf(x) is 0.0.  This also handles the case where |x| == INFINITY.
+    __m512 abs_x = _mm512_castsi512_ps(_mm512_and_epi32(_mm512_castps_si512(x), _mm512_set1_epi32(INT32_MAX)));
+    __mmask16 is_zero = _mm512_cmp_ps_mask(abs_x, _mm512_set1_ps(0x1.464b1ep+3f), _CMP_GT_OQ);
+    __mmask16 is_normal = (__mmask16)~(is_nan | is_one | is_zero);
+    x_sqr = load_F16_F16_FF16(_mm512_maskz_mov_ps(is_normal, FF16_HI(x_sqr)), _mm512_maskz_mov_ps(is_normal, FF16_LO(x_sqr)));
+
+    // Calculate the reduced argument:  r = x - k * C where C = log(2)/16 and k = nearestint(x/C).  Thus |r| <= log(2)/32.
+    // See see Ref [2], section 11.2.2, algorithm 23.  Also see Ref [1], algorithms 5.1 and 5.2.
+    // Since x_sqr >= 0, k >= 0 and k/16 and k%16 are a shift and a mask.  k is read directly from the low bits of the significand
+    // of fma(x_sqr, R, CONST).
+    const __m512 CONST = _mm512_set1_ps(0x1.8p23f);             // 3.0 * 2^(FLT_MANT_DIG - 2) = 12582912.
+    const __m512 R = _mm512_set1_ps(0x1.715476p4f);             // 1 / (log(2)/16) = 23.083120346069336.
+    const __m512 C1 = _mm512_set1_ps(0x1.62e43p-5f);            // 1/R rounded to FLT_MANT_DIG - 2 digits.
+    const __m512 C2 = _mm512_set1_ps(-0x1.05c61p-33f);          // C - C1.
+    __m512 k_shifted = _mm512_fmadd_ps(FF16_HI(x_sqr), R, CONST);
+    __m512 k_flt = _mm512_sub_ps(k_shifted, CONST);
+    __m512i k = _mm512_sub_epi32(_mm512_castps_si512(k_shifted), _mm512_castps_si512(CONST));
+    __m512i m = _mm512_srli_epi32(k, 4);
+    __m512i j = _mm512_and_epi32(k, _mm512_set1_epi32(15));
+    __m512 temp1 = _mm512_fnmadd_ps(k_flt, C1, FF16_HI(x_sqr));
+    __m512 r_hi = _mm512_fnmadd_ps(k_flt, C2, temp1);
+    FF16 temp2 = mul_F16_F16_FF16(k_flt, C2);
+    __m512 minus_temp2_hi = _mm512_castsi512_ps(_mm512_xor_epi32(_mm512_castps_si512(FF16_HI(temp2)), _mm512_set1_epi32(INT32_MIN)));
+    FF16 temp3 = fast_add_F16_F16_FF16(temp1, minus_temp2_hi);
+    __m512 r_lo = _mm512_sub_ps(_mm512_add_ps(_mm512_sub_ps(FF16_HI(temp3), r_hi), FF16_LO(temp3)), FF16_LO(temp2));
+    FF16 r = add_F16_F16_FF16(r_hi, _mm512_add_ps(r_lo, FF16_LO(x_sqr)));
+
+    // Evaluate e^(-j/16)*e^-r.
+    const int N = sizeof(expxsqrf_coeffs) / sizeof(expxsqrf_coeffs[0]);
+    const __m512i SIGN = _mm512_set1_epi32(INT32_MIN);
+    __m512 minus_r_hi = _mm512_castsi512_ps(_mm512_xor_epi32(_mm512_castps_si512(FF16_HI(r)), SIGN));
+    temp1 = _mm512_set1_ps(expxsqrf_coeffs[0]);
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll N
+#endif
+    for (int i = 1; i < N; i++) {
+        temp1 = _mm512_fmadd_ps(minus_r_hi, temp1, _mm512_set1_ps(expxsqrf_coeffs[i]));
+    }
+    __m512 minus_r_lo = _mm512_castsi512_ps(_mm512_xor_epi32(_mm512_castps_si512(FF16_LO(r)), SIGN));
+    temp1 = _mm512_add_ps(minus_r_hi, _mm512_add_ps(minus_r_lo, _mm512_mul_ps(_mm512_mul_ps(FF16_HI(r), FF16_HI(r)), temp1))); // temp1 = e^-r - 1.
+    __m512 power_2_hi = _mm512_permutexvar_ps(j, _mm512_load_ps(expmxsqrf_power_2_hi));
+    __m512 power_2_lo = _mm512_permutexvar_ps(j, _mm512_load_ps(expmxsqrf_power_2_lo));
+    __m512 temp4 = _mm512_add_ps(power_2_hi, _mm512_fmadd_ps(power_2_hi, temp1, power_2_lo));
+
+    // Apply scale factor of 2^-m carefully so as to properly handle those cases where the result is subnormal.
+    // In the lanes where m >= 126, subtract m - 126 from the exponent field and then multiply by 2^-126.  See expmxsqrf() for why
+    // this cannot produce a subnormal result before the multiplication.
+    const int scale_expo = -126;
+    __mmask16 use_scale = _mm512_cmpgt_epi32_mask(m, _mm512_set1_epi32(-scale_expo - 1));
+    __m512i mm = _mm512_mask_add_epi32(m, use_scale, m, _mm512_set1_epi32(scale_expo));
+    __m512 result = _mm512_castsi512_ps(_mm512_sub_epi32(_mm512_castps_si512(temp4), _mm512_slli_epi32(mm, FLT_MANT_DIG - 1)));
+    result = _mm512_mask_mul_ps(result, use_scale, result, _mm512_set1_ps(0x1.0p-126f));
+
+    // Merge in the results for the special lanes.
+    result = _mm512_mask_mov_ps(result, is_one, _mm512_set1_ps(1.0f));
+    result = _mm512_mask_mov_ps(result, is_zero, _mm512_setzero_ps());
+    result = _mm512_mask_add_ps(result, is_nan, x, x); // Raise FE_INVALID if x is a signalling NaN.
+
+    return result;
+}
+
+// Calculate y[i] = e^(-x[i]*x[i]) for i = 0, 1, ... n-1.  The last n%16 elements are handled with masked loads and stores.
+void
+expmxsqrf_array_avx512(const float* x, float* y, const size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_ps(&y[i], expmxsqrf_avx512(_mm512_loadu_ps(&x[i])));
+    }
+    if (i < n) {
+        __mmask16 mask = (__mmask16)((1U << (n - i)) - 1U);
+        _mm512_mask_storeu_ps(&y[i], mask, expmxsqrf_avx512(_mm512_maskz_loadu_ps(mask, &x[i])));
+    }
+    return;
+}
@@ -0,0 +1,135 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Declarations of the e^(x*x) and e^(-x*x) entry points.
+
+#if !defined(_EXPXSQR_H)
+#define _EXPXSQR_H 1
+
+#include <stddef.h>
+
+#include "DD_arithmetic.h"
+
+// Accuracy tiers of the scalar versions, selected at compile time with -DEXPXSQR_TIER=... when building expxsqr.c and expmxsqr.c.
+// Each tier's error bound is checked by its test_accuracy.c build (MAX_ERR_ULP in the Makefile, run by test1).
+#define EXPXSQR_TIER_ACCURATE          0 // Double-double reduction and reconstruction; faithfully rounded (measured max
+                                         // ~0.74 ulp).
+#define EXPXSQR_TIER_FAST              1 // Single-double reduced argument, degree-5 polynomial, no DD corrections; max error
+                                         // < 4 ulp (measured max ~2.65 ulp).
+#define EXPXSQR_TIER_CORRECTLY_ROUNDED 2 // Double-double reconstruction with a rounding test; the rare cases that fail it are
+                                         // passed to expxsqr_td().  Correctly rounded (see expxsqr_td.c).
+
+// Evaluation schemes of the polynomial of the scalar versions, selected at compile time with -DEXPXSQR_POLY=... when building
+// expxsqr.c and expmxsqr.c (any tier).  Both evaluate the same coefficients; only the critical path and the rounding of the
+// polynomial differ, so the results may differ in the last bit.  See bench_poly_schedule.
+#define EXPXSQR_POLY_HORNER 0 // Horner's scheme, N - 1 dependent FMAs (the default).
+#define EXPXSQR_POLY_ESTRIN 1 // Estrin's scheme (estrin_D_D in DD_arithmetic.h), ceil(log2(N)) dependent operations.
+
+// Scalar versions (expxsqr.c, expmxsqr.c).
+double expxsqr(const double x);
+double expmxsqr(const double x);
+
+// Fast-tier scalar versions (expxsqr.c and expmxsqr.c built with -DEXPXSQR_TIER=EXPXSQR_TIER_FAST).
+double expxsqr_fast(const double x);
+double expmxsqr_fast(const double x);
+
+// Correctly rounded scalar versions (expxsqr.c and expmxsqr.c built with -DEXPXSQR_TIER=EXPXSQR_TIER_CORRECTLY_ROUNDED).
+double expxsqr_cr(const double x);
+double expmxsqr_cr(const double x);
+
+// Correctly rounded e^(sign * x_sqr) for sign = +1.0 or -1.0, evaluated in triple-double (expxsqr_td.c):  the fallback of
+// expxsqr_cr() and expmxsqr_cr().  expxsqr_cr_escalations() returns the number of calls so far, for all threads.
+double expxsqr_td(const DD x_sqr, const double sign);
+unsigned long long expxsqr_cr_escalations(void);
+
+// Estrin-scheme scalar versions (expxsqr.c and expmxsqr.c built with -DEXPXSQR_POLY=EXPXSQR_POLY_ESTRIN), in the default and the
+// fast tier.
+double expxsqr_estrin(const double x);
+double expmxsqr_estrin(const double x);
+double expxsqr_fast_estrin(const double x);
+double expmxsqr_fast_estrin(const double x);
+
+// *pos = e^(x*x) and *neg = e^(-x*x) from one argument reduction (expxsqr_pair.c).
+void expxsqr_pair(const double x, double* pos, double* neg);
+
+// y[i] = e^(x[i]*x[i]) and y[i] = e^(-x[i]*x[i]) for i = 0, 1, ... n-1 (expxsqr_array.c).
+void expxsqr_array(const double* x, double* y, const size_t n);
+void expmxsqr_array(const double* x, double* y, const size_t n);
+void expxsqr_pair_array(const double* x, double* pos, double* neg, const size_t n);
+
+// Double-double versions (expxsqr_dd.c and expxsqr_array.c):  the result is hi + lo with a relative error of about 2^-63 (see
+// expxsqr_dd.c for the loss of precision as e^(-x*x) approaches the subnormal range).
+DD expxsqr_dd(const double x);
+DD expmxsqr_dd(const double x);
+void expxsqr_dd_array(const double* x, double* hi, double* lo, const size_t n);
+void expmxsqr_dd_array(const double* x, double* hi, double* lo, const size_t n);
+
+// Single-precision versions, faithfully rounded (expxsqrf.c, expmxsqrf.c and expxsqr_array.c).
+float expxsqrf(const float x);
+float expmxsqrf(const float x);
+void expxsqrf_array(const float* x, float* y, const size_t n);
+void expmxsqrf_array(const float* x, float* y, const size_t n);
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+
+// Four-lane AVX2/FMA versions (expxsqr_avx2.c, expmxsqr_avx2.c).
+__m256d expxsqr_avx2(const __m256d x);
+__m256d expmxsqr_avx2(const __m256d x);
+void expxsqr_array_avx2(const double* x, double* y, const size_t n);
+void expmxsqr_array_avx2(const double* x, double* y, const size_t n);
+void expxsqr_pair_avx2(const __m256d x, __m256d* pos, __m256d* neg);
+void expxsqr_pair_array_avx2(const double* x, double* pos, double* neg, const size_t n);
+void expxsqr_dd_avx2(const __m256d x, __m256d* hi, __m256d* lo);
+void expmxsqr_dd_avx2(const __m256d x, __m256d* hi, __m256d* lo);
+void expxsqr_dd_array_avx2(const double* x, double* hi, double* lo, const size_t n);
+void expmxsqr_dd_array_avx2(const double* x, double* hi, double* lo, const size_t n);
+
+// Eight-lane single-precision versions (expxsqrf_avx2.c, expmxsqrf_avx2.c).
+__m256 expxsqrf_avx2(const __m256 x);
+__m256 expmxsqrf_avx2(const __m256 x);
+void expxsqrf_array_avx2(const float* x, float* y, const size_t n);
+void expmxsqrf_array_avx2(const float* x, float* y, const size_t n);
+#endif
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+// Eight-lane AVX-512 versions (expxsqr_avx512.c, expmxsqr_avx512.c).
+__m512d expxsqr_avx512(const __m512d x);
+__m512d expmxsqr_avx512(const __m512d x);
+void expxsqr_array_avx512(const double* x, double* y, const size_t n);
+void expmxsqr_array_avx512(const double* x, double* y, const size_t n);
+void expxsqr_pair_avx512(const __m512d x, __m512d* pos, __m512d* neg);
+void expxsqr_pair_array_avx512(const double* x, double* pos, double* neg, const size_t n);
+void expxsqr_dd_avx512(const __m512d x, __m512d* hi, __m512d* lo);
+void expmxsqr_dd_avx512(const __m512d x, __m512d* hi, __m512d* lo);
+void expxsqr_dd_array_avx512(const double* x, double* hi, double* lo, const size_t n);
+void expmxsqr_dd_array_avx512(const double* x, double* hi, double* lo, const size_t n);
+
+// Sixteen-lane single-precision versions (expxsqrf_avx512.c, expmxsqrf_avx512.c).
+__m512 expxsqrf_avx512(const __m512 x);
+__m512 expmxsqrf_avx512(const __m512 x);
+void expxsqrf_array_avx512(const float* x, float* y, const size_t n);
+void expmxsqrf_array_avx512(const float* x, float* y, const size_t n);
+#endif
+
+#endif // _EXPXSQR_H
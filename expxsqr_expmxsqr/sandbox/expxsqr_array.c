@@ -0,0 +1,177 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Array entry points for e^(x*x), e^(-x*x), the pair of both, the double-double versions, the scaled Gaussian, e^(x*y), e^(-x*y)
+// and the single-precision versions.
+
+// The kernel is chosen when this file is compiled:  the AVX-512 version if the compiler targets AVX-512F, the AVX2/FMA version if it
+// targets AVX2 and FMA, otherwise a loop over the scalar function.  (The sandbox Makefile compiles this file with $(ARRAY_ISA).)
+
+#include <stddef.h>
+
+#include "expxsqr.h"
+#include "expxy.h"
+#include "gaussian.h"
+
+void
+expxsqr_array(const double* x, double* y, const size_t n) {
+#if defined(__AVX512F__)
+    expxsqr_array_avx512(x, y, n);
+#elif defined(__AVX2__) && defined(__FMA__)
+    expxsqr_array_avx2(x, y, n);
+#else
+    for (size_t i = 0; i < n; i++) {
+        y[i] = expxsqr(x[i]);
+    }
+#endif
+    return;
+}
+
+void
+expmxsqr_array(const double* x, double* y, const size_t n) {
+#if defined(__AVX512F__)
+    expmxsqr_array_avx512(x, y, n);
+#elif defined(__AVX2__) && defined(__FMA__)
+    expmxsqr_array_avx2(x, y, n);
+#else
+    for (size_t i = 0; i < n; i++) {
+        y[i] = expmxsqr(x[i]);
+    }
+#endif
+    return;
+}
+
+void
+expxsqr_pair_array(const double* x, double* pos, double* neg, const size_t n) {
+#if defined(__AVX512F__)
+    expxsqr_pair_array_avx512(x, pos, neg, n);
+#elif defined(__AVX2__) && defined(__FMA__)
+    expxsqr_pair_array_avx2(x, pos, neg, n);
+#else
+    for (size_t i = 0; i < n; i++) {
+        expxsqr_pair(x[i], &pos[i], &neg[i]);
+    }
+#endif
+    return;
+}
+
+void
+expxsqr_dd_array(const double* x, double* hi, double* lo, const size_t n) {
+#if defined(__AVX512F__)
+    expxsqr_dd_array_avx512(x, hi, lo, n);
+#elif defined(__AVX2__) && defined(__FMA__)
+    expxsqr_dd_array_avx2(x, hi, lo, n);
+#else
+    for (size_t i = 0; i < n; i++) {
+        DD y = expxsqr_dd(x[i]);
+        hi[i] = DD_HI(y);
+        lo[i] = DD_LO(y);
+    }
+#endif
+    return;
+}
+
+void
+expmxsqr_dd_array(const double* x, double* hi, double* lo, const size_t n) {
+#if defined(__AVX512F__)
+    expmxsqr_dd_array_avx512(x, hi, lo, n);
+#elif defined(__AVX2__) && defined(__FMA__)
+    expmxsqr_dd_array_avx2(x, hi, lo, n);
+#else
+    for (size_t i = 0; i < n; i++) {
+        DD y = expmxsqr_dd(x[i]);
+        hi[i] = DD_HI(y);
+        lo[i] = DD_LO(y);
+    }
+#endif
+    return;
+}
+
+void
+expxsqrf_array(const float* x, float* y, const size_t n) {
+#if defined(__AVX512F__)
+    expxsqrf_array_avx512(x, y, n);
+#elif defined(__AVX2__) && defined(__FMA__)
+    expxsqrf_array_avx2(x, y, n);
+#else
+    for (size_t i = 0; i < n; i++) {
+        y[i] = expxsqrf(x[i]);
+    }
+#endif
+    return;
+}
+
+void
+expmxsqrf_array(const float* x, float* y, const size_t n) {
+#if defined(__AVX512F__)
+    expmxsqrf_array_avx512(x, y, n);
+#elif defined(__AVX2__) && defined(__FMA__)
+    expmxsqrf_array_avx2(x, y, n);
+#else
+    for (size_t i = 0; i < n; i++) {
+        y[i] = expmxsqrf(x[i]);
+    }
+#endif
+    return;
+}
+
+void
+gaussian_array(const double* x, double* y, const size_t n, const double A, const double mu, const double sigma) {
+#if defined(__AVX512F__)
+    gaussian_array_avx512(x, y, n, A, mu, sigma);
+#elif defined(__AVX2__) && defined(__FMA__)
+    gaussian_array_avx2(x, y, n, A, mu, sigma);
+#else
+    const gaussian_params params = gaussian_setup(A, mu, sigma);
+    for (size_t i = 0; i < n; i++) {
+        y[i] = gaussian_kernel(x[i], &params);
+    }
+#endif
+    return;
+}
+
+void
+expxy_array(const double* x, const double* y, double* z, const size_t n) {
+#if defined(__AVX512F__)
+    expxy_array_avx512(x, y, z, n);
+#elif defined(__AVX2__) && defined(__FMA__)
+    expxy_array_avx2(x, y, z, n);
+#else
+    for (size_t i = 0; i < n; i++) {
+        z[i] = expxy(x[i], y[i]);
+    }
+#endif
+    return;
+}
+
+void
+expmxy_array(const double* x, const double* y, double* z, const size_t n) {
+#if defined(__AVX512F__)
+    expmxy_array_avx512(x, y, z, n);
+#elif defined(__AVX2__) && defined(__FMA__)
+    expmxy_array_avx2(x, y, z, n);
+#else
+    for (size_t i = 0; i < n; i++) {
+        z[i] = expmxy(x[i], y[i]);
+    }
+#endif
+    return;
+}
@@ -0,0 +1,93 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Calculate e^(x*x) for eight arguments at a time using AVX-512 instructions.
+
+// This is a lane-by-lane transcription of expxsqr() in expxsqr.c; each lane produces the same bits as the scalar function.  The special
+// value screens of the scalar version become k-masks:  the screened lanes are zeroed before the reduction and their results are
+// merged in at the end with masked moves, so a vector of mixed arguments needs no scalar fallback.
+
+// Requires AVX-512F instructions.
+// Uses #pragma GCC unroll N
+
+// References:
+//  [1] S. Boldo, M. Daumas, and R.-C. Li, “Formally Verified Argument Reduction with a Fused Multiply-Add,” IEEE Transactions on Computers, vol. 58, no. 8, pp. 1139–1145, 2009, doi: 10.1109/TC.2008.216.
+//  [2] J. M. Muller, Elementary functions: algorithms and implementation, Third edition. Boston: Birkhäuser, 2016.
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "DD_arithmetic.h"
+#include "DD_arithmetic_avx512.h"
+#include "exp_DD_avx512.h"
+#include "expxsqr_tables.h"
+
+__m512d
+expxsqr_avx512(const __m512d x) {
+
+    // Screen for special values.
+    __mmask8 is_nan = _mm512_cmp_pd_mask(x, x, _CMP_UNORD_Q);
+    DD8 x_sqr = sqr_D8_DD8(x);
+    // For |x| < 1.0536712127723509e-08 (x^2 < 1.1102230246251568e-16), expxsqr(x) is 1.0
+    __mmask8 is_one = _mm512_cmp_pd_mask(DD8_HI(x_sqr), _mm512_set1_pd(0x1.0000000000001p-53), _CMP_LT_OQ);
+    // For |x| > 26.641747557046326 (X^2 > 709.78271289338386), expxsqr(x) is Inf.
+    __mmask8 is_inf = _mm512_cmp_pd_mask(DD8_HI(x_sqr), _mm512_set1_pd(0x1.62e42fefa39eep+9), _CMP_GT_OQ);
+    __mmask8 is_normal = ~(is_nan | is_one | is_inf);
+    x_sqr = load_D8_D8_DD8(_mm512_maskz_mov_pd(is_normal, DD8_HI(x_sqr)), _mm512_maskz_mov_pd(is_normal, DD8_LO(x_sqr)));
+
+    // Calculate the reduced argument:  x_sqr = k*C + r_hi + r_lo + DD_LO(x_sqr) where C = log(2)/T and k = nearestint(x_sqr/C) =
+    // m*T + j.  Thus |r_hi| <= log(2)/(2T).  See reduce_D8() and reduced_arg_DD8() in exp_DD_avx512.h.
+    __m512i m, j;
+    __m512d k_dbl = reduce_D8(DD8_HI(x_sqr), &m, &j);
+    DD8 r = reduced_arg_DD8(DD8_HI(x_sqr), k_dbl);
+
+    // Combine to make e^(j/T)*e^(r + DD_LO(x_sqr)) = 2^-m * e^x_sqr; see reconstruct_accurate_DD8() in exp_DD_avx512.h.  Only the
+    // high part of temp4 is used.
+    DD8 temp4 = reconstruct_accurate_DD8(r, DD8_LO(x_sqr), (const double*)expxsqr_power_2, j, _mm512_set1_pd(1.0));
+
+    // Apply the scale factor 2^m by adding m to the exponent field.
+    __m512d result = _mm512_castsi512_pd(_mm512_add_epi64(_mm512_castpd_si512(DD8_HI(temp4)), _mm512_slli_epi64(m, DBL_MANT_DIG - 1)));
+
+    // Merge in the results for the special lanes.
+    result = _mm512_mask_mov_pd(result, is_one, _mm512_set1_pd(1.0));
+    result = _mm512_mask_mov_pd(result, is_inf, _mm512_set1_pd(INFINITY));
+    result = _mm512_mask_add_pd(result, is_nan, x, x); // Raise FE_INVALID if x is a signalling NaN.
+
+    return result;
+}
+
+// Calculate y[i] = e^(x[i]*x[i]) for i = 0, 1, ... n-1.  The last n%8 elements are handled with masked loads and stores.
+void
+expxsqr_array_avx512(const double* x, double* y, const size_t n) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm512_storeu_pd(&y[i], expxsqr_avx512(_mm512_loadu_pd(&x[i])));
+    }
+    if (i < n) {
+        __mmask8 mask = (__mmask8)((1U << (n - i)) - 1U);
+        _mm512_mask_storeu_pd(&y[i], mask, expxsqr_avx512(_mm512_maskz_loadu_pd(mask, &x[i])));
+    }
+    return;
+}
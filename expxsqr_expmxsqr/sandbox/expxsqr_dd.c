@@ -0,0 +1,67 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Calculate e^(x*x) and e^(-x*x) as unevaluated double-double sums hi + lo.
+
+// These follow expxsqr() and expmxsqr() up to the reconstruction, which is carried out entirely in double-double arithmetic by
+// exp_DD_DD() (exp_DD.h) and scaled by 2^m (2^-m) as a pair, so that the low part is not dropped.  The relative error of hi + lo is
+// bounded by the error of the minimax polynomial for e^r - 1 (~9.1e-20 with the default tables), i.e. about 2^-63:  some ten bits
+// more than a double.  Where e^(-x*x) is below 2^-969, the low part is scaled into the subnormal range and the extra precision is
+// progressively lost; where the result itself is subnormal, hi + lo is no more accurate than expmxsqr().
+// For tiny |x| the result is 1 + x^2 (1 - x^2) rather than 1.0.  The low part is 0.0 for infinite, zero and NaN results.
+
+// Requires FMA instruction.
+
+#include <math.h>
+
+#include "DD_arithmetic.h"
+#include "exp_DD.h"
+#include "expxsqr.h"
+
+DD
+expxsqr_dd(const double x) {
+
+    // Screen for special values
+    if (isnan(x)) return load_D_D_DD(x + x, 0.0); // Raise FE_INVALID if x is a signalling NaN.
+    DD x_sqr = sqr_D_DD(x);
+    // For x^2 < 2^-53, e^(x*x) = 1 + x^2 to within x^4/2 < 2^-107.
+    if (DD_HI(x_sqr) < 0x1.0000000000001p-53) return load_D_D_DD(1.0, DD_HI(x_sqr));
+    // For |x| > 26.641747557046326 (X^2 > 709.78271289338386), expxsqr(x) is Inf.
+    if (DD_HI(x_sqr) > 0x1.62e42fefa39eep+9) return load_D_D_DD(INFINITY, 0.0);
+
+    // Since values of |x| for which expxsqr(x) overflows have been screened out, the result is finite.
+    return exp_DD_DD(x_sqr);
+}
+
+DD
+expmxsqr_dd(const double x) {
+
+    // Screen for special values
+    if (isnan(x)) return load_D_D_DD(x + x, 0.0); // Raise FE_INVALID if x is a signalling NaN.
+    DD x_sqr = sqr_D_DD(x);
+    // For x^2 < 2^-54, e^(-x*x) = 1 - x^2 to within x^4/2 < 2^-109.
+    if (DD_HI(x_sqr) < 0x1.0000000000002p-54) return load_D_D_DD(1.0, -DD_HI(x_sqr));
+    // For |x| > 27.297128403953796 (x^2 > 745.13321910194111), expmxsqr(x) is 0.0.  This also handles the case where |x| == INFINITY.
+    if (DD_HI(x_sqr) > 0x1.74910d52d3051p+9) return load_D_D_DD(0.0, 0.0);
+
+    // Both parts of the result are rounded to the subnormal range if they fall in it.
+    return exp_DD_DD(negate_DD_DD(x_sqr));
+}
@@ -0,0 +1,154 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Calculate e^(x*x) and e^(-x*x) as double-double sums hi + lo for four arguments at a time, using AVX2 and FMA instructions.
+
+// This is a lane-by-lane transcription of expxsqr_dd() and expmxsqr_dd() in expxsqr_dd.c; each lane produces the same bits as the
+// scalar functions.  The reduction and reconstruction are those of exp_DD4_DD4() in exp_DD_avx2.h.  See expxsqr_avx2.c for the
+// handling of the special lanes.
+
+// Requires AVX2 and FMA instructions.
+
+// References:
+//  [1] S. Boldo, M. Daumas, and R.-C. Li, “Formally Verified Argument Reduction with a Fused Multiply-Add,” IEEE Transactions on Computers, vol. 58, no. 8, pp. 1139–1145, 2009, doi: 10.1109/TC.2008.216.
+//  [2] J. M. Muller, Elementary functions: algorithms and implementation, Third edition. Boston: Birkhäuser, 2016.
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "DD_arithmetic.h"
+#include "DD_arithmetic_avx2.h"
+#include "exp_DD_avx2.h"
+#include "expxsqr_tables.h"
+
+void
+expxsqr_dd_avx2(const __m256d x, __m256d* hi, __m256d* lo) {
+
+    // Screen for special values.
+    __m256d is_nan = _mm256_cmp_pd(x, x, _CMP_UNORD_Q);
+    DD4 x_sqr = sqr_D4_DD4(x);
+    __m256d x_sqr_hi = DD4_HI(x_sqr);
+    // For x^2 < 2^-53, e^(x*x) = 1 + x^2 to within x^4/2 < 2^-107.
+    __m256d is_one = _mm256_cmp_pd(x_sqr_hi, _mm256_set1_pd(0x1.0000000000001p-53), _CMP_LT_OQ);
+    // For |x| > 26.641747557046326 (X^2 > 709.78271289338386), expxsqr(x) is Inf.
+    __m256d is_inf = _mm256_cmp_pd(x_sqr_hi, _mm256_set1_pd(0x1.62e42fefa39eep+9), _CMP_GT_OQ);
+    __m256d is_special = _mm256_or_pd(is_nan, _mm256_or_pd(is_one, is_inf));
+    x_sqr = load_D4_D4_DD4(_mm256_andnot_pd(is_special, DD4_HI(x_sqr)), _mm256_andnot_pd(is_special, DD4_LO(x_sqr)));
+
+    // Apply the scale factor 2^m = 2^(m/2) * 2^(m - m/2); 0 <= m <= 1024.
+    __m256i m, j;
+    __m256d k_dbl = reduce_D4(DD4_HI(x_sqr), &m, &j);
+    DD4 r = reduced_arg_DD4(DD4_HI(x_sqr), k_dbl);
+    DD4 power_2_j = gather_power_2_DD4((const double*)expxsqr_power_2, j);
+    DD4 result = reconstruct_DD4(r, DD4_LO(x_sqr), power_2_j, _mm256_set1_pd(1.0));
+    __m256i m1 = _mm256_srli_epi64(m, 1);
+    result = scale_DD4(result, m1, _mm256_sub_epi64(m, m1));
+
+    // Patch in the results for the special lanes.
+    __m256d result_hi = _mm256_blendv_pd(DD4_HI(result), _mm256_set1_pd(1.0), is_one);
+    result_hi = _mm256_blendv_pd(result_hi, _mm256_set1_pd(INFINITY), is_inf);
+    result_hi = _mm256_blendv_pd(result_hi, _mm256_add_pd(x, x), is_nan); // Raise FE_INVALID if x is a signalling NaN.
+    __m256d result_lo = _mm256_blendv_pd(DD4_LO(result), x_sqr_hi, is_one);
+    result_lo = _mm256_andnot_pd(_mm256_or_pd(is_nan, is_inf), result_lo);
+
+    *hi = result_hi;
+    *lo = result_lo;
+    return;
+}
+
+void
+expmxsqr_dd_avx2(const __m256d x, __m256d* hi, __m256d* lo) {
+
+    // Screen for special values.
+    __m256d is_nan = _mm256_cmp_pd(x, x, _CMP_UNORD_Q);
+    DD4 x_sqr = sqr_D4_DD4(x);
+    __m256d x_sqr_hi = DD4_HI(x_sqr);
+    // For x^2 < 2^-54, e^(-x*x) = 1 - x^2 to within x^4/2 < 2^-109.
+    __m256d is_one = _mm256_cmp_pd(x_sqr_hi, _mm256_set1_pd(0x1.0000000000002p-54), _CMP_LT_OQ);
+    // For |x| > 27.297128403953796 (x^2 > 745.13321910194111), expmxsqr(x) is 0.0.  This also handles the case where |x| == INFINITY.
+    __m256d is_zero = _mm256_cmp_pd(x_sqr_hi, _mm256_set1_pd(0x1.74910d52d3051p+9), _CMP_GT_OQ);
+    __m256d is_special = _mm256_or_pd(is_nan, _mm256_or_pd(is_one, is_zero));
+    x_sqr = load_D4_D4_DD4(_mm256_andnot_pd(is_special, DD4_HI(x_sqr)), _mm256_andnot_pd(is_special, DD4_LO(x_sqr)));
+
+    // Apply the scale factor 2^-m = 2^-(m/2) * 2^-(m - m/2); 0 <= m <= 1075.
+    __m256i m, j;
+    __m256d k_dbl = reduce_D4(DD4_HI(x_sqr), &m, &j);
+    DD4 r = reduced_arg_DD4(DD4_HI(x_sqr), k_dbl);
+    DD4 power_2_j = gather_power_2_DD4((const double*)expmxsqr_power_2, j);
+    DD4 result = reconstruct_DD4(r, DD4_LO(x_sqr), power_2_j, _mm256_set1_pd(-1.0));
+    __m256i m1 = _mm256_srli_epi64(m, 1);
+    result = scale_DD4(result, _mm256_sub_epi64(_mm256_setzero_si256(), m1), _mm256_sub_epi64(m1, m));
+
+    // Patch in the results for the special lanes.
+    __m256d result_hi = _mm256_blendv_pd(DD4_HI(result), _mm256_set1_pd(1.0), is_one);
+    result_hi = _mm256_andnot_pd(is_zero, result_hi);
+    result_hi = _mm256_blendv_pd(result_hi, _mm256_add_pd(x, x), is_nan); // Raise FE_INVALID if x is a signalling NaN.
+    __m256d result_lo = _mm256_blendv_pd(DD4_LO(result), _mm256_xor_pd(x_sqr_hi, _mm256_set1_pd(-0.0)), is_one);
+    result_lo = _mm256_andnot_pd(_mm256_or_pd(is_nan, is_zero), result_lo);
+
+    *hi = result_hi;
+    *lo = result_lo;
+    return;
+}
+
+// Calculate hi[i] + lo[i] = e^(x[i]*x[i]) for i = 0, 1, ... n-1.  The last n%4 elements are handled with masked loads and stores.
+void
+expxsqr_dd_array_avx2(const double* x, double* hi, double* lo, const size_t n) {
+    __m256d result_hi;
+    __m256d result_lo;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        expxsqr_dd_avx2(_mm256_loadu_pd(&x[i]), &result_hi, &result_lo);
+        _mm256_storeu_pd(&hi[i], result_hi);
+        _mm256_storeu_pd(&lo[i], result_lo);
+    }
+    if (i < n) {
+        __m256i mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x((long long)(n - i)), _mm256_set_epi64x(3, 2, 1, 0));
+        expxsqr_dd_avx2(_mm256_maskload_pd(&x[i], mask), &result_hi, &result_lo);
+        _mm256_maskstore_pd(&hi[i], mask, result_hi);
+        _mm256_maskstore_pd(&lo[i], mask, result_lo);
+    }
+    return;
+}
+
+// Calculate hi[i] + lo[i] = e^(-x[i]*x[i]) for i = 0, 1, ... n-1.  The last n%4 elements are handled with masked loads and stores.
+void
+expmxsqr_dd_array_avx2(const double* x, double* hi, double* lo, const size_t n) {
+    __m256d result_hi;
+    __m256d result_lo;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        expmxsqr_dd_avx2(_mm256_loadu_pd(&x[i]), &result_hi, &result_lo);
+        _mm256_storeu_pd(&hi[i], result_hi);
+        _mm256_storeu_pd(&lo[i], result_lo);
+    }
+    if (i < n) {
+        __m256i mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x((long long)(n - i)), _mm256_set_epi64x(3, 2, 1, 0));
+        expmxsqr_dd_avx2(_mm256_maskload_pd(&x[i], mask), &result_hi, &result_lo);
+        _mm256_maskstore_pd(&hi[i], mask, result_hi);
+        _mm256_maskstore_pd(&lo[i], mask, result_lo);
+    }
+    return;
+}
@@ -0,0 +1,155 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Calculate e^(x*x) and e^(-x*x) as double-double sums hi + lo for eight arguments at a time, using AVX-512 instructions.
+
+// This is a lane-by-lane transcription of expxsqr_dd() and expmxsqr_dd() in expxsqr_dd.c; each lane produces the same bits as the
+// scalar functions.  The reduction and reconstruction are those of exp_DD8_DD8() in exp_DD_avx512.h.  See expxsqr_avx512.c for the
+// handling of the special lanes.
+
+// Requires AVX-512F instructions.
+
+// References:
+//  [1] S. Boldo, M. Daumas, and R.-C. Li, “Formally Verified Argument Reduction with a Fused Multiply-Add,” IEEE Transactions on Computers, vol. 58, no. 8, pp. 1139–1145, 2009, doi: 10.1109/TC.2008.216.
+//  [2] J. M. Muller, Elementary functions: algorithms and implementation, Third edition. Boston: Birkhäuser, 2016.
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "DD_arithmetic.h"
+#include "DD_arithmetic_avx512.h"
+#include "exp_DD_avx512.h"
+#include "expxsqr_tables.h"
+
+void
+expxsqr_dd_avx512(const __m512d x, __m512d* hi, __m512d* lo) {
+
+    // Screen for special values.
+    __mmask8 is_nan = _mm512_cmp_pd_mask(x, x, _CMP_UNORD_Q);
+    DD8 x_sqr = sqr_D8_DD8(x);
+    __m512d x_sqr_hi = DD8_HI(x_sqr);
+    // For x^2 < 2^-53, e^(x*x) = 1 + x^2 to within x^4/2 < 2^-107.
+    __mmask8 is_one = _mm512_cmp_pd_mask(x_sqr_hi, _mm512_set1_pd(0x1.0000000000001p-53), _CMP_LT_OQ);
+    // For |x| > 26.641747557046326 (X^2 > 709.78271289338386), expxsqr(x) is Inf.
+    __mmask8 is_inf = _mm512_cmp_pd_mask(x_sqr_hi, _mm512_set1_pd(0x1.62e42fefa39eep+9), _CMP_GT_OQ);
+    __mmask8 is_normal = ~(is_nan | is_one | is_inf);
+    x_sqr = load_D8_D8_DD8(_mm512_maskz_mov_pd(is_normal, DD8_HI(x_sqr)), _mm512_maskz_mov_pd(is_normal, DD8_LO(x_sqr)));
+
+    // Apply the scale factor 2^m = 2^(m/2) * 2^(m - m/2); 0 <= m <= 1024.
+    __m512i m, j;
+    __m512d k_dbl = reduce_D8(DD8_HI(x_sqr), &m, &j);
+    DD8 r = reduced_arg_DD8(DD8_HI(x_sqr), k_dbl);
+    DD8 power_2_j = gather_power_2_DD8((const double*)expxsqr_power_2, j);
+    DD8 result = reconstruct_DD8(r, DD8_LO(x_sqr), power_2_j, _mm512_set1_pd(1.0));
+    __m512i m1 = _mm512_srli_epi64(m, 1);
+    result = scale_DD8(result, m1, _mm512_sub_epi64(m, m1));
+
+    // Merge in the results for the special lanes.
+    __m512d result_hi = _mm512_mask_mov_pd(DD8_HI(result), is_one, _mm512_set1_pd(1.0));
+    result_hi = _mm512_mask_mov_pd(result_hi, is_inf, _mm512_set1_pd(INFINITY));
+    result_hi = _mm512_mask_add_pd(result_hi, is_nan, x, x); // Raise FE_INVALID if x is a signalling NaN.
+    __m512d result_lo = _mm512_mask_mov_pd(DD8_LO(result), is_one, x_sqr_hi);
+    result_lo = _mm512_mask_mov_pd(result_lo, is_nan | is_inf, _mm512_setzero_pd());
+
+    *hi = result_hi;
+    *lo = result_lo;
+    return;
+}
+
+void
+expmxsqr_dd_avx512(const __m512d x, __m512d* hi, __m512d* lo) {
+
+    // Screen for special values.
+    __mmask8 is_nan = _mm512_cmp_pd_mask(x, x, _CMP_UNORD_Q);
+    DD8 x_sqr = sqr_D8_DD8(x);
+    __m512d x_sqr_hi = DD8_HI(x_sqr);
+    // For x^2 < 2^-54, e^(-x*x) = 1 - x^2 to within x^4/2 < 2^-109.
+    __mmask8 is_one = _mm512_cmp_pd_mask(x_sqr_hi, _mm512_set1_pd(0x1.0000000000002p-54), _CMP_LT_OQ);
+    // For |x| > 27.297128403953796 (x^2 > 745.13321910194111), expmxsqr(x) is 0.0.  This also handles the case where |x| == INFINITY.
+    __mmask8 is_zero = _mm512_cmp_pd_mask(x_sqr_hi, _mm512_set1_pd(0x1.74910d52d3051p+9), _CMP_GT_OQ);
+    __mmask8 is_normal = ~(is_nan | is_one | is_zero);
+    x_sqr = load_D8_D8_DD8(_mm512_maskz_mov_pd(is_normal, DD8_HI(x_sqr)), _mm512_maskz_mov_pd(is_normal, DD8_LO(x_sqr)));
+
+    // Apply the scale factor 2^-m = 2^-(m/2) * 2^-(m - m/2); 0 <= m <= 1075.
+    __m512i m, j;
+    __m512d k_dbl = reduce_D8(DD8_HI(x_sqr), &m, &j);
+    DD8 r = reduced_arg_DD8(DD8_HI(x_sqr), k_dbl);
+    DD8 power_2_j = gather_power_2_DD8((const double*)expmxsqr_power_2, j);
+    DD8 result = reconstruct_DD8(r, DD8_LO(x_sqr), power_2_j, _mm512_set1_pd(-1.0));
+    __m512i m1 = _mm512_srli_epi64(m, 1);
+    result = scale_DD8(result, _mm512_sub_epi64(_mm512_setzero_si512(), m1), _mm512_sub_epi64(m1, m));
+
+    // Merge in the results for the special lanes.
+    __m512d neg_x_sqr_hi = _mm512_castsi512_pd(_mm512_xor_epi64(_mm512_castpd_si512(x_sqr_hi), _mm512_set1_epi64(INT64_MIN)));
+    __m512d result_hi = _mm512_mask_mov_pd(DD8_HI(result), is_one, _mm512_set1_pd(1.0));
+    result_hi = _mm512_mask_mov_pd(result_hi, is_zero, _mm512_setzero_pd());
+    result_hi = _mm512_mask_add_pd(result_hi, is_nan, x, x); // Raise FE_INVALID if x is a signalling NaN.
+    __m512d result_lo = _mm512_mask_mov_pd(DD8_LO(result), is_one, neg_x_sqr_hi);
+    result_lo = _mm512_mask_mov_pd(result_lo, is_nan | is_zero, _mm512_setzero_pd());
+
+    *hi = result_hi;
+    *lo = result_lo;
+    return;
+}
+
+// Calculate hi[i] + lo[i] = e^(x[i]*x[i]) for i = 0, 1, ... n-1.  The last n%8 elements are handled with masked loads and stores.
+void
+expxsqr_dd_array_avx512(const double* x, double* hi, double* lo, const size_t n) {
+    __m512d result_hi;
+    __m512d result_lo;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        expxsqr_dd_avx512(_mm512_loadu_pd(&x[i]), &result_hi, &result_lo);
+        _mm512_storeu_pd(&hi[i], result_hi);
+        _mm512_storeu_pd(&lo[i], result_lo);
+    }
+    if (i < n) {
+        __mmask8 mask = (__mmask8)((1U << (n - i)) - 1U);
+        expxsqr_dd_avx512(_mm512_maskz_loadu_pd(mask, &x[i]), &result_hi, &result_lo);
+        _mm512_mask_storeu_pd(&hi[i], mask, result_hi);
+        _mm512_mask_storeu_pd(&lo[i], mask, result_lo);
+    }
+    return;
+}
+
+// Calculate hi[i] + lo[i] = e^(-x[i]*x[i]) for i = 0, 1, ... n-1.  The last n%8 elements are handled with masked loads and stores.
+void
+expmxsqr_dd_array_avx512(const double* x, double* hi, double* lo, const size_t n) {
+    __m512d result_hi;
+    __m512d result_lo;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        expmxsqr_dd_avx512(_mm512_loadu_pd(&x[i]), &result_hi, &result_lo);
+        _mm512_storeu_pd(&hi[i], result_hi);
+        _mm512_storeu_pd(&lo[i], result_lo);
+    }
+    if (i < n) {
+        __mmask8 mask = (__mmask8)((1U << (n - i)) - 1U);
+        expmxsqr_dd_avx512(_mm512_maskz_loadu_pd(mask, &x[i]), &result_hi, &result_lo);
+        _mm512_mask_storeu_pd(&hi[i], mask, result_hi);
+        _mm512_mask_storeu_pd(&lo[i], mask, result_lo);
+    }
+    return;
+}
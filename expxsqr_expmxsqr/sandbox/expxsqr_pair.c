@@ -0,0 +1,103 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Calculate both e^(x*x) and e^(-x*x) with one argument reduction.
+
+// x^2 = k*C + r with C = log(2)/T serves both results:  e^(x^2) = 2^m * 2^(j/T) * e^r and e^(-x^2) = 2^-m * 2^(-j/T) * e^-r.
+// The squaring, the screening and the reduction are done once; the two polynomials are independent dependency chains that the
+// processor can overlap.  The reduction and reconstructions are those of expxsqr() and expmxsqr() (reduce_D() and
+// reconstruct_accurate_DD() in exp_DD.h), so the results are bitwise identical to those of the separate calls.
+
+// Requires FMA instruction.
+// Uses #pragma GCC unroll N
+
+// References:
+//  [1] S. Boldo, M. Daumas, and R.-C. Li, “Formally Verified Argument Reduction with a Fused Multiply-Add,” IEEE Transactions on Computers, vol. 58, no. 8, pp. 1139–1145, 2009, doi: 10.1109/TC.2008.216.
+//  [2] J. M. Muller, Elementary functions: algorithms and implementation, Third edition. Boston: Birkhäuser, 2016.
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+
+#include "DD_arithmetic.h"
+#include "exp_DD.h"
+#include "expxsqr_tables.h"
+
+typedef union {
+    double d;
+    uint64_t ui64;
+} IEEE_BIN64_UNION;
+
+void
+expxsqr_pair(const double x, double* pos, double* neg) {
+
+    // Screen for special values.  The thresholds of expmxsqr() are the outer ones; the expxsqr() thresholds are applied at the end.
+    if (isnan(x)) {
+        *pos = *neg = x + x; // Raise FE_INVALID if x is a signalling NaN.
+        return;
+    }
+    DD x_sqr = sqr_D_DD(x);
+    // For |x| <  7.4505805969238298e-09 (x^2 < 5.5511151231257852e-17), both results are 1.0
+    if (DD_HI(x_sqr) < 0x1.0000000000002p-54) {
+        *pos = *neg = 1.0;
+        return;
+    }
+    // For |x| > 27.297128403953796 (x^2 > 745.13321910194111), expxsqr(x) is Inf and expmxsqr(x) is 0.0.
+    if (DD_HI(x_sqr) > 0x1.74910d52d3051p+9) {
+        *pos = INFINITY;
+        *neg = 0.0;
+        return;
+    }
+
+    // Calculate the reduced argument:  x_sqr = k*C + r_hi + r_lo + DD_LO(x_sqr) where C = log(2)/T and k = nearestint(x_sqr/C) =
+    // m*T + j.  Thus |r_hi| <= log(2)/(2T).  See reduce_D() and reduced_arg_DD() in exp_DD.h.
+    int m, j;
+    double k_dbl = reduce_D(DD_HI(x_sqr), &m, &j);
+    DD r = reduced_arg_DD(DD_HI(x_sqr), k_dbl);
+
+    // Combine to make e^(j/T)*e^(r + DD_LO(x_sqr)) and e^(-j/T)*e^-(r + DD_LO(x_sqr)); see reconstruct_accurate_DD() in exp_DD.h.
+    // Once inlined, the two reconstructions share r_lo + DD_LO(x_sqr) and r_hi^2.
+    DD temp4_pos = reconstruct_accurate_DD(r, DD_LO(x_sqr), expxsqr_power_2[j], 1.0);
+    DD temp4_neg = reconstruct_accurate_DD(r, DD_LO(x_sqr), expmxsqr_power_2[j], -1.0);
+
+    // Apply the scale factor 2^m to e^(x*x); see expxsqr().
+    IEEE_BIN64_UNION result_pos;
+    result_pos.d = DD_HI(temp4_pos);
+    result_pos.ui64 = result_pos.ui64 + ((uint64_t)(m) << (DBL_MANT_DIG - 1));
+
+    // Apply the scale factor 2^-m to e^(-x*x), allowing for a subnormal result; see expmxsqr().
+    const int scale_expo = -1022;
+    int mm = (m < -scale_expo) ? m : m + scale_expo;
+    IEEE_BIN64_UNION result_neg;
+    result_neg.d = DD_HI(temp4_neg);
+    result_neg.ui64 = result_neg.ui64 - ((uint64_t)(mm) << (DBL_MANT_DIG - 1));
+    if (m >= -scale_expo) result_neg.d = 0x1.0p-1022 * result_neg.d;
+
+    // For |x| < 1.0536712127723509e-08 (x^2 < 1.1102230246251568e-16), expxsqr(x) is 1.0
+    // For |x| > 26.641747557046326 (X^2 > 709.78271289338386), expxsqr(x) is Inf.
+    // (In the latter case the exponent manipulation above has produced garbage, which is discarded.)
+    if (DD_HI(x_sqr) < 0x1.0000000000001p-53) result_pos.d = 1.0;
+    else if (DD_HI(x_sqr) > 0x1.62e42fefa39eep+9) result_pos.d = INFINITY;
+
+    *pos = result_pos.d;
+    *neg = result_neg.d;
+    return;
+}
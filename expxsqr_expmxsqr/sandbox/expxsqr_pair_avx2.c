@@ -0,0 +1,111 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Calculate both e^(x*x) and e^(-x*x) for four arguments at a time with one argument reduction, using AVX2 and FMA instructions.
+
+// This is a lane-by-lane transcription of expxsqr_pair() in expxsqr_pair.c; each lane produces the same bits as expxsqr() and
+// expmxsqr().  See expxsqr_avx2.c and expmxsqr_avx2.c for the handling of the special lanes.
+
+// Requires AVX2 and FMA instructions.
+// Uses #pragma GCC unroll N
+
+// References:
+//  [1] S. Boldo, M. Daumas, and R.-C. Li, “Formally Verified Argument Reduction with a Fused Multiply-Add,” IEEE Transactions on Computers, vol. 58, no. 8, pp. 1139–1145, 2009, doi: 10.1109/TC.2008.216.
+//  [2] J. M. Muller, Elementary functions: algorithms and implementation, Third edition. Boston: Birkhäuser, 2016.
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "DD_arithmetic.h"
+#include "DD_arithmetic_avx2.h"
+#include "exp_DD_avx2.h"
+#include "expxsqr_tables.h"
+
+void
+expxsqr_pair_avx2(const __m256d x, __m256d* pos, __m256d* neg) {
+
+    // Screen for special values.  The thresholds of expmxsqr() are the outer ones; lanes outside them skip the reduction.
+    __m256d is_nan = _mm256_cmp_pd(x, x, _CMP_UNORD_Q);
+    DD4 x_sqr = sqr_D4_DD4(x);
+    __m256d is_one_pos = _mm256_cmp_pd(DD4_HI(x_sqr), _mm256_set1_pd(0x1.0000000000001p-53), _CMP_LT_OQ);
+    __m256d is_inf_pos = _mm256_cmp_pd(DD4_HI(x_sqr), _mm256_set1_pd(0x1.62e42fefa39eep+9), _CMP_GT_OQ);
+    __m256d is_one_neg = _mm256_cmp_pd(DD4_HI(x_sqr), _mm256_set1_pd(0x1.0000000000002p-54), _CMP_LT_OQ);
+    __m256d is_zero_neg = _mm256_cmp_pd(DD4_HI(x_sqr), _mm256_set1_pd(0x1.74910d52d3051p+9), _CMP_GT_OQ);
+    __m256d is_special = _mm256_or_pd(is_nan, _mm256_or_pd(is_one_neg, is_zero_neg));
+    x_sqr = load_D4_D4_DD4(_mm256_andnot_pd(is_special, DD4_HI(x_sqr)), _mm256_andnot_pd(is_special, DD4_LO(x_sqr)));
+
+    // Calculate the reduced argument:  x_sqr = k*C + r_hi + r_lo + DD_LO(x_sqr) where C = log(2)/T and k = nearestint(x_sqr/C) =
+    // m*T + j.  Thus |r_hi| <= log(2)/(2T).  See reduce_D4() and reduced_arg_DD4() in exp_DD_avx2.h.
+    __m256i m, j;
+    __m256d k_dbl = reduce_D4(DD4_HI(x_sqr), &m, &j);
+    DD4 r = reduced_arg_DD4(DD4_HI(x_sqr), k_dbl);
+
+    // Combine to make e^(j/T)*e^(r + DD_LO(x_sqr)) and e^(-j/T)*e^-(r + DD_LO(x_sqr)); see reconstruct_accurate_DD4() in
+    // exp_DD_avx2.h.  Once inlined, the two reconstructions share r_lo + DD_LO(x_sqr) and r_hi^2.
+    DD4 temp4_pos = reconstruct_accurate_DD4(r, DD4_LO(x_sqr), (const double*)expxsqr_power_2, j, _mm256_set1_pd(1.0));
+    DD4 temp4_neg = reconstruct_accurate_DD4(r, DD4_LO(x_sqr), (const double*)expmxsqr_power_2, j, _mm256_set1_pd(-1.0));
+
+    // Apply the scale factor 2^m to e^(x*x) and 2^-m to e^(-x*x); see expxsqr_avx2() and expmxsqr_avx2().
+    __m256d result_pos = _mm256_castsi256_pd(_mm256_add_epi64(_mm256_castpd_si256(DD4_HI(temp4_pos)), _mm256_slli_epi64(m, DBL_MANT_DIG - 1)));
+    const int scale_expo = -1022;
+    __m256i use_scale = _mm256_cmpgt_epi64(m, _mm256_set1_epi64x(-scale_expo - 1));
+    __m256i mm = _mm256_add_epi64(m, _mm256_and_si256(use_scale, _mm256_set1_epi64x(scale_expo)));
+    __m256d result_neg = _mm256_castsi256_pd(_mm256_sub_epi64(_mm256_castpd_si256(DD4_HI(temp4_neg)), _mm256_slli_epi64(mm, DBL_MANT_DIG - 1)));
+    result_neg = _mm256_mul_pd(result_neg, _mm256_blendv_pd(_mm256_set1_pd(1.0), _mm256_set1_pd(0x1.0p-1022), _mm256_castsi256_pd(use_scale)));
+
+    // Patch in the results for the special lanes.
+    __m256d nan_result = _mm256_add_pd(x, x); // Raise FE_INVALID if x is a signalling NaN.
+    result_pos = _mm256_blendv_pd(result_pos, _mm256_set1_pd(1.0), is_one_pos);
+    result_pos = _mm256_blendv_pd(result_pos, _mm256_set1_pd(INFINITY), is_inf_pos);
+    result_pos = _mm256_blendv_pd(result_pos, nan_result, is_nan);
+    result_neg = _mm256_blendv_pd(result_neg, _mm256_set1_pd(1.0), is_one_neg);
+    result_neg = _mm256_blendv_pd(result_neg, _mm256_setzero_pd(), is_zero_neg);
+    result_neg = _mm256_blendv_pd(result_neg, nan_result, is_nan);
+
+    *pos = result_pos;
+    *neg = result_neg;
+    return;
+}
+
+// Calculate pos[i] = e^(x[i]*x[i]) and neg[i] = e^(-x[i]*x[i]) for i = 0, 1, ... n-1.  The last n%4 elements are handled with
+// masked loads and stores.
+void
+expxsqr_pair_array_avx2(const double* x, double* pos, double* neg, const size_t n) {
+    __m256d result_pos;
+    __m256d result_neg;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        expxsqr_pair_avx2(_mm256_loadu_pd(&x[i]), &result_pos, &result_neg);
+        _mm256_storeu_pd(&pos[i], result_pos);
+        _mm256_storeu_pd(&neg[i], result_neg);
+    }
+    if (i < n) {
+        __m256i mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x((long long)(n - i)), _mm256_set_epi64x(3, 2, 1, 0));
+        expxsqr_pair_avx2(_mm256_maskload_pd(&x[i], mask), &result_pos, &result_neg);
+        _mm256_maskstore_pd(&pos[i], mask, result_pos);
+        _mm256_maskstore_pd(&neg[i], mask, result_neg);
+    }
+    return;
+}
@@ -0,0 +1,111 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Calculate both e^(x*x) and e^(-x*x) for eight arguments at a time with one argument reduction, using AVX-512F instructions.
+
+// This is a lane-by-lane transcription of expxsqr_pair() in expxsqr_pair.c; each lane produces the same bits as expxsqr() and
+// expmxsqr().  See expxsqr_avx512.c and expmxsqr_avx512.c for the handling of the special lanes.
+
+// Requires AVX-512F instructions.
+// Uses #pragma GCC unroll N
+
+// References:
+//  [1] S. Boldo, M. Daumas, and R.-C. Li, “Formally Verified Argument Reduction with a Fused Multiply-Add,” IEEE Transactions on Computers, vol. 58, no. 8, pp. 1139–1145, 2009, doi: 10.1109/TC.2008.216.
+//  [2] J. M. Muller, Elementary functions: algorithms and implementation, Third edition. Boston: Birkhäuser, 2016.
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "DD_arithmetic.h"
+#include "DD_arithmetic_avx512.h"
+#include "exp_DD_avx512.h"
+#include "expxsqr_tables.h"
+
+void
+expxsqr_pair_avx512(const __m512d x, __m512d* pos, __m512d* neg) {
+
+    // Screen for special values.  The thresholds of expmxsqr() are the outer ones; lanes outside them skip the reduction.
+    __mmask8 is_nan = _mm512_cmp_pd_mask(x, x, _CMP_UNORD_Q);
+    DD8 x_sqr = sqr_D8_DD8(x);
+    __mmask8 is_one_pos = _mm512_cmp_pd_mask(DD8_HI(x_sqr), _mm512_set1_pd(0x1.0000000000001p-53), _CMP_LT_OQ);
+    __mmask8 is_inf_pos = _mm512_cmp_pd_mask(DD8_HI(x_sqr), _mm512_set1_pd(0x1.62e42fefa39eep+9), _CMP_GT_OQ);
+    __mmask8 is_one_neg = _mm512_cmp_pd_mask(DD8_HI(x_sqr), _mm512_set1_pd(0x1.0000000000002p-54), _CMP_LT_OQ);
+    __mmask8 is_zero_neg = _mm512_cmp_pd_mask(DD8_HI(x_sqr), _mm512_set1_pd(0x1.74910d52d3051p+9), _CMP_GT_OQ);
+    __mmask8 is_normal = ~(is_nan | is_one_neg | is_zero_neg);
+    x_sqr = load_D8_D8_DD8(_mm512_maskz_mov_pd(is_normal, DD8_HI(x_sqr)), _mm512_maskz_mov_pd(is_normal, DD8_LO(x_sqr)));
+
+    // Calculate the reduced argument:  x_sqr = k*C + r_hi + r_lo + DD_LO(x_sqr) where C = log(2)/T and k = nearestint(x_sqr/C) =
+    // m*T + j.  Thus |r_hi| <= log(2)/(2T).  See reduce_D8() and reduced_arg_DD8() in exp_DD_avx512.h.
+    __m512i m, j;
+    __m512d k_dbl = reduce_D8(DD8_HI(x_sqr), &m, &j);
+    DD8 r = reduced_arg_DD8(DD8_HI(x_sqr), k_dbl);
+
+    // Combine to make e^(j/T)*e^(r + DD_LO(x_sqr)) and e^(-j/T)*e^-(r + DD_LO(x_sqr)); see reconstruct_accurate_DD8() in
+    // exp_DD_avx512.h.  Once inlined, the two reconstructions share r_lo + DD_LO(x_sqr) and r_hi^2.
+    DD8 temp4_pos = reconstruct_accurate_DD8(r, DD8_LO(x_sqr), (const double*)expxsqr_power_2, j, _mm512_set1_pd(1.0));
+    DD8 temp4_neg = reconstruct_accurate_DD8(r, DD8_LO(x_sqr), (const double*)expmxsqr_power_2, j, _mm512_set1_pd(-1.0));
+
+    // Apply the scale factor 2^m to e^(x*x) and 2^-m to e^(-x*x); see expxsqr_avx512() and expmxsqr_avx512().
+    __m512d result_pos = _mm512_castsi512_pd(_mm512_add_epi64(_mm512_castpd_si512(DD8_HI(temp4_pos)), _mm512_slli_epi64(m, DBL_MANT_DIG - 1)));
+    const int scale_expo = -1022;
+    __mmask8 use_scale = _mm512_cmpgt_epi64_mask(m, _mm512_set1_epi64(-scale_expo - 1));
+    __m512i mm = _mm512_mask_add_epi64(m, use_scale, m, _mm512_set1_epi64(scale_expo));
+    __m512d result_neg = _mm512_castsi512_pd(_mm512_sub_epi64(_mm512_castpd_si512(DD8_HI(temp4_neg)), _mm512_slli_epi64(mm, DBL_MANT_DIG - 1)));
+    result_neg = _mm512_mask_mul_pd(result_neg, use_scale, result_neg, _mm512_set1_pd(0x1.0p-1022));
+
+    // Merge in the results for the special lanes.
+    __m512d nan_result = _mm512_maskz_add_pd(is_nan, x, x); // Raise FE_INVALID if x is a signalling NaN.
+    result_pos = _mm512_mask_mov_pd(result_pos, is_one_pos, _mm512_set1_pd(1.0));
+    result_pos = _mm512_mask_mov_pd(result_pos, is_inf_pos, _mm512_set1_pd(INFINITY));
+    result_pos = _mm512_mask_mov_pd(result_pos, is_nan, nan_result);
+    result_neg = _mm512_mask_mov_pd(result_neg, is_one_neg, _mm512_set1_pd(1.0));
+    result_neg = _mm512_mask_mov_pd(result_neg, is_zero_neg, _mm512_setzero_pd());
+    result_neg = _mm512_mask_mov_pd(result_neg, is_nan, nan_result);
+
+    *pos = result_pos;
+    *neg = result_neg;
+    return;
+}
+
+// Calculate pos[i] = e^(x[i]*x[i]) and neg[i] = e^(-x[i]*x[i]) for i = 0, 1, ... n-1.  The last n%8 elements are handled with
+// masked loads and stores.
+void
+expxsqr_pair_array_avx512(const double* x, double* pos, double* neg, const size_t n) {
+    __m512d result_pos;
+    __m512d result_neg;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        expxsqr_pair_avx512(_mm512_loadu_pd(&x[i]), &result_pos, &result_neg);
+        _mm512_storeu_pd(&pos[i], result_pos);
+        _mm512_storeu_pd(&neg[i], result_neg);
+    }
+    if (i < n) {
+        __mmask8 mask = (__mmask8)((1U << (n - i)) - 1U);
+        expxsqr_pair_avx512(_mm512_maskz_loadu_pd(mask, &x[i]), &result_pos, &result_neg);
+        _mm512_mask_storeu_pd(&pos[i], mask, result_pos);
+        _mm512_mask_storeu_pd(&neg[i], mask, result_neg);
+    }
+    return;
+}
@@ -0,0 +1,256 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Tables shared by the scalar and vector implementations of e^(x*x) and e^(-x*x).  The single-precision tables at the end are used
+// by expxsqrf and expmxsqrf.
+//
+// The double-precision code reduces x^2 by C = log(2)/T, where T = EXPXSQR_TABLE_SIZE = 2^EXPXSQR_TABLE_BITS.  The built-in tables
+// are for T = 32.  Compiling with -DEXPXSQR_TABLES='"file"' replaces them with a set generated by make_tables for another T (see
+// sweep_tables).
+
+#if !defined(_EXPXSQR_TABLES_H)
+#define _EXPXSQR_TABLES_H 1
+
+#include "DD_arithmetic.h"
+
+#if defined(EXPXSQR_TABLES)
+#include EXPXSQR_TABLES
+#else
+#define EXPXSQR_TABLE_BITS 5
+#define EXPXSQR_TABLE_SIZE 32
+#define EXPXSQR_R  (0x1.71547652b82fep5)   // 1 / (log(2)/32) = 46.1662413084468283841488300822675228118896484375.
+#define EXPXSQR_C1 (0x1.62e42fefa39fp-6)   // 1/R rounded to DBL_MANT_DIG - 2 digits = 2.1660849392498293664033326422213576734066009521484375e-2.
+#define EXPXSQR_C2 (-0x1.950d871319ffp-59) // C - C1 = -2.74474482262664548052179828101159533155297914441654583139751366616110317409038543701171875e-18.
+
+// Minimax coefficients of the polynomial x + 0.5 * x^2 + ... to calculate e^x - 1 for |x| <= log(2)/64; max error ~ 9.1e-20
+// Note that the array is in reverse order.
+#define EXPXSQR_COEFFS_MAX_ERR (9.1e-20)
+static const
+double expxsqr_coeffs[5] __attribute__((aligned(64), unused)) = {
+    0x1.6c16c4e5c2edbp-10, // 1.38888909117700662e-3  N = 6
+    0x1.11115b866f5eep-7,  // 8.33336800576042410e-3  N = 5
+    0x1.555555555c02fp-5,  // 4.16666666668564708e-2  N = 4
+    0x1.5555555548f44p-3,  // 1.66666666665259314e-1  N = 3
+    0x1.0000000000000p-1,  // 5.00000000000000000e-1  N = 2
+};
+
+// Table of 2^(j/32) in double-double for j = 0, 1, ... 31.
+// The vector code gathers the high parts from element 2*j and the low parts from element 2*j+1 of the table viewed as a double[].
+static const
+DD expxsqr_power_2[32] __attribute__((aligned(64), unused)) = {
+    {0x1.0000000000000p0,   0x0.0000000000000p0},   // 1.0
+    {0x1.059b0d3158574p0,   0x1.d73e2a475b465p-55}, // 1.02189714865411667823448013478329865135948390552117137111188911930727274413044369794079102575778961181640625
+    {0x1.0b5586cf9890fp0,   0x1.8a62e4adc610bp-54}, // 1.0442737824274138403219664787399333395756837043858642647451456689049187342988034288282506167888641357421875
+    {0x1.11301d0125b51p0,  -0x1.6c51039449b3ap-54}, // 1.067140400676823618169521120992806674867648982094983365047713235428117339864684254280291497707366943359375
+    {0x1.172b83c7d517bp0,  -0x1.19041b9d78a76p-55}, // 1.0905077326652576592070106557607059619378242300539842806908640460324122489765841237385757267475128173828125
+    {0x1.1d4873168b9aap0,   0x1.e016e00a2643cp-54}, // 1.11438674259589253630881295691960159209878389548116926603083475487421249994213212630711495876312255859375
+    {0x1.2387a6e756238p0,   0x1.9b07eb6c70573p-54}, // 1.1387886347566916537038302838415132621348759387615339330966556723005733697817731808754615485668182373046875
+    {0x1.29e9df51fdee1p0,   0x1.612e8afad1255p-55}, // 1.16372485877757751381357359909218459263323319712506847222383121590906507325513530304306186735630035400390625
+    {0x1.306fe0a31b715p0,   0x1.6f46ad23182e4p-55}, // 1.189207115002721066717499970560474773333315207010475316930993056226129045427342134644277393817901611328125
+    {0x1.371a7373aa9cbp0,  -0x1.63aeabf42eae2p-54}, // 1.215247359980468878116520251338793740417660344343095710747381927967214476637991538154892623424530029296875
+    {0x1.3dea64c123422p0,   0x1.ada0911f09ebcp-55}, // 1.241857812073484048593677468726597919910144782992293380011409177458847619135440254467539489269256591796875
+    {0x1.44e086061892dp0,   0x1.89b7a04ef80d0p-59}, // 1.26905095719173322255441908103233805488765523241270641061315227839968733380970888902083970606327056884765625
+    {0x1.4bfdad5362a27p0,   0x1.d4397afec42e2p-56}, // 1.29683955465100966593375411779245099115709868759247192343833928016190448762046116826240904629230499267578125
+    {0x1.5342b569d4f82p0,  -0x1.07abe1db13cadp-55}, // 1.32523664315974129462953709549872091209174203063984378736264884194283319995832925997092388570308685302734375
+    {0x1.5ab07dd485429p0,   0x1.6324c054647adp-54}, // 1.3542555469368927282980147401407050450916257598394039915778826123522737834292684055981226265430450439453125
+    {0x1.6247eb03a5585p0,  -0x1.383c17e40b497p-54}, // 1.3839098819638319548726595272651922920481841178771973893956524618610581800481895697885192930698394775390625
+    {0x1.6a09e667f3bcdp0,  -0x1.bdd3413b26456p-54}, // 1.414213562373095048801688724209693939894363175963335998701832945702305810442567235440947115421295166015625
+    {0x1.71f75e8ec5f74p0,  -0x1.16e4786887a99p-55}, // 1.44518080697704662003700624147167267869039863050317396063176647309604649915826257711159996688365936279296875
+    {0x1.7a11473eb0187p0,  -0x1.41577ee04992fp-55}, // 1.47682614593949931138690748037405004508134151527662272305085045778945407324300731488619931042194366455078125
+    {0x1.82589994cce13p0,  -0x1.d4c1dd41532d8p-54}, // 1.5091644275934227397660195510331933272280355048675691299401289448278706828432405018247663974761962890625
+    {0x1.8ace5422aa0dbp0,   0x1.6e9f156864b27p-54}, // 1.5422108254079408236122918620907357573024506717288439856794389991832827657702864598832093179225921630859375
+    {0x1.93737b0cdc5e5p0,  -0x1.75fc781b57ebcp-57}, // 1.57598084510788648645527016018190446499171206664148557502544621103553190710755416148458607494831085205078125
+    {0x1.9c49182a3f090p0,   0x1.c7c46b071f2bep-56}, // 1.61049033194925430817952066735739951377465936223897914369579330534469618907422727716038934886455535888671875
+    {0x1.a5503b23e255dp0,  -0x1.d2f6edb8d41e1p-54}, // 1.6457554781539648445187567247258231195058161695956003502688637699612195230969291515066288411617279052734375
+    {0x1.ae89f995ad3adp0,   0x1.7a1cd345dcc81p-54}, // 1.6817928305074290860622509524664246865648737966202232310082144797237779787479894366697408258914947509765625
+    {0x1.b7f76f2fb5e47p0,  -0x1.5584f7e54ac3bp-56}, // 1.718619298122477915629344376456311862953238692694799428012951807436155260422339097203803248703479766845703125
+    {0x1.c199bdd85529cp0,   0x1.11065895048ddp-55}, // 1.75625216037329948311216061937531198781207486594875267496506138936197827238316904185921885073184967041015625
+    {0x1.cb720dcef9069p0,   0x1.503cbd1e949dbp-56}, // 1.794709075003107186427703242127780392590101493494374820660256341221631959381710430534440092742443084716796875
+    {0x1.d5818dcfba487p0,   0x1.2ed02d75b3707p-55}, // 1.83400808640934246348708318958828949858624512817790771672885267030810030330911786222713999450206756591796875
+    {0x1.dfc97337b9b5fp0,  -0x1.1a5cd4f184b5cp-54}, // 1.87416763411029990132999894995444124855382223821278817442950053763495166236907607526518404483795166015625
+    {0x1.ea4afa2a490dap0,  -0x1.e9c23179c2893p-54}, // 1.9152065613971472938726112702958339456200332044370186797392979706662619054924334704992361366748809814453125
+    {0x1.f50765b6e4540p0,   0x1.9d3e12dd8a18bp-54}, // 1.9571441241754002690183222516268724544578878887912042076490756639488288737283028240199200809001922607421875
+};
+
+// Table of 2^(-j/32) in double-double for j = 0, 1, ... 31.
+static const
+DD expmxsqr_power_2[32] __attribute__((aligned(64), unused)) = {
+    {0x1.0000000000000p0,   0x0.0000000000000p0},   // 1.0
+    {0x1.f50765b6e4540p-1,  0x1.9d3e12dd8a18bp-55}, // 0.97857206208770008970532217063009738922119140625
+    {0x1.ea4afa2a490dap-1, -0x1.e9c23179c2893p-55}, // 0.9576032806985737000360359161277301609516143798828125
+    {0x1.dfc97337b9b5fp-1, -0x1.1a5cd4f184b5cp-55}, // 0.93708381705514998127881653999793343245983123779296875
+    {0x1.d5818dcfba487p-1,  0x1.2ed02d75b3707p-56}, // 0.91700404320467121532800547356600873172283172607421875
+    {0x1.cb720dcef9069p-1,  0x1.503cbd1e949dbp-57}, // 0.89735453750155358410012240710784681141376495361328125
+    {0x1.c199bdd85529cp-1,  0x1.11065895048ddp-56}, // 0.878126080186649726755376832443289458751678466796875
+    {0x1.b7f76f2fb5e47p-1, -0x1.5584f7e54ac3bp-57}, // 0.85930964906123896707157427954371087253093719482421875
+    {0x1.ae89f995ad3adp-1,  0x1.7a1cd345dcc81p-55}, // 0.84089641525371450203607537332572974264621734619140625
+    {0x1.a5503b23e255dp-1, -0x1.d2f6edb8d41e1p-55}, // 0.82287773907698247288777793073677457869052886962890625
+    {0x1.9c49182a3f090p-1,  0x1.c7c46b071f2bep-57}, // 0.8052451659746271417361640487797558307647705078125
+    {0x1.93737b0cdc5e5p-1, -0x1.75fc781b57ebcp-58}, // 0.78799042255394324829609331573010422289371490478515625
+    {0x1.8ace5422aa0dbp-1,  0x1.6e9f156864b27p-55}, // 0.77110541270397037205697188255726359784603118896484375
+    {0x1.82589994cce13p-1, -0x1.d4c1dd41532d8p-55}, // 0.75458221379671142070577616323134861886501312255859375
+    {0x1.7a11473eb0187p-1, -0x1.41577ee04992fp-56}, // 0.73841307296974967311342652465100400149822235107421875
+    {0x1.71f75e8ec5f74p-1, -0x1.16e4786887a99p-56}, // 0.722590403488523325137293795705772936344146728515625
+    {0x1.6a09e667f3bcdp-1, -0x1.bdd3413b26456p-55}, // 0.70710678118654757273731092936941422522068023681640625
+    {0x1.6247eb03a5585p-1, -0x1.383c17e40b497p-55}, // 0.69195494098191601128888805760652758181095123291015625
+    {0x1.5ab07dd485429p-1,  0x1.6324c054647adp-55}, // 0.67712777346844632564426547105540521442890167236328125
+    {0x1.5342b569d4f82p-1, -0x1.07abe1db13cadp-56}, // 0.6626183215798706616084245979436673223972320556640625
+    {0x1.4bfdad5362a27p-1,  0x1.d4397afec42e2p-57}, // 0.64841977732550482027562566145206801593303680419921875
+    {0x1.44e086061892dp-1,  0x1.89b7a04ef80d0p-60}, // 0.63452547859586660994324347484507597982883453369140625
+    {0x1.3dea64c123422p-1,  0x1.ada0911f09ebcp-56}, // 0.6209289060367420010067007751786150038242340087890625
+    {0x1.371a7373aa9cbp-1, -0x1.63aeabf42eae2p-55}, // 0.60762367999023447762141358907683752477169036865234375
+    {0x1.306fe0a31b715p-1,  0x1.6f46ad23182e4p-56}, // 0.59460355750136051344867382795200683176517486572265625
+    {0x1.29e9df51fdee1p-1,  0x1.612e8afad1255p-56}, // 0.58186242938878873776076261492562480270862579345703125
+    {0x1.2387a6e756238p-1,  0x1.9b07eb6c70573p-55}, // 0.56939431737834578228785176179371774196624755859375
+    {0x1.1d4873168b9aap-1,  0x1.e016e00a2643cp-55}, // 0.5571933712979462161030141942319460213184356689453125
+    {0x1.172b83c7d517bp-1, -0x1.19041b9d78a76p-56}, // 0.54525386633262884483741572694270871579647064208984375
+    {0x1.11301d0125b51p-1, -0x1.6c51039449b3ap-55}, // 0.53357020033841184858403039470431394875049591064453125
+    {0x1.0b5586cf9890fp-1,  0x1.8a62e4adc610bp-55}, // 0.52213689121370687740153471168014220893383026123046875
+    {0x1.059b0d3158574p-1,  0x1.d73e2a475b465p-56}, // 0.510948574327058313571114922524429857730865478515625
+};
+
+#endif // EXPXSQR_TABLES
+
+// The bound on the relative error of the double-double result of the correctly rounded tier of expxsqr.c and expmxsqr.c, before
+// its rounding test, for any table size T.  With R = log(2)/(2T), u = 2^-53 and E = EXPXSQR_COEFFS_MAX_ERR:
+//   Reduction:  x^2 = hi + lo exactly (sqr_D_DD), hi - k * C1 is exact (Ref. [1] of expxsqr.c) and r_hi + r_lo equals
+//     hi - k * (C1 + C2) to within 2^-105.  C1 + C2 is within 2^-53 * |C2| <= 2^-104 * C of C = log(2)/T, so for k <= 745.2 / C
+//     the reduced argument is off by less than 2^-94.  The rounding of R and of x^2 * R leaves |r_hi| <= R * (1 + 2^-37).
+//   Polynomial:  r_hi + r_hi^2 * p(r_hi) is within E of e^r_hi - 1 (E is measured on [-R, R] * (1 + 2^-40); over the extra
+//     2^-37 * R the error grows by less than 2^-30 * E).  |p(r_hi)| <= e^R / 2 is evaluated with a relative error below
+//     (2 + R) * u by either scheme, and r_hi * r_hi * p(r_hi) with two more roundings, so that product is off by less than
+//     (4 + R) * u * R^2 * e^R / 2; adding r_hi is exact (fast_add_D_D_DD).  Relative to e^r_hi >= e^-R, these are at most
+//     E * (1 + 2^-30) * e^R <= E * (1 + 2R) and (2 + R/2) * e^2R * u * R^2 <= 2^-52 * (1 + 3R) * R^2.
+//   Reconstruction:  the table entries are within 2^-106 of 2^(j/T), add_DD_DD_DD and mul_DD_DD_DD add at most 3 * u^2 and
+//     5 * u^2 (Ref. [1] of DD_arithmetic.h, algorithms 6 and 12), and e^(r_lo + lo), |r_lo + lo| <= 2^-43.9, is evaluated to
+//     within 2^-95.
+// The reduction and reconstruction terms, with the rounding of the test itself (under 2^-104), add up to less than 2^-93.  For the
+// built-in tables (T = 32, E = 9.1e-20) the bound is 1.20e-19; the largest errors measured are 1.02e-19 for e^(x*x) and 1.01e-19
+// for e^(-x*x).
+#define EXPXSQR_CR_R_MAX (0x1.62e42fefa39efp-1 / (2 * EXPXSQR_TABLE_SIZE))
+#define EXPXSQR_CR_MAX_ERR (EXPXSQR_COEFFS_MAX_ERR * (1.0 + 2.0 * EXPXSQR_CR_R_MAX) \
+                            + 0x1.0p-52 * (1.0 + 3.0 * EXPXSQR_CR_R_MAX) * EXPXSQR_CR_R_MAX * EXPXSQR_CR_R_MAX + 0x1.0p-93)
+
+// The bound on the relative error of the double-double result of reconstruct_accurate_DD() (exp_DD.h), which the correctly
+// rounded tier tests first.  The reduction, the polynomial and e^(r_lo + lo) are as above; what differs is that e^r_hi - 1 is
+// rounded to a double before it is multiplied by 2^(j/T), with these four errors, each below u * R * (1 + R) * e^R relative to
+// e^r_hi:  r_lo is counted in both e^r_hi - 1 and e^(r_lo + lo) (|r_lo| <= u * |r_hi|), the sum r_hi + (r_lo + r_hi^2 * p(r_hi))
+// is rounded, its product with DD_HI(2^(j/T)) is rounded, and DD_LO(2^(j/T)) (below u * 2^(j/T)) is left out of that product.
+// With the rounding of r_lo + r_hi^2 * p(r_hi), below u * R^2 * e^2R / 2, these add up to less than u * R * (4 + 7R) for T >= 12
+// (R <= 1/32); add_DD_D_DD adds at most 2 * u^2, within the 2^-93 margin.  For the built-in tables the bound is 5.02e-18, some 40
+// times that of the double-double result; the largest errors measured are 2.74e-18 for e^(x*x) and 2.77e-18 for e^(-x*x), and the
+// test fails for about one argument in 15.
+#define EXPXSQR_ACCURATE_MAX_ERR (EXPXSQR_COEFFS_MAX_ERR * (1.0 + 2.0 * EXPXSQR_CR_R_MAX) \
+                                  + 0x1.0p-52 * (1.0 + 3.0 * EXPXSQR_CR_R_MAX) * EXPXSQR_CR_R_MAX * EXPXSQR_CR_R_MAX \
+                                  + 0x1.0p-53 * (4.0 + 7.0 * EXPXSQR_CR_R_MAX) * EXPXSQR_CR_R_MAX + 0x1.0p-93)
+
+// Coefficients of the polynomial x + 0.5 * x^2 + ... to calculate e^x - 1 for |x| <= log(2)/32 in single precision.  The truncated
+// Taylor series suffices:  the first omitted term, x^5/120, is < 4e-11.
+// Note that the array is in reverse order.
+static const
+float expxsqrf_coeffs[3] __attribute__((aligned(16), unused)) = {
+    0x1.555556p-5f,  // 4.16666679e-2  N = 4
+    0x1.555556p-3f,  // 1.66666672e-1  N = 3
+    0x1.000000p-1f,  // 5.00000000e-1  N = 2
+};
+
+// Table of 2^(j/16) in float-float for j = 0, 1, ... 15, stored as separate high and low arrays.  Each array is 64 bytes, so the
+// AVX-512 code holds it in one register and looks it up with a permute instead of a gather.
+static const
+float expxsqrf_power_2_hi[16] __attribute__((aligned(64), unused)) = {
+    0x1.000000p+0f, // 1
+    0x1.0b5586p+0f, // 1.04427378242741384032
+    0x1.172b84p+0f, // 1.09050773266525765920
+    0x1.2387a6p+0f, // 1.13878863475669165370
+    0x1.306fe0p+0f, // 1.18920711500272106671
+    0x1.3dea64p+0f, // 1.24185781207348404859
+    0x1.4bfdaep+0f, // 1.29683955465100966593
+    0x1.5ab07ep+0f, // 1.35425554693689272829
+    0x1.6a09e6p+0f, // 1.41421356237309504880
+    0x1.7a1148p+0f, // 1.47682614593949931138
+    0x1.8ace54p+0f, // 1.54221082540794082361
+    0x1.9c4918p+0f, // 1.61049033194925430817
+    0x1.ae89fap+0f, // 1.68179283050742908606
+    0x1.c199bep+0f, // 1.75625216037329948311
+    0x1.d5818ep+0f, // 1.83400808640934246348
+    0x1.ea4afap+0f, // 1.91520656139714729387
+};
+static const
+float expxsqrf_power_2_lo[16] __attribute__((aligned(64), unused)) = {
+     0x0.000000p+0f,
+     0x1.9f3122p-25f,
+    -0x1.c15742p-27f,
+     0x1.ceac48p-25f,
+     0x1.4636e2p-25f,
+     0x1.824684p-25f,
+    -0x1.593abcp-25f,
+    -0x1.5bd5ecp-27f,
+     0x1.9fcef4p-26f,
+    -0x1.829fd0p-25f,
+     0x1.15506ep-27f,
+     0x1.51f848p-27f,
+    -0x1.a94b14p-26f,
+    -0x1.3d56b2p-27f,
+    -0x1.822dbcp-27f,
+     0x1.52486cp-27f,
+};
+
+// Table of 2^(-j/16) in float-float for j = 0, 1, ... 15, stored as separate high and low arrays.
+static const
+float expmxsqrf_power_2_hi[16] __attribute__((aligned(64), unused)) = {
+    0x1.000000p+0f, // 1
+    0x1.ea4afap-1f, // 0.95760328069857364693
+    0x1.d5818ep-1f, // 0.91700404320467123174
+    0x1.c199bep-1f, // 0.87812608018664974155
+    0x1.ae89fap-1f, // 0.84089641525371454303
+    0x1.9c4918p-1f, // 0.80524516597462715408
+    0x1.8ace54p-1f, // 0.77110541270397041180
+    0x1.7a1148p-1f, // 0.73841307296974965569
+    0x1.6a09e6p-1f, // 0.70710678118654752440
+    0x1.5ab07ep-1f, // 0.67712777346844636414
+    0x1.4bfdaep-1f, // 0.64841977732550483296
+    0x1.3dea64p-1f, // 0.62092890603674202429
+    0x1.306fe0p-1f, // 0.59460355750136053335
+    0x1.2387a6p-1f, // 0.56939431737834582685
+    0x1.172b84p-1f, // 0.54525386633262882960
+    0x1.0b5586p-1f, // 0.52213689121370692016
+};
+static const
+float expmxsqrf_power_2_lo[16] __attribute__((aligned(64), unused)) = {
+     0x0.000000p+0f,
+     0x1.52486cp-28f,
+    -0x1.822dbcp-28f,
+    -0x1.3d56b2p-28f,
+    -0x1.a94b14p-27f,
+     0x1.51f848p-28f,
+     0x1.15506ep-28f,
+    -0x1.829fd0p-26f,
+     0x1.9fcef4p-27f,
+    -0x1.5bd5ecp-28f,
+    -0x1.593abcp-26f,
+     0x1.824684p-26f,
+     0x1.4636e2p-26f,
+     0x1.ceac48p-26f,
+    -0x1.c15742p-28f,
+     0x1.9f3122p-26f,
+};
+
+#endif // _EXPXSQR_TABLES_H
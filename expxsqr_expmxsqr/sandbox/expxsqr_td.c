@@ -0,0 +1,162 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Correctly rounded e^(x*x) and e^(-x*x) from a triple-double evaluation:  the fallback of the correctly rounded tier
+// (EXPXSQR_TIER_CORRECTLY_ROUNDED, see expxsqr.h), called when the rounding test on its double-double result fails.
+
+// x*x is reduced by log(2) rather than by log(2)/T, so that no triple-double table is needed:  x*x = k*log(2) + r with
+// |r| <= log(2)/2.  e^(+-r) - 1 is evaluated by its Taylor series at r*2^-10 and brought back to e^(+-r) - 1 by ten steps of
+// q = 2q + q^2.  The relative error of the result before the final rounding is about 2^-150 (at most 2^-153 was measured against
+// MPFR over 2e6 arguments), so it is rounded correctly unless e^(+-x*x) lies within about 2^-150 relative of a rounding boundary,
+// i.e. unless some 97 bits after the rounding bit are all 0 or all 1.  The worst cases of e^(+-x*x) have not been searched for,
+// but that is far beyond the known worst cases of e^x [2].  This is the second and last step of Ziv's strategy [1].
+
+// Requires FMA instruction.
+
+// References:
+//  [1] A. Ziv, “Fast evaluation of elementary mathematical functions with correctly rounded last bit,” ACM Transactions on Mathematical Software, vol. 17, no. 3, pp. 410–423, 1991.
+//  [2] J. M. Muller, Elementary functions: algorithms and implementation, Third edition. Boston: Birkhäuser, 2016.
+
+#include <float.h>
+#include <math.h>
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include "DD_arithmetic.h"
+#include "TD_arithmetic.h"
+#include "expxsqr.h"
+#include "expxsqr_td.h"
+
+typedef union {
+    double d;
+    uint64_t ui64;
+} IEEE_BIN64_UNION;
+
+static atomic_ullong escalations = 0;
+
+unsigned long long
+expxsqr_cr_escalations(void) {
+    return atomic_load_explicit(&escalations, memory_order_relaxed);
+}
+
+// 2^e for -1022 <= e <= 1023.
+static inline double
+power_2(const int e) {
+    IEEE_BIN64_UNION result;
+    result.ui64 = (uint64_t)(e + DBL_MAX_EXP - 1) << (DBL_MANT_DIG - 1);
+    return result.d;
+}
+
+// e^r - 1 for |r| <= log(2)/2 (plus a little for the rounding of k).
+static TD
+expm1_TD(const TD r) {
+    // Taylor coefficients 1/n! for n = 3, ... 8 in triple-double and for n = 9, ... 13 in double; the series is truncated after the
+    // term in s^13 for |s| <= 2^-11, which is below 2^-170 relative to s.
+    static const TD coeffs_TD[6] = {
+        {0x1.a01a01a01a01ap-16, 0x1.a01a01a01a01ap-76, 0x1.a01a01a01a01ap-136},  // 1/8!
+        {0x1.a01a01a01a01ap-13, 0x1.a01a01a01a01ap-73, 0x1.a01a01a01a01ap-133},  // 1/7!
+        {0x1.6c16c16c16c17p-10, -0x1.f49f49f49f49fp-65, -0x1.27d27d27d27d2p-119}, // 1/6!
+        {0x1.1111111111111p-7, 0x1.1111111111111p-63, 0x1.1111111111111p-119},    // 1/5!
+        {0x1.5555555555555p-5, 0x1.5555555555555p-59, 0x1.5555555555555p-113},    // 1/4!
+        {0x1.5555555555555p-3, 0x1.5555555555555p-57, 0x1.5555555555555p-111},    // 1/3!
+    };
+    static const double coeffs_D[5] = {
+        0x1.6124613a86d09p-33, // 1/13!
+        0x1.1eed8eff8d898p-29, // 1/12!
+        0x1.ae64567f544e4p-26, // 1/11!
+        0x1.27e4fb7789f5cp-22, // 1/10!
+        0x1.71de3a556c734p-19, // 1/9!
+    };
+    const int N_TD = sizeof(coeffs_TD) / sizeof(coeffs_TD[0]);
+    const int N_D = sizeof(coeffs_D) / sizeof(coeffs_D[0]);
+    const int HALVINGS = 10;
+
+    // s = r * 2^-HALVINGS exactly.
+    const double scale = power_2(-HALVINGS);
+    TD s = load_D_D_D_TD(TD_HI(r) * scale, TD_MI(r) * scale, TD_LO(r) * scale);
+
+    // The terms from s^9 on contribute less than 2^-100 relative to s, so they are summed in double precision.
+    double p_d = coeffs_D[0];
+    for (int i = 1; i < N_D; i++) {
+        p_d = fma(TD_HI(s), p_d, coeffs_D[i]);
+    }
+    TD p = add_TD_TD_TD(coeffs_TD[0], mul_TD_D_TD(s, p_d));
+    for (int i = 1; i < N_TD; i++) {
+        p = add_TD_TD_TD(coeffs_TD[i], mul_TD_TD_TD(s, p));
+    }
+    p = add_TD_D_TD(mul_TD_TD_TD(s, p), 0.5);
+    p = add_TD_D_TD(mul_TD_TD_TD(s, p), 1.0);
+    TD q = mul_TD_TD_TD(s, p); // q = e^s - 1.
+
+    // e^(2s) - 1 = 2q + q^2.
+    for (int i = 0; i < HALVINGS; i++) {
+        TD two_q = load_D_D_D_TD(2.0 * TD_HI(q), 2.0 * TD_MI(q), 2.0 * TD_LO(q));
+        q = add_TD_TD_TD(two_q, mul_TD_TD_TD(q, q));
+    }
+    return q;
+}
+
+// e^(sign * x_sqr) = 2^*e * y before the final rounding (see expxsqr_td.h).
+TD
+expxsqr_td_scaled(const DD x_sqr, const double sign, int* e) {
+    // log(2) and 1/log(2) to triple-double precision.
+    const double LOG2_HI = 0x1.62e42fefa39efp-1;
+    const double LOG2_MI = 0x1.abc9e3b39803fp-56;
+    const double LOG2_LO = 0x1.7b57a079a1934p-111;
+    const double INV_LOG2 = 0x1.71547652b82fep+0;
+
+    // r = x_sqr - k*log(2).  Since k < 2^11, k*LOG2_HI and k*LOG2_MI are formed exactly and k*LOG2_LO has a relative error of
+    // 2^-53, which is below 2^-150 absolute.
+    double k_dbl = nearbyint(DD_HI(x_sqr) * INV_LOG2);
+    DD p_hi = mul_D_D_DD(k_dbl, LOG2_HI);
+    DD p_mi = mul_D_D_DD(k_dbl, LOG2_MI);
+    DD d = add_D_D_DD(DD_HI(x_sqr), -DD_HI(p_hi));
+    TD r = renormalize_D_D_D_TD(DD_HI(d), DD_LO(d), DD_LO(x_sqr));
+    r = add_TD_D_TD(r, -DD_LO(p_hi));
+    r = add_TD_D_TD(r, -DD_HI(p_mi));
+    r = add_TD_D_TD(r, -DD_LO(p_mi));
+    r = add_TD_D_TD(r, -k_dbl * LOG2_LO);
+    if (sign < 0.0) r = negate_TD_TD(r);
+
+    // e^(+-x_sqr) = 2^e * y with 1/sqrt(2) < y < sqrt(2).
+    *e = (sign < 0.0) ? -(int)k_dbl : (int)k_dbl;
+    return add_TD_D_TD(expm1_TD(r), 1.0);
+}
+
+double
+expxsqr_td(const DD x_sqr, const double sign) {
+    atomic_fetch_add_explicit(&escalations, 1, memory_order_relaxed);
+
+    int e;
+    TD y = expxsqr_td_scaled(x_sqr, sign, &e);
+
+    // Round to double and apply the scale factor 2^e as 2^(e/2) * 2^(e - e/2), which is exact for the rounded result.  If the
+    // result is subnormal, y is rounded instead to the multiples of 2^(-1074 - e):  y + c, where c = 2^(-1022 - e) > y, is rounded
+    // to double and c is subtracted exactly.
+    double result;
+    if (e <= DBL_MIN_EXP && TD_HI(y) < power_2(DBL_MIN_EXP - 1 - e)) {
+        const double c = power_2(DBL_MIN_EXP - 1 - e);
+        result = round_TD_D(add_TD_D_TD(y, c)) - c;
+    } else {
+        result = round_TD_D(y);
+    }
+    return (result * power_2(e / 2)) * power_2(e - e / 2);
+}
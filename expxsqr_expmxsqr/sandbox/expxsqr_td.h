@@ -0,0 +1,40 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+
+// The triple-double evaluation of expxsqr_td.c before its final rounding, for code that needs more than the rounded result (the
+// fast reference of test_accuracy -t).  It is kept out of expxsqr.h so that the installed headers do not need TD_arithmetic.h.
+
+#if !defined(_EXPXSQR_TD_H)
+#define _EXPXSQR_TD_H 1
+
+#include "DD_arithmetic.h"
+#include "TD_arithmetic.h"
+
+// The bound on the relative error of expxsqr_td_scaled() assumed by its users:  2^-150 is estimated (see expxsqr_td.c) and at
+// most 2^-153 was measured, so this leaves a margin of 2^10.
+#define EXPXSQR_TD_REL_ERR 0x1.0p-140
+
+// Returns y and sets *e so that e^(sign * x_sqr) = 2^*e * y with 1/sqrt(2) < y < sqrt(2), to a relative error below
+// EXPXSQR_TD_REL_ERR, for sign = +1.0 or -1.0 and |x_sqr| < 1400.
+TD expxsqr_td_scaled(const DD x_sqr, const double sign, int* e);
+
+#endif // _EXPXSQR_TD_H
@@ -0,0 +1,98 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Calculate e^(x*x) in single precision.
+
+// This follows expxsqr() in expxsqr.c with float in place of double.  Since only a faithfully rounded float is needed, the
+// reduction uses C = log(2)/16, the table of 2^(j/16) has 16 float-float entries and e^r - 1 is a degree 4 polynomial.  x*x is
+// formed exactly in float-float and its low part is folded into the reduced argument.
+
+// Requires FMA instruction.
+// Uses #pragma GCC unroll N
+
+// References:
+//  [1] S. Boldo, M. Daumas, and R.-C. Li, “Formally Verified Argument Reduction with a Fused Multiply-Add,” IEEE Transactions on Computers, vol. 58, no. 8, pp. 1139–1145, 2009, doi: 10.1109/TC.2008.216.
+//  [2] J. M. Muller, Elementary functions: algorithms and implementation, Third edition. Boston: Birkhäuser, 2016.
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+
+#include "FF_arithmetic.h"
+#include "expxsqr_tables.h"
+
+typedef union {
+    float f;
+    uint32_t ui32;
+} IEEE_BIN32_UNION;
+
+float
+expxsqrf(const float x) {
+
+    // Screen for special values
+    if (isnan(x)) return x + x; // Raise FE_INVALID if x is a signalling NaN.
+    FF x_sqr = sqr_F_FF(x);
+    // For |x| < 2.44140625e-04 (x^2 < 5.96046448e-08 = 2^-24), expxsqrf(x) is 1.0
+    if (FF_HI(x_sqr) < 0x1.000002p-24f) return 1.0f;
+    // For |x| > 9.41928005 (x^2 > 88.7228367), expxsqrf(x) is Inf.  Near this point FF_HI(x_sqr) alone cannot tell which side of
+    // the threshold x^2 lies, so the test is on x.
+    if (fabsf(x) > 0x1.2d6abep+3f) return INFINITY;
+
+    // Calculate the reduced argument:  r = x - k * C where C = log(2)/16 and k = nearestint(x/C).  Thus |r| <= log(2)/32.
+    // See see Ref [2], section 11.2.2, algorithm 23.  Also see Ref [1], algorithms 5.1 and 5.2.
+    const float CONST = 0x1.8p23f;                              // 3.0 * 2^(FLT_MANT_DIG - 2) = 12582912.
+    const float R = 0x1.715476p4f;                              // 1 / (log(2)/16) = 23.083120346069336.
+    const float C1 = 0x1.62e43p-5f;                             // 1/R rounded to FLT_MANT_DIG - 2 digits = 4.3321698904037476e-2.
+    const float C2 = -0x1.05c61p-33f;                           // C - C1 = -1.1904088825787085e-10.
+    float k_flt = fmaf(FF_HI(x_sqr), R, CONST) - CONST;        // Round to nearest integer.
+    int k = (int)k_flt;
+    int m = k / 16;
+    int j = k % 16;
+    float temp1 = fmaf(-k_flt, C1, FF_HI(x_sqr));
+    float r_hi = fmaf(-k_flt, C2, temp1);
+    FF temp2 = mul_F_F_FF(k_flt, C2);
+    FF temp3 = fast_add_F_F_FF(temp1, -FF_HI(temp2));
+    float r_lo = ((FF_HI(temp3) - r_hi) + FF_LO(temp3)) - FF_LO(temp2);
+    // Relative to 2^-24, FF_LO(x_sqr) is too large to be handled by a separate first order factor as in expxsqr(), so add it to
+    // the reduced argument.
+    FF r = add_F_F_FF(r_hi, r_lo + FF_LO(x_sqr));
+
+    // Evaluate e^(j/16)*e^r.
+    const int N = sizeof(expxsqrf_coeffs) / sizeof(expxsqrf_coeffs[0]);
+    temp1 = expxsqrf_coeffs[0];
+#if defined(__OPTIMIZE__)
+#pragma GCC unroll N
+#endif
+    for (int i = 1; i < N; i++) {
+        temp1 = fmaf(FF_HI(r), temp1, expxsqrf_coeffs[i]);
+    }
+    temp1 = FF_HI(r) + (FF_LO(r) + (FF_HI(r) * FF_HI(r) * temp1)); // temp1 = e^r - 1.
+    float temp4 = expxsqrf_power_2_hi[j] + fmaf(expxsqrf_power_2_hi[j], temp1, expxsqrf_power_2_lo[j]);
+
+    // Apply the scale factor 2^m.
+    // Since values of |x| for which expxsqrf(x) overflows have been screened out, this manipulation will produce a finite value
+    // (or Inf if the product rounds up to 2^128).
+    IEEE_BIN32_UNION result; // "Safe in C" type-punning.
+    result.f = temp4;
+    result.ui32 = result.ui32 + ((uint32_t)(m) << (FLT_MANT_DIG - 1));
+
+    return result.f;
+}
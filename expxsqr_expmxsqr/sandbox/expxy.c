@@ -0,0 +1,58 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+
+// Calculate e^(x*y) and e^(-x*y).
+
+// Rounding x*y before taking the exponential costs up to |x*y| * 2^-53 in relative error, i.e. several ulps of the result once
+// |x*y| is in the hundreds.  As expxsqr() does with x*x, the product is instead formed exactly as a double-double with
+// mul_D_D_DD() and passed to exp_DD_DD() (exp_DD.h), which uses the reduction and tables of expxsqr(); the result is the high part
+// of its double-double value.  Since the relative error of that value is below 2^-63, the result is correctly rounded unless e^(x*y)
+// is within 2^-10 ulp of a rounding boundary.  Where the result is subnormal, it is the high part rounded a second time by the final
+// scaling, as in expmxsqr(), so the error is below 0.75 ulp (plus the 2^-10 ulp).
+
+// Requires FMA instruction.
+
+#include <math.h>
+
+#include "DD_arithmetic.h"
+#include "exp_DD.h"
+#include "expxy.h"
+
+// e^p for p = p_hi + fma(x, y, -p_hi).  The overflow and underflow screening is done on p_hi before the low part is calculated, so
+// that fma() does not raise FE_INVALID for an infinite product.
+static inline double
+exp_product(const double x, const double y, const double p_hi) {
+    // For x*y > 709.78271289338386 the result is Inf, and for x*y < -745.13321910194111 it is 0.0.
+    if (!(p_hi <= EXP_DD_MAX)) return (isnan(p_hi)) ? p_hi : INFINITY;
+    if (p_hi < EXP_DD_MIN) return 0.0;
+    return DD_HI(exp_DD_DD(load_D_D_DD(p_hi, fma(x, y, -p_hi))));
+}
+
+double
+expxy(const double x, const double y) {
+    return exp_product(x, y, x * y);
+}
+
+double
+expmxy(const double x, const double y) {
+    return exp_product(-x, y, -x * y);
+}
@@ -0,0 +1,58 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+
+// e^(x*y) and e^(-x*y) with the product formed exactly, built on the double-double exponential of exp_DD.h.
+
+#if !defined(_EXPXY_H)
+#define _EXPXY_H 1
+
+#include <stddef.h>
+
+// e^(x*y) and e^(-x*y) (expxy.c).  The error is below 0.5 + 2^-10 ulp, or 0.75 + 2^-10 ulp if the result is subnormal.
+double expxy(const double x, const double y);
+double expmxy(const double x, const double y);
+
+// z[i] = e^(x[i]*y[i]) and z[i] = e^(-x[i]*y[i]) for i = 0, 1, ... n-1 (expxsqr_array.c).
+void expxy_array(const double* x, const double* y, double* z, const size_t n);
+void expmxy_array(const double* x, const double* y, double* z, const size_t n);
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+
+// Four-lane AVX2/FMA versions (expxy_avx2.c).
+__m256d expxy_avx2(const __m256d x, const __m256d y);
+__m256d expmxy_avx2(const __m256d x, const __m256d y);
+void expxy_array_avx2(const double* x, const double* y, double* z, const size_t n);
+void expmxy_array_avx2(const double* x, const double* y, double* z, const size_t n);
+#endif
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+
+// Eight-lane AVX-512 versions (expxy_avx512.c).
+__m512d expxy_avx512(const __m512d x, const __m512d y);
+__m512d expmxy_avx512(const __m512d x, const __m512d y);
+void expxy_array_avx512(const double* x, const double* y, double* z, const size_t n);
+void expmxy_array_avx512(const double* x, const double* y, double* z, const size_t n);
+#endif
+
+#endif // _EXPXY_H
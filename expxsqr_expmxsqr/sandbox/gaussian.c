@@ -0,0 +1,114 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Calculate A * e^(-(x - mu)^2 / (2 * sigma^2)).
+
+// The argument of the exponential, z = ((x - mu) / (sigma * sqrt(2)))^2, is formed in double-double:  x - mu is exact, and the
+// product with the double-double reciprocal of sigma * sqrt(2) and the squaring are done with mul_DD_DD_DD.  z then goes through
+// the same reduction and polynomial as expmxsqr(); its low part takes the place of DD_LO(x_sqr).  The amplitude is applied to the
+// double-double value of e^-z before it is rounded, and the scale factor 2^(amp_expo - m) last, so the result has the accuracy of
+// expmxsqr() rather than that of a product of two rounded values.
+
+// Requires FMA instruction.
+// Uses #pragma GCC unroll N
+
+// References:
+//  [1] S. Boldo, M. Daumas, and R.-C. Li, “Formally Verified Argument Reduction with a Fused Multiply-Add,” IEEE Transactions on Computers, vol. 58, no. 8, pp. 1139–1145, 2009, doi: 10.1109/TC.2008.216.
+//  [2] J. M. Muller, Elementary functions: algorithms and implementation, Third edition. Boston: Birkhäuser, 2016.
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+
+#include "DD_arithmetic.h"
+#include "exp_DD.h"
+#include "expxsqr_tables.h"
+#include "gaussian.h"
+
+typedef union {
+    double d;
+    uint64_t ui64;
+} IEEE_BIN64_UNION;
+
+gaussian_params
+gaussian_setup(const double A, const double mu, const double sigma) {
+    const DD SQRT_2 = {0x1.6a09e667f3bcdp0, -0x1.bdd3413b26456p-54}; // sqrt(2) in double-double.
+    gaussian_params params;
+    params.mu = mu;
+    params.amp = A;
+    params.scale = div_DD_DD_DD(load_D_D_DD(1.0, 0.0), mul_DD_D_DD(SQRT_2, fabs(sigma)));
+    params.amp_mant = 2.0 * frexp(A, &params.amp_expo);
+    params.amp_expo = params.amp_expo - 1;
+    return params;
+}
+
+// Multiply r by 2^n.  |r| is in [0.5, 4), and n <= 1023.  The result is rounded only once, even if it is subnormal.
+static inline double
+scale_result(const double r, const int n) {
+    IEEE_BIN64_UNION scale;
+    if (n >= -1020) { // r * 2^n is normal (or overflows).
+        scale.ui64 = (uint64_t)(n + 1023) << (DBL_MANT_DIG - 1);
+        return r * scale.d;
+    }
+    if (n >= -2040) { // r * 2^(n + 1020) is normal; the multiplication by 2^-1020 may produce a subnormal or zero result.
+        scale.ui64 = (uint64_t)(n + 1020 + 1023) << (DBL_MANT_DIG - 1);
+        return (r * scale.d) * 0x1.0p-1020;
+    }
+    return 0.0 * r; // |r * 2^n| < 2^-2038.
+}
+
+double
+gaussian_kernel(const double x, const gaussian_params* params) {
+
+    // Screen for special values.
+    if (isnan(x)) return x + params->amp_mant; // Raise FE_INVALID if x is a signalling NaN.
+
+    // Calculate t = (x - mu) * scale in double-double.
+    DD t = mul_DD_DD_DD(add_D_D_DD(x, -params->mu), params->scale);
+    // For |t| > 38.25 (z = t^2 > 1463.0625) the result is less than 2^1024 * e^-1463 < 2^-1075 for any finite A.  This also handles
+    // x == +-INFINITY and overflow in x - mu or in the product, both of which make DD_HI(t) Inf or NaN.
+    if (!(fabs(DD_HI(t)) <= 0x1.32p+5)) return 0.0 * params->amp_mant;
+
+    // Calculate z = t^2 in double-double.
+    DD z = mul_DD_DD_DD(t, t);
+    // For z < 5.5511151231257852e-17, e^-z is 1.0 and the result is A.
+    if (DD_HI(z) < 0x1.0000000000002p-54) return params->amp;
+
+    // Calculate the reduced argument:  z = k*C + r_hi + r_lo + DD_LO(z) where C = log(2)/T and k = nearestint(z/C) = m*T + j.  Thus
+    // |r_hi| <= log(2)/(2T).  See reduce_D() and reduced_arg_DD() in exp_DD.h.
+    int m, j;
+    double k_dbl = reduce_D(DD_HI(z), &m, &j);
+    DD r = reduced_arg_DD(DD_HI(z), k_dbl);
+
+    // Combine to make e^(-j/T)*e^-(r + DD_LO(z)) = 2^m * e^-z (see reconstruct_accurate_DD() in exp_DD.h) and apply the mantissa of
+    // the amplitude.
+    DD temp4 = reconstruct_accurate_DD(r, DD_LO(z), expmxsqr_power_2[j], -1.0);
+    temp4 = mul_DD_D_DD(temp4, params->amp_mant);
+
+    // Apply the scale factor 2^(amp_expo - m).
+    return scale_result(DD_HI(temp4), params->amp_expo - m);
+}
+
+double
+gaussian(const double x, const double A, const double mu, const double sigma) {
+    gaussian_params params = gaussian_setup(A, mu, sigma);
+    return gaussian_kernel(x, &params);
+}
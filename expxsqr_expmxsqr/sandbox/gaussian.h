@@ -0,0 +1,58 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Scaled Gaussian A * e^(-(x - mu)^2 / (2 * sigma^2)) built on the e^(-x*x) argument reduction.
+
+#if !defined(_GAUSSIAN_H)
+#define _GAUSSIAN_H 1
+
+#include <stddef.h>
+
+#include "DD_arithmetic.h"
+
+// The per-call constants of a Gaussian, computed once by gaussian_setup() and shared by every point.
+typedef struct {
+    double mu;
+    DD scale;           // 1 / (sigma * sqrt(2)) in double-double.
+    double amp;         // A
+    double amp_mant;    // A = amp_mant * 2^amp_expo with 1 <= |amp_mant| < 2 (amp_mant = 0 if A = 0).
+    int amp_expo;
+} gaussian_params;
+
+// gaussian(x, A, mu, sigma) is gaussian_kernel(x, &params) with params = gaussian_setup(A, mu, sigma); the same requirements apply.
+gaussian_params gaussian_setup(const double A, const double mu, const double sigma);
+double gaussian_kernel(const double x, const gaussian_params* params);
+
+// A * e^(-(x - mu)^2 / (2 * sigma^2)).  A must be finite and sigma finite and non-zero.
+double gaussian(const double x, const double A, const double mu, const double sigma);
+
+// y[i] = gaussian(x[i], A, mu, sigma) for i = 0, 1, ... n-1 (expxsqr_array.c).
+void gaussian_array(const double* x, double* y, const size_t n, const double A, const double mu, const double sigma);
+
+#if defined(__AVX2__) && defined(__FMA__)
+void gaussian_array_avx2(const double* x, double* y, const size_t n, const double A, const double mu, const double sigma);
+#endif
+
+#if defined(__AVX512F__)
+void gaussian_array_avx512(const double* x, double* y, const size_t n, const double A, const double mu, const double sigma);
+#endif
+
+#endif // _GAUSSIAN_H
@@ -0,0 +1,106 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Calculate A * e^(-(x - mu)^2 / (2 * sigma^2)) for four arguments at a time using AVX2 and FMA instructions.
+
+// This is a lane-by-lane transcription of gaussian_kernel() in gaussian.c; each lane produces the same bits as the scalar function.
+
+// Requires AVX2 and FMA instructions.
+// Uses #pragma GCC unroll N
+
+// References:
+//  [1] S. Boldo, M. Daumas, and R.-C. Li, “Formally Verified Argument Reduction with a Fused Multiply-Add,” IEEE Transactions on Computers, vol. 58, no. 8, pp. 1139–1145, 2009, doi: 10.1109/TC.2008.216.
+//  [2] J. M. Muller, Elementary functions: algorithms and implementation, Third edition. Boston: Birkhäuser, 2016.
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "DD_arithmetic.h"
+#include "DD_arithmetic_avx2.h"
+#include "exp_DD_avx2.h"
+#include "expxsqr_tables.h"
+#include "gaussian.h"
+
+static inline __m256d
+gaussian_avx2(const __m256d x, const gaussian_params* params) {
+
+    // Screen for special values.  See gaussian_kernel().
+    const __m256d amp_mant = _mm256_set1_pd(params->amp_mant);
+    __m256d is_nan = _mm256_cmp_pd(x, x, _CMP_UNORD_Q);
+    const DD4 scale = load_D4_D4_DD4(_mm256_set1_pd(DD_HI(params->scale)), _mm256_set1_pd(DD_LO(params->scale)));
+    DD4 t = mul_DD4_DD4_DD4(add_D4_D4_DD4(x, _mm256_set1_pd(-params->mu)), scale);
+    __m256d abs_t = _mm256_andnot_pd(_mm256_set1_pd(-0.0), DD4_HI(t));
+    __m256d is_zero = _mm256_andnot_pd(is_nan, _mm256_cmp_pd(abs_t, _mm256_set1_pd(0x1.32p+5), _CMP_NLE_UQ));
+    DD4 z = mul_DD4_DD4_DD4(t, t);
+    __m256d is_amp = _mm256_cmp_pd(DD4_HI(z), _mm256_set1_pd(0x1.0000000000002p-54), _CMP_LT_OQ);
+    __m256d is_special = _mm256_or_pd(is_nan, _mm256_or_pd(is_amp, is_zero));
+    __m256d special_result = _mm256_blendv_pd(_mm256_mul_pd(_mm256_setzero_pd(), amp_mant), _mm256_set1_pd(params->amp), is_amp);
+    special_result = _mm256_blendv_pd(special_result, _mm256_add_pd(x, amp_mant), is_nan); // Raise FE_INVALID if x is a signalling NaN.
+    z = load_D4_D4_DD4(_mm256_andnot_pd(is_special, DD4_HI(z)), _mm256_andnot_pd(is_special, DD4_LO(z)));
+
+    // Calculate the reduced argument:  z = k*C + r_hi + r_lo + DD_LO(z) where C = log(2)/T and k = nearestint(z/C) = m*T + j.  Thus
+    // |r_hi| <= log(2)/(2T).  See reduce_D4() and reduced_arg_DD4() in exp_DD_avx2.h.
+    __m256i m, j;
+    __m256d k_dbl = reduce_D4(DD4_HI(z), &m, &j);
+    DD4 r = reduced_arg_DD4(DD4_HI(z), k_dbl);
+
+    // Combine to make e^(-j/T)*e^-(r + DD_LO(z)) = 2^m * e^-z (see reconstruct_accurate_DD4() in exp_DD_avx2.h) and apply the
+    // mantissa of the amplitude.
+    DD4 temp4 = reconstruct_accurate_DD4(r, DD4_LO(z), (const double*)expmxsqr_power_2, j, _mm256_set1_pd(-1.0));
+    temp4 = mul_DD4_D4_DD4(temp4, amp_mant);
+
+    // Apply the scale factor 2^n with n = amp_expo - m as (r * 2^n1) * f2, where
+    //   n >= -1020:          n1 = n,         f2 = 1.0
+    //   -2040 <= n < -1020:  n1 = n + 1020,  f2 = 2^-1020 (this multiplication may produce a subnormal or zero result)
+    //   n < -2040:           n1 = -1020,     f2 = 0.0
+    // which is the same sequence of operations as scale_result() in gaussian.c.
+    __m256i n = _mm256_sub_epi64(_mm256_set1_epi64x(params->amp_expo), m);
+    __m256i is_normal_n = _mm256_cmpgt_epi64(n, _mm256_set1_epi64x(-1021));
+    __m256i is_sub_n = _mm256_andnot_si256(is_normal_n, _mm256_cmpgt_epi64(n, _mm256_set1_epi64x(-2041)));
+    __m256i n1 = _mm256_blendv_epi8(_mm256_set1_epi64x(-1020), _mm256_add_epi64(n, _mm256_set1_epi64x(1020)), is_sub_n);
+    n1 = _mm256_blendv_epi8(n1, n, is_normal_n);
+    __m256d f2 = _mm256_blendv_pd(_mm256_setzero_pd(), _mm256_set1_pd(0x1.0p-1020), _mm256_castsi256_pd(is_sub_n));
+    f2 = _mm256_blendv_pd(f2, _mm256_set1_pd(1.0), _mm256_castsi256_pd(is_normal_n));
+    __m256d scale_n1 = _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_add_epi64(n1, _mm256_set1_epi64x(1023)), DBL_MANT_DIG - 1));
+    __m256d result = _mm256_mul_pd(_mm256_mul_pd(DD4_HI(temp4), scale_n1), f2);
+
+    return _mm256_blendv_pd(result, special_result, is_special);
+}
+
+// Calculate y[i] = A * e^(-(x[i] - mu)^2 / (2 * sigma^2)) for i = 0, 1, ... n-1.  The last n%4 elements are handled with masked loads
+// and stores.
+void
+gaussian_array_avx2(const double* x, double* y, const size_t n, const double A, const double mu, const double sigma) {
+    const gaussian_params params = gaussian_setup(A, mu, sigma);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(&y[i], gaussian_avx2(_mm256_loadu_pd(&x[i]), &params));
+    }
+    if (i < n) {
+        __m256i mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x((long long)(n - i)), _mm256_set_epi64x(3, 2, 1, 0));
+        _mm256_maskstore_pd(&y[i], mask, gaussian_avx2(_mm256_maskload_pd(&x[i], mask), &params));
+    }
+    return;
+}
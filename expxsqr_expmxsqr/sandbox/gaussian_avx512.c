@@ -0,0 +1,107 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Calculate A * e^(-(x - mu)^2 / (2 * sigma^2)) for eight arguments at a time using AVX-512F instructions.
+
+// This is a lane-by-lane transcription of gaussian_kernel() in gaussian.c; each lane produces the same bits as the scalar function.
+
+// Requires AVX-512F instructions.
+// Uses #pragma GCC unroll N
+
+// References:
+//  [1] S. Boldo, M. Daumas, and R.-C. Li, “Formally Verified Argument Reduction with a Fused Multiply-Add,” IEEE Transactions on Computers, vol. 58, no. 8, pp. 1139–1145, 2009, doi: 10.1109/TC.2008.216.
+//  [2] J. M. Muller, Elementary functions: algorithms and implementation, Third edition. Boston: Birkhäuser, 2016.
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <immintrin.h>
+
+#include "DD_arithmetic.h"
+#include "DD_arithmetic_avx512.h"
+#include "exp_DD_avx512.h"
+#include "expxsqr_tables.h"
+#include "gaussian.h"
+
+static inline __m512d
+gaussian_avx512(const __m512d x, const gaussian_params* params) {
+
+    // Screen for special values.  See gaussian_kernel().
+    const __m512d amp_mant = _mm512_set1_pd(params->amp_mant);
+    __mmask8 is_nan = _mm512_cmp_pd_mask(x, x, _CMP_UNORD_Q);
+    const DD8 scale = load_D8_D8_DD8(_mm512_set1_pd(DD_HI(params->scale)), _mm512_set1_pd(DD_LO(params->scale)));
+    DD8 t = mul_DD8_DD8_DD8(add_D8_D8_DD8(x, _mm512_set1_pd(-params->mu)), scale);
+    __mmask8 is_zero = ~is_nan & _mm512_cmp_pd_mask(_mm512_abs_pd(DD8_HI(t)), _mm512_set1_pd(0x1.32p+5), _CMP_NLE_UQ);
+    DD8 z = mul_DD8_DD8_DD8(t, t);
+    __mmask8 is_amp = _mm512_cmp_pd_mask(DD8_HI(z), _mm512_set1_pd(0x1.0000000000002p-54), _CMP_LT_OQ);
+    __mmask8 is_normal = ~(is_nan | is_amp | is_zero);
+    z = load_D8_D8_DD8(_mm512_maskz_mov_pd(is_normal, DD8_HI(z)), _mm512_maskz_mov_pd(is_normal, DD8_LO(z)));
+
+    // Calculate the reduced argument:  z = k*C + r_hi + r_lo + DD_LO(z) where C = log(2)/T and k = nearestint(z/C) = m*T + j.  Thus
+    // |r_hi| <= log(2)/(2T).  See reduce_D8() and reduced_arg_DD8() in exp_DD_avx512.h.
+    __m512i m, j;
+    __m512d k_dbl = reduce_D8(DD8_HI(z), &m, &j);
+    DD8 r = reduced_arg_DD8(DD8_HI(z), k_dbl);
+
+    // Combine to make e^(-j/T)*e^-(r + DD_LO(z)) = 2^m * e^-z (see reconstruct_accurate_DD8() in exp_DD_avx512.h) and apply the
+    // mantissa of the amplitude.
+    DD8 temp4 = reconstruct_accurate_DD8(r, DD8_LO(z), (const double*)expmxsqr_power_2, j, _mm512_set1_pd(-1.0));
+    temp4 = mul_DD8_D8_DD8(temp4, amp_mant);
+
+    // Apply the scale factor 2^n with n = amp_expo - m as (r * 2^n1) * f2, where
+    //   n >= -1020:          n1 = n,         f2 = 1.0
+    //   -2040 <= n < -1020:  n1 = n + 1020,  f2 = 2^-1020 (this multiplication may produce a subnormal or zero result)
+    //   n < -2040:           n1 = -1020,     f2 = 0.0
+    // which is the same sequence of operations as scale_result() in gaussian.c.
+    __m512i n = _mm512_sub_epi64(_mm512_set1_epi64(params->amp_expo), m);
+    __mmask8 is_normal_n = _mm512_cmpgt_epi64_mask(n, _mm512_set1_epi64(-1021));
+    __mmask8 is_sub_n = ~is_normal_n & _mm512_cmpgt_epi64_mask(n, _mm512_set1_epi64(-2041));
+    __m512i n1 = _mm512_mask_add_epi64(_mm512_set1_epi64(-1020), is_sub_n, n, _mm512_set1_epi64(1020));
+    n1 = _mm512_mask_mov_epi64(n1, is_normal_n, n);
+    __m512d f2 = _mm512_mask_mov_pd(_mm512_maskz_mov_pd(is_sub_n, _mm512_set1_pd(0x1.0p-1020)), is_normal_n, _mm512_set1_pd(1.0));
+    __m512d scale_n1 = _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_add_epi64(n1, _mm512_set1_epi64(1023)), DBL_MANT_DIG - 1));
+    __m512d result = _mm512_mul_pd(_mm512_mul_pd(DD8_HI(temp4), scale_n1), f2);
+
+    // Merge in the results for the special lanes.
+    result = _mm512_mask_mov_pd(result, is_amp, _mm512_set1_pd(params->amp));
+    result = _mm512_mask_mul_pd(result, is_zero, _mm512_setzero_pd(), amp_mant);
+    result = _mm512_mask_add_pd(result, is_nan, x, amp_mant); // Raise FE_INVALID if x is a signalling NaN.
+
+    return result;
+}
+
+// Calculate y[i] = A * e^(-(x[i] - mu)^2 / (2 * sigma^2)) for i = 0, 1, ... n-1.  The last n%8 elements are handled with masked loads
+// and stores.
+void
+gaussian_array_avx512(const double* x, double* y, const size_t n, const double A, const double mu, const double sigma) {
+    const gaussian_params params = gaussian_setup(A, mu, sigma);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm512_storeu_pd(&y[i], gaussian_avx512(_mm512_loadu_pd(&x[i]), &params));
+    }
+    if (i < n) {
+        __mmask8 mask = (__mmask8)((1U << (n - i)) - 1U);
+        _mm512_mask_storeu_pd(&y[i], mask, gaussian_avx512(_mm512_maskz_loadu_pd(mask, &x[i]), &params));
+    }
+    return;
+}
@@ -0,0 +1,415 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Generate the double-precision tables of expxsqr_tables.h for a table size T = 2^b:  the reduction constants R, C1 and C2 for
+// C = log(2)/T, the double-double tables of 2^(j/T) and 2^(-j/T), and minimax coefficients of e^x - 1 = x + 0.5 * x^2 + ... for
+// |x| <= log(2)/(2T).  The polynomial degree is the smallest one whose error is below max_error.
+//
+// The output is written to stdout and is meant to be included through expxsqr_tables.h with -DEXPXSQR_TABLES='"file"' (see
+// sweep_tables).  For T = 32 the reduction constants and tables are identical to the built-in ones.
+
+// References:
+//  [1] S. Boldo, M. Daumas, and R.-C. Li, “Formally Verified Argument Reduction with a Fused Multiply-Add,” IEEE Transactions on Computers, vol. 58, no. 8, pp. 1139–1145, 2009, doi: 10.1109/TC.2008.216.
+//  [2] J. M. Muller, Elementary functions: algorithms and implementation, Third edition. Boston: Birkhäuser, 2016.
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <mpfr.h>
+
+static const mpfr_prec_t PREC = 256;
+static const int MAX_DEGREE = 12;
+static const int GRID_SIZE = 1000;
+static const int LAWSON_ITERATIONS = 200;
+
+// Print a double as 0x1.hhhhhhhhhhhhhp<e> (always 13 hex digits, no '+' in the exponent) to match the hand-written tables.
+static void
+format_hex(char* buffer, size_t size, double d) {
+    if (d == 0.0) {
+        snprintf(buffer, size, "%s0x0.0000000000000p0", signbit(d) ? "-" : "");
+        return;
+    }
+    int expo;
+    double mant = frexp(fabs(d), &expo); // 0.5 <= mant < 1.0
+    unsigned long long bits = (unsigned long long)ldexp(mant, DBL_MANT_DIG) & ((1ULL << (DBL_MANT_DIG - 1)) - 1);
+    snprintf(buffer, size, "%s0x1.%013llxp%d", (d < 0.0) ? "-" : "", bits, expo - 1);
+    return;
+}
+
+// Print a decimal value as 1.23456789012345678e-3 to match the hand-written coefficient comments.
+static void
+format_dec(char* buffer, size_t size, double d) {
+    char temp[32];
+    snprintf(temp, sizeof(temp), "%.17e", d);
+    char* e = strchr(temp, 'e');
+    *e = '\0';
+    snprintf(buffer, size, "%se%d", temp, atoi(e + 1));
+    return;
+}
+
+// Print the exact decimal value of hi + lo.
+static void
+format_exact(char* buffer, size_t size, double hi, double lo) {
+    mpfr_t sum;
+    mpfr_init2(sum, 2 * DBL_MANT_DIG + 64);
+    mpfr_set_d(sum, hi, MPFR_RNDN);
+    mpfr_add_d(sum, sum, lo, MPFR_RNDN); // Exact.
+    // The value is a multiple of 2^(e - prec), so it has at most prec - e + 1 nonzero decimal places.
+    long places = (long)mpfr_get_prec(sum) - (long)mpfr_get_exp(sum) + 1;
+    mpfr_snprintf(buffer, size, "%.*Rf", (int)places, sum);
+    char* p = buffer + strlen(buffer) - 1;
+    while (*p == '0' && *(p - 1) != '.') *p-- = '\0';
+    mpfr_clear(sum);
+    return;
+}
+
+// err(x) = e^x - 1 - (x + 0.5 * x^2 + x^3 * (c[0] + c[1] * x + ... + c[n-1] * x^(n-1)))
+static void
+poly_error(mpfr_ptr err, mpfr_srcptr x, mpfr_t c[], const int n) {
+    mpfr_t p;
+    mpfr_init2(p, PREC);
+    mpfr_set(p, c[n - 1], MPFR_RNDN);
+    for (int i = n - 2; i >= 0; i--) {
+        mpfr_fma(p, p, x, c[i], MPFR_RNDN);
+    }
+    mpfr_mul(p, p, x, MPFR_RNDN);
+    mpfr_add_d(p, p, 0.5, MPFR_RNDN);
+    mpfr_mul(p, p, x, MPFR_RNDN);
+    mpfr_add_ui(p, p, 1, MPFR_RNDN);
+    mpfr_mul(p, p, x, MPFR_RNDN);
+    mpfr_expm1(err, x, MPFR_RNDN);
+    mpfr_sub(err, err, p, MPFR_RNDN);
+    mpfr_clear(p);
+    return;
+}
+
+// Maximize sign * err(x) on [lo, hi] by golden-section search.  The result is left in x.
+static void
+refine_extremum(mpfr_ptr x, mpfr_srcptr lo, mpfr_srcptr hi, const int sign, mpfr_t c[], const int n) {
+    const double GOLDEN = 0.6180339887498949;
+    mpfr_t a, b, x1, x2, e1, e2, t;
+    mpfr_inits2(PREC, a, b, x1, x2, e1, e2, t, (mpfr_ptr)NULL);
+    mpfr_set(a, lo, MPFR_RNDN);
+    mpfr_set(b, hi, MPFR_RNDN);
+    for (int iter = 0; iter < 60; iter++) {
+        mpfr_sub(t, b, a, MPFR_RNDN);
+        mpfr_mul_d(t, t, GOLDEN, MPFR_RNDN);
+        mpfr_sub(x1, b, t, MPFR_RNDN);
+        mpfr_add(x2, a, t, MPFR_RNDN);
+        poly_error(e1, x1, c, n);
+        poly_error(e2, x2, c, n);
+        if (sign < 0) {
+            mpfr_neg(e1, e1, MPFR_RNDN);
+            mpfr_neg(e2, e2, MPFR_RNDN);
+        }
+        if (mpfr_cmp(e1, e2) > 0) {
+            mpfr_set(b, x2, MPFR_RNDN);
+        } else {
+            mpfr_set(a, x1, MPFR_RNDN);
+        }
+    }
+    mpfr_add(x, a, b, MPFR_RNDN);
+    mpfr_div_ui(x, x, 2, MPFR_RNDN);
+    mpfr_clears(a, b, x1, x2, e1, e2, t, (mpfr_ptr)NULL);
+    return;
+}
+
+// Return max |err(x)| on [-a, a]:  each local maximum of |err| on a grid is refined by golden-section search.
+static double
+max_error(mpfr_srcptr a, mpfr_t c[], const int n) {
+    mpfr_t* grid = malloc((GRID_SIZE + 1) * sizeof(mpfr_t));
+    mpfr_t* err = malloc((GRID_SIZE + 1) * sizeof(mpfr_t));
+    for (int i = 0; i <= GRID_SIZE; i++) {
+        mpfr_inits2(PREC, grid[i], err[i], (mpfr_ptr)NULL);
+        mpfr_mul_si(grid[i], a, 2 * i - GRID_SIZE, MPFR_RNDN);
+        mpfr_div_ui(grid[i], grid[i], GRID_SIZE, MPFR_RNDN);
+        poly_error(err[i], grid[i], c, n);
+    }
+
+    mpfr_t x, e, max_err;
+    mpfr_inits2(PREC, x, e, max_err, (mpfr_ptr)NULL);
+    mpfr_set_ui(max_err, 0, MPFR_RNDN);
+    for (int i = 0; i <= GRID_SIZE; i++) {
+        if (i > 0 && mpfr_cmpabs(err[i], err[i - 1]) < 0) continue;
+        if (i < GRID_SIZE && mpfr_cmpabs(err[i], err[i + 1]) < 0) continue;
+        refine_extremum(x, grid[(i > 0) ? i - 1 : i], grid[(i < GRID_SIZE) ? i + 1 : i], mpfr_sgn(err[i]), c, n);
+        poly_error(e, x, c, n);
+        if (mpfr_cmpabs(e, max_err) > 0) mpfr_abs(max_err, e, MPFR_RNDN);
+    }
+    double result = mpfr_get_d(max_err, MPFR_RNDU);
+
+    mpfr_clears(x, e, max_err, (mpfr_ptr)NULL);
+    for (int i = 0; i <= GRID_SIZE; i++) {
+        mpfr_clears(grid[i], err[i], (mpfr_ptr)NULL);
+    }
+    free(grid);
+    free(err);
+    return result;
+}
+
+// Solve the n x n system a * x = b by Gaussian elimination with partial pivoting.  a and b are overwritten.
+static void
+solve(mpfr_t a[], mpfr_t b[], mpfr_t x[], const int n) {
+    mpfr_t t, u;
+    mpfr_inits2(PREC, t, u, (mpfr_ptr)NULL);
+    for (int col = 0; col < n; col++) {
+        int pivot = col;
+        for (int row = col + 1; row < n; row++) {
+            if (mpfr_cmpabs(a[row * n + col], a[pivot * n + col]) > 0) pivot = row;
+        }
+        if (pivot != col) {
+            for (int k = 0; k < n; k++) mpfr_swap(a[pivot * n + k], a[col * n + k]);
+            mpfr_swap(b[pivot], b[col]);
+        }
+        for (int row = col + 1; row < n; row++) {
+            mpfr_div(t, a[row * n + col], a[col * n + col], MPFR_RNDN);
+            for (int k = col; k < n; k++) {
+                mpfr_mul(u, t, a[col * n + k], MPFR_RNDN);
+                mpfr_sub(a[row * n + k], a[row * n + k], u, MPFR_RNDN);
+            }
+            mpfr_mul(u, t, b[col], MPFR_RNDN);
+            mpfr_sub(b[row], b[row], u, MPFR_RNDN);
+        }
+    }
+    for (int row = n - 1; row >= 0; row--) {
+        mpfr_set(t, b[row], MPFR_RNDN);
+        for (int k = row + 1; k < n; k++) {
+            mpfr_mul(u, a[row * n + k], x[k], MPFR_RNDN);
+            mpfr_sub(t, t, u, MPFR_RNDN);
+        }
+        mpfr_div(x[row], t, a[row * n + row], MPFR_RNDN);
+    }
+    mpfr_clears(t, u, (mpfr_ptr)NULL);
+    return;
+}
+
+// Minimax coefficients c[] of x^3, x^4, ... x^(n+2) for err(x) on [-a, a] by Lawson's algorithm (iteratively reweighted least
+// squares on a grid).  Remez exchange is not used because x^3, x^4, ... is not a Haar system on an interval containing zero:  the
+// references it finds become symmetric and the linear systems singular.  The coefficients are rounded to double, and the max error
+// of the rounded polynomial is returned.
+static double
+minimax(double c_dbl[], const int n, mpfr_srcptr a) {
+    // Work in t = x/a so that the basis functions t^3, t^4, ... are of similar size.
+    mpfr_t* t_pow = malloc((GRID_SIZE + 1) * n * sizeof(mpfr_t));
+    mpfr_t* f = malloc((GRID_SIZE + 1) * sizeof(mpfr_t));
+    mpfr_t* w = malloc((GRID_SIZE + 1) * sizeof(mpfr_t));
+    mpfr_t* mat = malloc(n * n * sizeof(mpfr_t));
+    mpfr_t* rhs = malloc(n * sizeof(mpfr_t));
+    mpfr_t* c = malloc(n * sizeof(mpfr_t));
+    mpfr_t x, e, u, w_sum;
+    mpfr_inits2(PREC, x, e, u, w_sum, (mpfr_ptr)NULL);
+    for (int i = 0; i <= GRID_SIZE; i++) {
+        mpfr_inits2(PREC, f[i], w[i], (mpfr_ptr)NULL);
+        mpfr_set_si(e, 2 * i - GRID_SIZE, MPFR_RNDN);
+        mpfr_div_ui(e, e, GRID_SIZE, MPFR_RNDN); // t
+        mpfr_mul(x, e, a, MPFR_RNDN);
+        for (int k = 0; k < n; k++) {
+            mpfr_init2(t_pow[i * n + k], PREC);
+            if (k == 0) {
+                mpfr_mul(t_pow[i * n], e, e, MPFR_RNDN);
+                mpfr_mul(t_pow[i * n], t_pow[i * n], e, MPFR_RNDN);
+            } else {
+                mpfr_mul(t_pow[i * n + k], t_pow[i * n + k - 1], e, MPFR_RNDN);
+            }
+        }
+        // f = e^x - 1 - x - 0.5 * x^2
+        mpfr_expm1(f[i], x, MPFR_RNDN);
+        mpfr_sub(f[i], f[i], x, MPFR_RNDN);
+        mpfr_mul(u, x, x, MPFR_RNDN);
+        mpfr_div_ui(u, u, 2, MPFR_RNDN);
+        mpfr_sub(f[i], f[i], u, MPFR_RNDN);
+        mpfr_set_ui(w[i], 1, MPFR_RNDN);
+    }
+    for (int k = 0; k < n * n; k++) mpfr_init2(mat[k], PREC);
+    for (int k = 0; k < n; k++) mpfr_inits2(PREC, rhs[k], c[k], (mpfr_ptr)NULL);
+
+    for (int iter = 0; iter < LAWSON_ITERATIONS; iter++) {
+        // Weighted least squares:  sum_i w_i * (f_i - sum_k c_k t_i^(k+3))^2 is minimized by the normal equations.
+        for (int k = 0; k < n * n; k++) mpfr_set_ui(mat[k], 0, MPFR_RNDN);
+        for (int k = 0; k < n; k++) mpfr_set_ui(rhs[k], 0, MPFR_RNDN);
+        for (int i = 0; i <= GRID_SIZE; i++) {
+            for (int k = 0; k < n; k++) {
+                mpfr_mul(u, w[i], t_pow[i * n + k], MPFR_RNDN);
+                for (int l = k; l < n; l++) {
+                    mpfr_fma(mat[k * n + l], u, t_pow[i * n + l], mat[k * n + l], MPFR_RNDN);
+                }
+                mpfr_fma(rhs[k], u, f[i], rhs[k], MPFR_RNDN);
+            }
+        }
+        for (int k = 0; k < n; k++) {
+            for (int l = 0; l < k; l++) mpfr_set(mat[k * n + l], mat[l * n + k], MPFR_RNDN);
+        }
+        solve(mat, rhs, c, n);
+
+        // w_i <- w_i * |err_i|, normalized.
+        mpfr_set_ui(w_sum, 0, MPFR_RNDN);
+        for (int i = 0; i <= GRID_SIZE; i++) {
+            mpfr_set(e, f[i], MPFR_RNDN);
+            for (int k = 0; k < n; k++) {
+                mpfr_mul(u, c[k], t_pow[i * n + k], MPFR_RNDN);
+                mpfr_sub(e, e, u, MPFR_RNDN);
+            }
+            mpfr_abs(e, e, MPFR_RNDN);
+            mpfr_mul(w[i], w[i], e, MPFR_RNDN);
+            mpfr_add(w_sum, w_sum, w[i], MPFR_RNDN);
+        }
+        for (int i = 0; i <= GRID_SIZE; i++) mpfr_div(w[i], w[i], w_sum, MPFR_RNDN);
+    }
+
+    // Back to x:  c_k = c~_k / a^(k+3).
+    mpfr_mul(u, a, a, MPFR_RNDN);
+    mpfr_mul(u, u, a, MPFR_RNDN);
+    for (int k = 0; k < n; k++) {
+        mpfr_div(c[k], c[k], u, MPFR_RNDN);
+        mpfr_mul(u, u, a, MPFR_RNDN);
+        c_dbl[k] = mpfr_get_d(c[k], MPFR_RNDN);
+        mpfr_set_d(c[k], c_dbl[k], MPFR_RNDN);
+    }
+    double result = max_error(a, c, n);
+
+    for (int i = 0; i <= GRID_SIZE; i++) {
+        mpfr_clears(f[i], w[i], (mpfr_ptr)NULL);
+        for (int k = 0; k < n; k++) mpfr_clear(t_pow[i * n + k]);
+    }
+    for (int k = 0; k < n * n; k++) mpfr_clear(mat[k]);
+    for (int k = 0; k < n; k++) mpfr_clears(rhs[k], c[k], (mpfr_ptr)NULL);
+    mpfr_clears(x, e, u, w_sum, (mpfr_ptr)NULL);
+    free(t_pow);
+    free(f);
+    free(w);
+    free(mat);
+    free(rhs);
+    free(c);
+    return result;
+}
+
+static void
+print_table(const char* name, const int table_size, const int sign) {
+    char hi_str[32], lo_str[32], exact[512];
+    mpfr_t v;
+    mpfr_init2(v, PREC);
+    printf("// Table of 2^(%sj/%d) in double-double for j = 0, 1, ... %d.\n", (sign < 0) ? "-" : "", table_size, table_size - 1);
+    printf("static const\n");
+    printf("DD %s[%d] __attribute__((aligned(64), unused)) = {\n", name, table_size);
+    for (int j = 0; j < table_size; j++) {
+        mpfr_set_si(v, sign * j, MPFR_RNDN);
+        mpfr_div_ui(v, v, table_size, MPFR_RNDN);
+        mpfr_exp2(v, v, MPFR_RNDN);
+        double hi = mpfr_get_d(v, MPFR_RNDN);
+        mpfr_sub_d(v, v, hi, MPFR_RNDN);
+        double lo = mpfr_get_d(v, MPFR_RNDN);
+        format_hex(hi_str, sizeof(hi_str), hi);
+        format_hex(lo_str, sizeof(lo_str), fabs(lo));
+        format_exact(exact, sizeof(exact), hi, lo);
+        printf("    {%s,%*s %c%s},%*s // %s\n", hi_str, 20 - (int)strlen(hi_str), "", (lo < 0.0) ? '-' : ' ', lo_str,
+               21 - (int)strlen(lo_str), "", exact);
+    }
+    printf("};\n");
+    mpfr_clear(v);
+    return;
+}
+
+int
+main(int argc, char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        printf("Usage:  %s table_size [max_error]\n", argv[0]);
+        return -1;
+    }
+    int table_size = atoi(argv[1]);
+    double max_error = (argc == 3) ? strtod(argv[2], NULL) : 1.0e-19; // About the error of the built-in T = 32 polynomial.
+    int table_bits = 0;
+    while ((1 << table_bits) < table_size) table_bits++;
+    if (table_size < 2 || table_size > 4096 || (1 << table_bits) != table_size) {
+        printf("table_size must be a power of 2 between 2 and 4096\n");
+        return -1;
+    }
+
+    // R = 1/C rounded to double, C1 = 1/R rounded to DBL_MANT_DIG - 2 digits and C2 = C - C1, where C = log(2)/T.  See Ref [1],
+    // algorithms 5.1 and 5.2.
+    mpfr_t c, t;
+    mpfr_inits2(PREC, c, t, (mpfr_ptr)NULL);
+    mpfr_const_log2(c, MPFR_RNDN);
+    mpfr_div_ui(c, c, table_size, MPFR_RNDN);
+    mpfr_ui_div(t, 1, c, MPFR_RNDN);
+    double R = mpfr_get_d(t, MPFR_RNDN);
+    mpfr_set_d(t, R, MPFR_RNDN);
+    mpfr_ui_div(t, 1, t, MPFR_RNDN);
+    mpfr_prec_round(t, DBL_MANT_DIG - 2, MPFR_RNDN);
+    double C1 = mpfr_get_d(t, MPFR_RNDN);
+    mpfr_sub_d(t, c, C1, MPFR_RNDN);
+    double C2 = mpfr_get_d(t, MPFR_RNDN);
+
+    // Polynomial for |x| <= log(2)/(2T), plus a little for the rounding of the reduced argument.
+    mpfr_t a;
+    mpfr_init2(a, PREC);
+    mpfr_div_ui(a, c, 2, MPFR_RNDN);
+    mpfr_mul_d(a, a, 1.0 + 0x1.0p-40, MPFR_RNDN);
+    double coeffs[MAX_DEGREE];
+    double coeffs_error = INFINITY;
+    int degree;
+    for (degree = 3; degree <= MAX_DEGREE; degree++) {
+        coeffs_error = minimax(coeffs, degree - 2, a);
+        if (coeffs_error <= max_error) break;
+    }
+    if (degree > MAX_DEGREE) {
+        printf("No polynomial of degree <= %d reaches a max error of %.2e\n", MAX_DEGREE, max_error);
+        return -1;
+    }
+
+    char hex[32], dec[64], exact[512];
+    printf("// Generated by \"make_tables %d %.2e\"; see make_tables.c.\n\n", table_size, max_error);
+    printf("#define EXPXSQR_TABLE_BITS %d\n", table_bits);
+    printf("#define EXPXSQR_TABLE_SIZE %d\n", table_size);
+    format_hex(hex, sizeof(hex), R);
+    format_exact(exact, sizeof(exact), R, 0.0);
+    printf("#define EXPXSQR_R  (%s)  // 1 / (log(2)/%d) = %s.\n", hex, table_size, exact);
+    format_hex(hex, sizeof(hex), C1);
+    printf("#define EXPXSQR_C1 (%s)  // 1/R rounded to DBL_MANT_DIG - 2 digits.\n", hex);
+    format_hex(hex, sizeof(hex), C2);
+    printf("#define EXPXSQR_C2 (%s) // C - C1.\n\n", hex);
+
+    printf("// Minimax coefficients of the polynomial x + 0.5 * x^2 + ... to calculate e^x - 1 for |x| <= log(2)/%d; max error ~ %.1e\n",
+           2 * table_size, coeffs_error);
+    printf("// Note that the array is in reverse order.\n");
+    // Rounded up, since EXPXSQR_CR_MAX_ERR (expxsqr_tables.h) is built on it:  the factor exceeds the rounding error of %.3e.
+    printf("#define EXPXSQR_COEFFS_MAX_ERR (%.3e)\n", coeffs_error * (1.0 + 0x1.0p-10));
+    printf("static const\n");
+    printf("double expxsqr_coeffs[%d] __attribute__((aligned(64), unused)) = {\n", degree - 1);
+    for (int i = degree - 3; i >= 0; i--) {
+        format_hex(hex, sizeof(hex), coeffs[i]);
+        format_dec(dec, sizeof(dec), coeffs[i]);
+        printf("    %s,%*s // %s  N = %d\n", hex, 22 - (int)strlen(hex), "", dec, i + 3);
+    }
+    format_hex(hex, sizeof(hex), 0.5);
+    format_dec(dec, sizeof(dec), 0.5);
+    printf("    %s,%*s // %s  N = 2\n", hex, 22 - (int)strlen(hex), "", dec);
+    printf("};\n\n");
+
+    print_table("expxsqr_power_2", table_size, 1);
+    printf("\n");
+    print_table("expmxsqr_power_2", table_size, -1);
+
+    mpfr_clears(c, t, a, (mpfr_ptr)NULL);
+    return 0;
+}
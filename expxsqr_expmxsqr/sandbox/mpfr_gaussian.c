@@ -0,0 +1,42 @@
+ // -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+#include "mpfr.h"
+
+#if !defined(GAUSSIAN_A) || !defined(GAUSSIAN_MU) || !defined(GAUSSIAN_SIGMA)
+#error "GAUSSIAN_A, GAUSSIAN_MU and GAUSSIAN_SIGMA must be defined"
+#endif
+
+// Using MPFR, compute A * exp(-(x - mu)^2 / (2 * sigma^2)) with A = GAUSSIAN_A, mu = GAUSSIAN_MU and sigma = GAUSSIAN_SIGMA.
+void
+mpfr_gaussian(mpfr_ptr result, mpfr_srcptr mpfr_x, mpfr_rnd_t mpfr_rnd) {
+    mpfr_t mpfr_temp;
+    mpfr_prec_t mpfr_prec_result = mpfr_get_prec(result);
+    mpfr_inits2(2 * mpfr_prec_result, mpfr_temp, (mpfr_ptr)NULL);
+    mpfr_sub_d(mpfr_temp, mpfr_x, GAUSSIAN_MU, mpfr_rnd);
+    mpfr_div_d(mpfr_temp, mpfr_temp, GAUSSIAN_SIGMA, mpfr_rnd);
+    mpfr_sqr(mpfr_temp, mpfr_temp, mpfr_rnd);
+    mpfr_div_d(mpfr_temp, mpfr_temp, -2.0, mpfr_rnd);
+    mpfr_exp(mpfr_temp, mpfr_temp, mpfr_rnd);
+    mpfr_mul_d(result, mpfr_temp, GAUSSIAN_A, mpfr_rnd);
+    mpfr_clears(mpfr_temp, (mpfr_ptr)NULL);
+    return;
+}
@@ -0,0 +1,166 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+
+// The reference value cache of test_accuracy (see ref_cache.h).
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mpfr.h"
+#include "ref_cache.h"
+
+static uint64_t
+bits_of(const double x) {
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return bits;
+}
+
+static size_t
+cache_size(const int64_t n_points) {
+    return sizeof(ref_cache_header) + (size_t)n_points * sizeof(ref_cache_entry);
+}
+
+static int
+same_run(const ref_cache_header* a, const ref_cache_header* b) {
+    return strncmp(a->function, b->function, REF_CACHE_NAME_SIZE) == 0 && bits_of(a->arg_min) == bits_of(b->arg_min)
+        && bits_of(a->arg_max) == bits_of(b->arg_max) && a->arg_cnt == b->arg_cnt && a->n_points == b->n_points
+        && a->precision == b->precision;
+}
+
+static int
+map_file(ref_cache* cache, const char* filename, const int fd, const size_t size, const int prot) {
+    void* map = mmap(NULL, size, prot, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        printf("Failed to map the reference cache %s\n", filename);
+        return -1;
+    }
+    cache->header = map;
+    cache->entries = (ref_cache_entry*)((char*)map + sizeof(ref_cache_header));
+    cache->map_size = size;
+    return 0;
+}
+
+int
+ref_cache_open(ref_cache* cache, const char* filename, const ref_cache_header* wanted) {
+    const size_t size = cache_size(wanted->n_points);
+    int fd = open(filename, O_RDONLY);
+    if (fd >= 0) {
+        struct stat st;
+        ref_cache_header existing;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(existing)
+            || read(fd, &existing, sizeof(existing)) != (ssize_t)sizeof(existing)
+            || memcmp(existing.magic, REF_CACHE_MAGIC, sizeof(existing.magic)) != 0) {
+            // Never overwrite a file that is not one of ours (a data file given by mistake, say).
+            close(fd);
+            printf("%s exists and is not a reference cache; not overwriting it\n", filename);
+            return -1;
+        }
+        if (existing.complete) {
+            if (!same_run(&existing, wanted) || (size_t)st.st_size != size) {
+                close(fd);
+                printf("The reference cache %s is for %.*s from %.17e to %.17e, %lld points at %lld bits;\n", filename,
+                       REF_CACHE_NAME_SIZE, existing.function, existing.arg_min, existing.arg_max, (long long)existing.arg_cnt,
+                       (long long)existing.precision);
+                printf("this run needs %.*s from %.17e to %.17e, %lld points at %lld bits\n", REF_CACHE_NAME_SIZE, wanted->function,
+                       wanted->arg_min, wanted->arg_max, (long long)wanted->arg_cnt, (long long)wanted->precision);
+                return -1;
+            }
+            cache->filling = 0;
+            return map_file(cache, filename, fd, size, PROT_READ);
+        }
+        // An interrupted fill:  refill it in place.
+        close(fd);
+        fd = open(filename, O_RDWR);
+    } else if (errno == ENOENT) {
+        fd = open(filename, O_RDWR | O_CREAT | O_EXCL, 0644);
+    }
+
+    if (fd < 0 || ftruncate(fd, (off_t)size) != 0) {
+        if (fd >= 0) close(fd);
+        printf("Failed to create the reference cache %s\n", filename);
+        return -1;
+    }
+    if (map_file(cache, filename, fd, size, PROT_READ | PROT_WRITE) != 0) return -1;
+    *cache->header = *wanted;
+    memcpy(cache->header->magic, REF_CACHE_MAGIC, sizeof(cache->header->magic));
+    cache->header->complete = 0;
+    cache->filling = 1;
+    return 0;
+}
+
+void
+ref_cache_close(ref_cache* cache) {
+    if (cache->filling) {
+        // The entries must be on disk before the header says so.
+        msync(cache->header, cache->map_size, MS_SYNC);
+        cache->header->complete = 1;
+        msync(cache->header, sizeof(ref_cache_header), MS_SYNC);
+    }
+    munmap(cache->header, cache->map_size);
+    cache->header = NULL;
+    cache->entries = NULL;
+    return;
+}
+
+void
+ref_cache_store(ref_cache_entry* entry, const double arg, mpfr_srcptr ref) {
+    entry->arg_bits = bits_of(arg);
+    entry->exponent = 0;
+    entry->mid = 0.0;
+    entry->lo = 0.0;
+    if (mpfr_nan_p(ref) || mpfr_inf_p(ref) || mpfr_zero_p(ref)) {
+        entry->hi = mpfr_get_d(ref, MPFR_RNDN);
+        return;
+    }
+    // Scale to [0.5, 1) (exactly), then peel off the three doubles; each subtraction is exact.
+    mpfr_t mpfr_temp;
+    mpfr_inits2(mpfr_get_prec(ref), mpfr_temp, (mpfr_ptr)NULL);
+    entry->exponent = (int64_t)mpfr_get_exp(ref);
+    mpfr_mul_2si(mpfr_temp, ref, -(long)entry->exponent, MPFR_RNDN);
+    entry->hi = mpfr_get_d(mpfr_temp, MPFR_RNDN);
+    mpfr_sub_d(mpfr_temp, mpfr_temp, entry->hi, MPFR_RNDN);
+    entry->mid = mpfr_get_d(mpfr_temp, MPFR_RNDN);
+    mpfr_sub_d(mpfr_temp, mpfr_temp, entry->mid, MPFR_RNDN);
+    entry->lo = mpfr_get_d(mpfr_temp, MPFR_RNDN);
+    mpfr_clears(mpfr_temp, (mpfr_ptr)NULL);
+    return;
+}
+
+int
+ref_cache_load(mpfr_ptr ref, const ref_cache_entry* entry, const double arg) {
+    if (entry->arg_bits != bits_of(arg)) return 0;
+    // The triple-double spans about 160 bits, so the sum is exact at the precision of the reference values.
+    mpfr_set_d(ref, entry->hi, MPFR_RNDN);
+    mpfr_add_d(ref, ref, entry->mid, MPFR_RNDN);
+    mpfr_add_d(ref, ref, entry->lo, MPFR_RNDN);
+    mpfr_mul_2si(ref, ref, (long)entry->exponent, MPFR_RNDN);
+    return 1;
+}
@@ -0,0 +1,82 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+
+// A persistent store of reference values for test_accuracy.  The file holds a header naming the reference function, the argument
+// range and the MPFR precision, followed by one entry per test point in argument order.  An entry holds the bit pattern of the
+// argument and the reference value rounded to triple-double; test_accuracy maps the file into memory and reads the entries
+// instead of calling MPFR.  The data files and statistics of a run from the cache are those of a run with MPFR, except that the
+// tiny errors of double-double results may differ in their last bits, which depend on the reference beyond triple-double.
+
+#if !defined(_REF_CACHE_H)
+#define _REF_CACHE_H 1
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mpfr.h"
+
+#define REF_CACHE_MAGIC "EXPXREF1"
+#define REF_CACHE_NAME_SIZE 96
+
+typedef struct {
+    char magic[ 8 ];
+    char function[ REF_CACHE_NAME_SIZE ];   // The MPFR function and its compile-time parameters.
+    double arg_min;
+    double arg_max;
+    int64_t arg_cnt;
+    int64_t n_points;
+    int64_t precision;                      // Of the MPFR values the entries were rounded from.
+    int64_t complete;                       // Set once every entry has been written.
+} ref_cache_header;
+
+// The reference value of the argument with bit pattern arg_bits is (hi + mid + lo) * 2^exponent, where hi + mid + lo is in
+// [0.5, 1).  Keeping the exponent apart leaves the triple-double its full precision for results that overflow or are subnormal
+// in double.  Zeros, infinities and NaNs are stored in hi with exponent 0.
+typedef struct {
+    uint64_t arg_bits;
+    int64_t exponent;
+    double hi;
+    double mid;
+    double lo;
+} ref_cache_entry;
+
+typedef struct {
+    ref_cache_header* header;
+    ref_cache_entry* entries;
+    size_t map_size;
+    int filling;                            // The entries are being written by this run.
+} ref_cache;
+
+// Map filename for the run described by wanted (magic and complete are ignored).  An existing complete cache must match wanted;
+// a missing file is created, and an incomplete cache reused in place, with wanted's header and has to be filled with
+// ref_cache_store().  Any other existing file is left alone.  Returns 0, or -1 after printing why the file cannot be used.
+int ref_cache_open(ref_cache* cache, const char* filename, const ref_cache_header* wanted);
+
+// Mark a filled cache complete, then unmap it.
+void ref_cache_close(ref_cache* cache);
+
+void ref_cache_store(ref_cache_entry* entry, const double arg, mpfr_srcptr ref);
+
+// Set ref to the cached value of arg.  Returns 0 if the entry belongs to another argument.
+int ref_cache_load(mpfr_ptr ref, const ref_cache_entry* entry, const double arg);
+
+#endif // _REF_CACHE_H
@@ -0,0 +1,173 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+// Benchmark and accuracy check of one table configuration (see sweep_tables and make_tables.c).  The scalar, AVX2 and AVX-512
+// versions of expxsqr and expmxsqr are all built with the same -DEXPXSQR_TABLES; for each of them this reports the time per result
+// (best of the repeats) and the max error against MPFR over the same uniformly spaced arguments.  The AVX-512 versions are skipped
+// if the processor does not support AVX-512F.
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "mpfr.h"
+
+#include "expxsqr.h"
+#include "expxsqr_tables.h"
+#include "utils.h"
+
+#define DEFAULT_MPFR_PREC (4 * DBL_MANT_DIG)
+
+// This file is compiled for the baseline ISA, so expxsqr.h does not declare the vector versions.
+void expxsqr_array_avx2(const double* x, double* y, const size_t n);
+void expmxsqr_array_avx2(const double* x, double* y, const size_t n);
+void expxsqr_array_avx512(const double* x, double* y, const size_t n);
+void expmxsqr_array_avx512(const double* x, double* y, const size_t n);
+
+typedef void (*array_func)(const double* x, double* y, const size_t n);
+
+static void
+scalar_expxsqr(const double* x, double* y, const size_t n) {
+    for (size_t i = 0; i < n; i++) y[i] = expxsqr(x[i]);
+}
+
+static void
+scalar_expmxsqr(const double* x, double* y, const size_t n) {
+    for (size_t i = 0; i < n; i++) y[i] = expmxsqr(x[i]);
+}
+
+typedef struct {
+    const char* name;
+    const char* isa;
+    array_func func;
+    int needs_avx512;
+} sweep_entry;
+
+static double
+elapsed_ns(const struct timespec* start, const struct timespec* stop) {
+    return 1.0e9 * (double)(stop->tv_sec - start->tv_sec) + (double)(stop->tv_nsec - start->tv_nsec);
+}
+
+static void
+sweep_function(const sweep_entry entries[], const int n_entries, const double arg_min, const double arg_max, const size_t arg_cnt,
+               const int repeats, void (*mpfr_func)(mpfr_ptr, mpfr_srcptr, mpfr_rnd_t)) {
+    double* x = malloc(arg_cnt * sizeof(double));
+    double* y = malloc(arg_cnt * sizeof(double));
+    mpfr_t* ref = malloc(arg_cnt * sizeof(mpfr_t));
+    if (x == NULL || y == NULL || ref == NULL) {
+        printf("Failed to allocate %zu points\n", arg_cnt);
+        exit(-1);
+    }
+
+    // The references are calculated once and shared by all the versions of the function.
+    const double arg_step = (arg_max - arg_min) / (double)arg_cnt;
+    mpfr_t mpfr_x;
+    mpfr_init2(mpfr_x, DEFAULT_MPFR_PREC);
+    for (size_t i = 0; i < arg_cnt; i++) {
+        x[i] = arg_min + (double)i * arg_step;
+        mpfr_init2(ref[i], DEFAULT_MPFR_PREC);
+        mpfr_set_d(mpfr_x, x[i], MPFR_RNDN);
+        mpfr_func(ref[i], mpfr_x, MPFR_RNDN);
+    }
+    mpfr_clear(mpfr_x);
+
+    for (int j = 0; j < n_entries; j++) {
+        if (entries[j].needs_avx512 && !__builtin_cpu_supports("avx512f")) {
+            printf("T = %3d  degree = %2d  %-8s  %-7s  skipped (no AVX-512F)\n", EXPXSQR_TABLE_SIZE,
+                   (int)(sizeof(expxsqr_coeffs) / sizeof(expxsqr_coeffs[0]) + 1), entries[j].name, entries[j].isa);
+            continue;
+        }
+
+        double best_ns = INFINITY;
+        for (int r = 0; r < repeats; r++) {
+            struct timespec start, stop;
+            timespec_get(&start, TIME_UTC);
+            entries[j].func(x, y, arg_cnt);
+            timespec_get(&stop, TIME_UTC);
+            double ns = elapsed_ns(&start, &stop);
+            if (ns < best_ns) best_ns = ns;
+        }
+
+        double max_err_ulp = 0.0;
+        double max_err_arg = 0.0;
+        int nans = 0;
+        for (size_t i = 0; i < arg_cnt; i++) {
+            double error = compare(ref[i], y[i]);
+            if (isnan(error)) {
+                nans++;
+                continue;
+            }
+            if (error > max_err_ulp) {
+                max_err_ulp = error;
+                max_err_arg = x[i];
+            }
+        }
+
+        printf("T = %3d  degree = %2d  %-8s  %-7s  %7.3f ns/result  max err = %.3f ulp at x = %.17e  nans = %d\n",
+               EXPXSQR_TABLE_SIZE, (int)(sizeof(expxsqr_coeffs) / sizeof(expxsqr_coeffs[0]) + 1), entries[j].name, entries[j].isa,
+               best_ns / (double)arg_cnt, max_err_ulp, max_err_arg, nans);
+    }
+
+    for (size_t i = 0; i < arg_cnt; i++) mpfr_clear(ref[i]);
+    free(ref);
+    free(y);
+    free(x);
+    return;
+}
+
+int
+main(int argc, char* argv[]) {
+    if (argc != 3) {
+        printf("Usage:  %s arg_cnt repeats\n", argv[0]);
+        return -1;
+    }
+    long arg_cnt = atol(argv[1]);
+    int repeats = atoi(argv[2]);
+    if (arg_cnt <= 0 || repeats <= 0) {
+        printf("Bad arguments:  arg_cnt = %ld  repeats = %d\n", arg_cnt, repeats);
+        return -1;
+    }
+
+    extern void mpfr_expxsqr(mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
+    extern void mpfr_expmxsqr(mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
+
+    const sweep_entry expxsqr_entries[] = {
+        {"expxsqr", "scalar", scalar_expxsqr, 0},
+        {"expxsqr", "avx2", expxsqr_array_avx2, 0},
+        {"expxsqr", "avx512", expxsqr_array_avx512, 1},
+    };
+    const sweep_entry expmxsqr_entries[] = {
+        {"expmxsqr", "scalar", scalar_expmxsqr, 0},
+        {"expmxsqr", "avx2", expmxsqr_array_avx2, 0},
+        {"expmxsqr", "avx512", expmxsqr_array_avx512, 1},
+    };
+
+    // The same argument ranges as test1.
+    sweep_function(expxsqr_entries, sizeof(expxsqr_entries) / sizeof(expxsqr_entries[0]), 0x1.6a09e667f3bccp-27,
+                   0x1.aa4499161cd48p+4, (size_t)arg_cnt, repeats, mpfr_expxsqr);
+    sweep_function(expmxsqr_entries, sizeof(expmxsqr_entries) / sizeof(expmxsqr_entries[0]), 0x1.0000000000000p-27,
+                   0x1.b4c109b69b1bap+4, (size_t)arg_cnt, repeats, mpfr_expmxsqr);
+
+    return 0;
+}
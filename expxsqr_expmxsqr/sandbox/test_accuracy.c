@@ -22,12 +22,19 @@
 #include <fenv.h>
 #include <float.h>
 #include <math.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#if !defined(__STDC_NO_THREADS__)
+#include <threads.h>
+#endif
 
 #include "mpfr.h"
 
+#include "expxsqr_td.h"
+#include "ref_cache.h"
 #include "test_accuracy.h"
 // #include "DD_arithmetic.h"
 #include "utils.h"
@@ -48,24 +55,189 @@
 #define DEFAULT_MPFR_PREC (4 * DBL_MANT_DIG)
 
 static const unsigned int BUFFER_SIZE = 32768;
+#define MAX_THREADS 256
 
+#if defined(TEST_ARRAY_FUNC)
+// FUNC_NAME is an array function.  Calling it with n = 1 runs the vector kernel through its masked tail path.
+static inline double
+test_function(const double x) {
+    extern void FUNC_NAME(const double* x, double* y, const size_t n);
+    double y;
+    FUNC_NAME(&x, &y, 1);
+    return y;
+}
+#elif defined(TEST_PAIR_FUNC) || defined(TEST_PAIR_ARRAY_FUNC)
+// FUNC_NAME returns both e^(x*x) and e^(-x*x), either as a scalar or as an array function; PAIR_NEG selects e^(-x*x).
+static inline double
+test_function(const double x) {
+    double pos, neg;
+#if defined(TEST_PAIR_FUNC)
+    extern void FUNC_NAME(const double x, double* pos, double* neg);
+    FUNC_NAME(x, &pos, &neg);
+#else
+    extern void FUNC_NAME(const double* x, double* pos, double* neg, const size_t n);
+    FUNC_NAME(&x, &pos, &neg, 1);
+#endif
+#if defined(PAIR_NEG)
+    return neg;
+#else
+    return pos;
+#endif
+}
+#elif defined(TEST_GAUSSIAN_FUNC) || defined(TEST_GAUSSIAN_ARRAY_FUNC)
+// FUNC_NAME is A * e^(-(x - mu)^2 / (2 * sigma^2)), either as a scalar or as an array function, tested with the parameters
+// GAUSSIAN_A, GAUSSIAN_MU and GAUSSIAN_SIGMA (which must match those used to compile mpfr_gaussian.c).
+#define REFERENCE_PARAMS " A=" STRINGIZE(GAUSSIAN_A) " mu=" STRINGIZE(GAUSSIAN_MU) " sigma=" STRINGIZE(GAUSSIAN_SIGMA)
+static inline double
+test_function(const double x) {
+#if defined(TEST_GAUSSIAN_FUNC)
+    extern double FUNC_NAME(const double x, const double A, const double mu, const double sigma);
+    return FUNC_NAME(x, GAUSSIAN_A, GAUSSIAN_MU, GAUSSIAN_SIGMA);
+#else
+    extern void FUNC_NAME(const double* x, double* y, const size_t n, const double A, const double mu, const double sigma);
+    double y;
+    FUNC_NAME(&x, &y, 1, GAUSSIAN_A, GAUSSIAN_MU, GAUSSIAN_SIGMA);
+    return y;
+#endif
+}
+#elif defined(TEST_XY_FUNC) || defined(TEST_XY_ARRAY_FUNC)
+// FUNC_NAME is e^(x*y) or e^(-x*y), either as a scalar or as an array function, tested with y = EXPXY_Y (which must match the
+// value used to compile mpfr_expxy.c and mpfr_expmxy.c).
+#define REFERENCE_PARAMS " y=" STRINGIZE(EXPXY_Y)
+#define REFERENCE_FACTOR(x) (EXPXY_Y)
+static inline double
+test_function(const double x) {
+#if defined(TEST_XY_FUNC)
+    extern double FUNC_NAME(const double x, const double y);
+    return FUNC_NAME(x, EXPXY_Y);
+#else
+    extern void FUNC_NAME(const double* x, const double* y, double* z, const size_t n);
+    const double y = EXPXY_Y;
+    double z;
+    FUNC_NAME(&x, &y, &z, 1);
+    return z;
+#endif
+}
+#elif defined(TEST_FLOAT_FUNC) || defined(TEST_FLOAT_ARRAY_FUNC)
+// FUNC_NAME is a single-precision function, either scalar or array.  The argument is rounded to float before it is passed to both
+// FUNC_NAME and the reference function, and errors are measured in float ulps.
+#define TEST_ARG(x) ((double)(float)(x))
+#define COMPARE(ref, test) comparef((ref), (float)(test))
+#define REFERENCE_PARAMS " float arguments"
+#define COMPARE_TD(y, e, test, error, bound, ref_d) \
+    compare_TD((y), (e), EXPXSQR_TD_REL_ERR, load_D_D_DD((float)(test), 0.0), 1, (error), (bound), (ref_d))
+static inline double
+test_function(const double x) {
+    float x_flt = (float)x;
+#if defined(TEST_FLOAT_FUNC)
+    extern float FUNC_NAME(const float x);
+    return FUNC_NAME(x_flt);
+#else
+    extern void FUNC_NAME(const float* x, float* y, const size_t n);
+    float y;
+    FUNC_NAME(&x_flt, &y, 1);
+    return y;
+#endif
+}
+#elif defined(TEST_DD_FUNC) || defined(TEST_DD_ARRAY_FUNC)
+// FUNC_NAME returns a double-double, either as a scalar or as an array function.  test_function() returns the high part and leaves
+// the low part in test_lo for COMPARE, which measures the error of hi + lo.  The errors are printed with more digits since they are
+// small fractions of an ulp.  test_lo is per thread for the -j mode.
+static _Thread_local double test_lo = 0.0;
+#define COMPARE(ref, test) compare_DD((ref), load_D_D_DD((test), test_lo))
+#define COMPARE_TD(y, e, test, error, bound, ref_d) \
+    compare_TD((y), (e), EXPXSQR_TD_REL_ERR, load_D_D_DD((test), test_lo), 0, (error), (bound), (ref_d))
+#define ERR_DIGITS 6
+static inline double
+test_function(const double x) {
+#if defined(TEST_DD_FUNC)
+    extern DD FUNC_NAME(const double x);
+    DD y = FUNC_NAME(x);
+    test_lo = DD_LO(y);
+    return DD_HI(y);
+#else
+    extern void FUNC_NAME(const double* x, double* hi, double* lo, const size_t n);
+    double hi;
+    FUNC_NAME(&x, &hi, &test_lo, 1);
+    return hi;
+#endif
+}
+#else
 static inline double
 test_function(const double x) {
     extern double FUNC_NAME(const double x);
     return FUNC_NAME(x);
 }
+#endif
+
+#if !defined(TEST_ARG)
+#define TEST_ARG(x) (x)
+#endif
+#if !defined(COMPARE)
+#define COMPARE(ref, test) compare((ref), (test))
+#endif
+#if !defined(ERR_DIGITS)
+#define ERR_DIGITS 3
+#endif
+#if !defined(REFERENCE_PARAMS)
+#define REFERENCE_PARAMS ""
+#endif
+// Names the reference values in the header of a reference cache:  the MPFR function and whatever else they depend on.  The test
+// functions of the different tiers share the caches of their reference function.
+#define REFERENCE_NAME STRINGIZE(MPFR_FUNC_NAME) REFERENCE_PARAMS
+// The -t mode evaluates e^(+-x*REFERENCE_FACTOR(x)) in triple-double, see compare_reference_td().
+#if !defined(REFERENCE_FACTOR)
+#define REFERENCE_FACTOR(x) (x)
+#endif
+#if !defined(COMPARE_TD)
+#define COMPARE_TD(y, e, test, error, bound, ref_d) \
+    compare_TD((y), (e), EXPXSQR_TD_REL_ERR, load_D_D_DD((test), 0.0), 0, (error), (bound), (ref_d))
+#endif
 
 static inline void
 reference_function(mpfr_ptr result, const double x) {
     extern void MPFR_FUNC_NAME(mpfr_ptr, mpfr_srcptr, mpfr_rnd_t);
     mpfr_t mpfr_x;
     mpfr_inits2(DEFAULT_MPFR_PREC, mpfr_x, (mpfr_ptr)NULL);
-    mpfr_set_d(mpfr_x, x, MPFR_RNDN);
+    mpfr_set_d(mpfr_x, TEST_ARG(x), MPFR_RNDN);
     MPFR_FUNC_NAME(result, mpfr_x, MPFR_RNDN);
     mpfr_clears(mpfr_x, (mpfr_ptr)NULL);
     return;
 }
 
+// The sign of the exponent of the reference functions that the -t mode can evaluate with expxsqr_td_scaled(), 0.0 for the others.
+static double
+reference_td_sign(void) {
+    const char* name = STRINGIZE(MPFR_FUNC_NAME);
+    if (strcmp(name, "mpfr_expxsqr") == 0 || strcmp(name, "mpfr_expxy") == 0) return 1.0;
+    if (strcmp(name, "mpfr_expmxsqr") == 0 || strcmp(name, "mpfr_expmxy") == 0) return -1.0;
+    return 0.0;
+}
+
+// The error of test_result against the triple-double reference e^(sign * x * REFERENCE_FACTOR(x)), and the reference rounded to
+// double.  Returns 0 if the reference cannot be evaluated that way or if the error is too close to one of the bounds the statistics
+// count against for the error bound of the reference to decide on which side it lies; MPFR is needed for those.
+static int
+compare_reference_td(const double arg, const double test_result, const double sign, double* error, double* ref_d) {
+    static const double thresholds[] = {
+        0.5, 1.0,
+#if defined(MAX_ERR_ULP)
+        MAX_ERR_ULP,
+#endif
+    };
+    const double x = TEST_ARG(arg);
+    const DD x_prod = mul_D_D_DD(x, REFERENCE_FACTOR(x));
+    if (!(fabs(DD_HI(x_prod)) < 1400.0)) return 0;
+    int e;
+    TD y = expxsqr_td_scaled(x_prod, sign, &e);
+    double bound;
+    if (!COMPARE_TD(y, e, test_result, error, &bound, ref_d)) return 0;
+    for (size_t i = 0; i < sizeof(thresholds) / sizeof(thresholds[ 0 ]); i++) {
+        if (fabs(*error - thresholds[ i ]) <= bound) return 0;
+    }
+    return 1;
+}
+
 static void
 doOnePoint(double x) {
     feclearexcept(FE_ALL_EXCEPT);
@@ -76,9 +248,9 @@ doOnePoint(double x) {
     mpfr_inits2(DEFAULT_MPFR_PREC, mpfr_result, (mpfr_ptr)NULL);
     reference_function(mpfr_result, x);
 
-    double lsb_error = compare(mpfr_result, test_result);
+    double lsb_error = COMPARE(mpfr_result, test_result);
 
-    printf("x = %.17e (%.13a)\n", x, x);
+    printf("x = %.17e (%.13a)\n", TEST_ARG(x), TEST_ARG(x));
 
     // printf(" ref "FUNC_NAME_STRING" = %.17e (%.13a) correction = %.17e\n", DD_HI(mpfr_result), DD_HI(mpfr_result), DD_LO(mpfr_result));
     double mpfr_result_d = mpfr_get_d(mpfr_result, MPFR_RNDN);
@@ -93,7 +265,10 @@ doOnePoint(double x) {
     printf(" ref "FUNC_NAME_STRING" = %.17e (%.13a)  %.17e (%.13a)\n", mpfr_result_d, mpfr_result_d, corr, corr);
     
     printf("test "FUNC_NAME_STRING" = %.17e (%.13a)\n", test_result, test_result);
-    printf("error = %.3f ulp\n", lsb_error);
+#if defined(TEST_DD_FUNC) || defined(TEST_DD_ARRAY_FUNC)
+    printf("test "FUNC_NAME_STRING" low part = %.17e (%.13a)\n", test_lo, test_lo);
+#endif
+    printf("error = %.*f ulp\n", ERR_DIGITS, lsb_error);
     if (fp_flags != 0) {
         if (fp_flags & FE_DIVBYZERO) printf(" FE_DIVBYZERO");
         if (fp_flags & FE_INEXACT)   printf(" FE_INEXACT");
@@ -122,96 +297,732 @@ doPoints(char* points[], int n_points) {
     return;
 }
 
-int
-main(int argc, char* argv[]) {
+// Statistics of a run of points.  Those of the chunks are merged in argument order, so that the argument of the max error is the
+// first one at which it occurs, as in a single-threaded run.
+typedef struct {
+    double max_err_ulp;
+    double max_err_arg;
+    long correctly_rounded;
+    long faithfully_rounded;
+    long geq_1_ulp;
+    long nans;
+    long cache_mismatches;
+    long mpfr_references;
+} accuracy_stats;
 
-    if (argc < 2) {
-        printf("Usage:  %s arg_min arg_max arg_cnt output_filename OR -s arg...\n", argv[0]);
-        return -1;
+// The -e mode sweeps the bit patterns of binades:  those of doubles, or of floats for the single-precision functions.
+#if defined(TEST_FLOAT_FUNC) || defined(TEST_FLOAT_ARRAY_FUNC)
+#define SWEEP_MANT_BITS (FLT_MANT_DIG - 1)
+#define SWEEP_MIN_EXP (FLT_MIN_EXP - 1)
+#define SWEEP_MAX_EXP (FLT_MAX_EXP - 1)
+static inline double
+sweep_arg(const uint64_t bits) {
+    const uint32_t bits_32 = (uint32_t)bits;
+    float x;
+    memcpy(&x, &bits_32, sizeof(x));
+    return x;
+}
+#else
+#define SWEEP_MANT_BITS (DBL_MANT_DIG - 1)
+#define SWEEP_MIN_EXP (DBL_MIN_EXP - 1)
+#define SWEEP_MAX_EXP (DBL_MAX_EXP - 1)
+static inline double
+sweep_arg(const uint64_t bits) {
+    double x;
+    memcpy(&x, &bits, sizeof(x));
+    return x;
+}
+#endif
+// The bit pattern of 2^e.
+#define SWEEP_BITS(e) ((uint64_t)((e) + SWEEP_MAX_EXP) << SWEEP_MANT_BITS)
+
+static inline uint64_t
+sweep_bits(const double x) {
+#if defined(TEST_FLOAT_FUNC) || defined(TEST_FLOAT_ARRAY_FUNC)
+    const float x_flt = (float)x;
+    uint32_t bits;
+    memcpy(&bits, &x_flt, sizeof(bits));
+    return bits;
+#else
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    return bits;
+#endif
+}
+
+// The -w mode searches for the worst cases of a linear range.  The run over the range is a coarse sweep whose points are grouped
+// into bins of consecutive points, as by make_bins, and the SEARCH_BEAM bins with the largest errors are refined in rounds:  each
+// round samples the interval of every bin kept with SEARCH_BINS * SEARCH_BIN_WIDTH points, or enumerates the bit patterns in it
+// once there are no more than that, and keeps the SEARCH_BEAM bins with the largest errors of those it sampled and those
+// enumerated earlier.  The search ends when all the bins kept have been enumerated.
+#define SEARCH_BIN_WIDTH 64
+#define SEARCH_BINS 64
+#define SEARCH_BEAM 8
+#define SEARCH_MAX_ROUNDS 64
+#define SEARCH_MAX_COARSE_BINS (1L << 20)
+
+// A bin of the -w mode:  the max error of its points and the first argument at which it occurs (error is -1.0 if all the points
+// gave NaNs), and the interval [lo, hi) of the points, all of which have been tested if exact is not 0.
+typedef struct {
+    double arg;
+    double error;
+    double lo;
+    double hi;
+    int exact;
+} search_bin;
+
+// The -r report summarizes the errors as they are computed:  a histogram with SUMMARY_SUB_BINS bins per octave of errors from
+// 2^SUMMARY_MIN_OCTAVE to 2^SUMMARY_MAX_OCTAVE ulp (below and above go to the first and last bins), from which the quantiles are
+// estimated, and the max error and the number of errors above the threshold in each binade of |x| (binade 0 holds x = 0).
+#define SUMMARY_MIN_OCTAVE (-64)
+#define SUMMARY_MAX_OCTAVE 16
+#define SUMMARY_SUB_BINS 16
+#define SUMMARY_BINS ((SUMMARY_MAX_OCTAVE - SUMMARY_MIN_OCTAVE) * SUMMARY_SUB_BINS + 2)
+#define SUMMARY_MIN_EXP (DBL_MIN_EXP - DBL_MANT_DIG)
+#define SUMMARY_BINADES (DBL_MAX_EXP - SUMMARY_MIN_EXP + 1)
+typedef struct {
+    double threshold;
+    long above;
+    long histogram[ SUMMARY_BINS ];
+    long binade_count[ SUMMARY_BINADES ];
+    long binade_above[ SUMMARY_BINADES ];
+    double binade_max_err[ SUMMARY_BINADES ];
+    double binade_max_arg[ SUMMARY_BINADES ];
+} error_summary;
+
+static inline void
+add_to_summary(error_summary* summary, const double arg, const double error) {
+    int bin = 0;
+    if (error > 0.0) {
+        const double sub_bin = floor((log2(error) - SUMMARY_MIN_OCTAVE) * SUMMARY_SUB_BINS);
+        bin = (sub_bin < 0.0) ? 0 : (sub_bin >= SUMMARY_BINS - 2) ? SUMMARY_BINS - 1 : 1 + (int)sub_bin;
     }
-    if (strcmp(argv[ 1 ], "-s") == 0) {
-        doPoints(&argv[ 2 ], argc - 2);
-        return 0;
+    summary->histogram[ bin ]++;
+    const int binade = (arg == 0.0) ? 0 : ilogb(arg) - SUMMARY_MIN_EXP + 1;
+    summary->binade_count[ binade ]++;
+    if (error > summary->binade_max_err[ binade ] || summary->binade_count[ binade ] == 1) {
+        summary->binade_max_err[ binade ] = error;
+        summary->binade_max_arg[ binade ] = arg;
     }
-    if (argc != 5) {
-        printf("Usage:  %s arg_min arg_max arg_cnt output_filename OR -s arg...\n", argv[0]);
-        return -1;
+    if (error > summary->threshold) {
+        summary->above++;
+        summary->binade_above[ binade ]++;
     }
+    return;
+}
+
+static void
+merge_summary(error_summary* total, const error_summary* part) {
+    total->above += part->above;
+    for (int b = 0; b < SUMMARY_BINS; b++) total->histogram[ b ] += part->histogram[ b ];
+    for (int b = 0; b < SUMMARY_BINADES; b++) {
+        if (part->binade_count[ b ] == 0) continue;
+        if (total->binade_count[ b ] == 0 || part->binade_max_err[ b ] > total->binade_max_err[ b ]) {
+            total->binade_max_err[ b ] = part->binade_max_err[ b ];
+            total->binade_max_arg[ b ] = part->binade_max_arg[ b ];
+        }
+        total->binade_count[ b ] += part->binade_count[ b ];
+        total->binade_above[ b ] += part->binade_above[ b ];
+    }
+    return;
+}
+
+static long
+summary_count(const error_summary* summary) {
+    long n = 0;
+    for (int b = 0; b < SUMMARY_BINS; b++) n += summary->histogram[ b ];
+    return n;
+}
 
-    double arg_min = strtod(argv[ 1 ], NULL);
-    double arg_max = strtod(argv[ 2 ], NULL);
-    int arg_cnt = atoi(argv[ 3 ]);
-    char* output_filename = argv[ 4 ];
+// The upper edge of the histogram bin that holds the q-quantile of the errors, but no more than the max error.
+static double
+summary_quantile(const error_summary* summary, const double q, const double max_err) {
+    const long n = summary_count(summary);
+    const long rank = (long)ceil(q * (double)n);
+    long cumulative = 0;
+    int b = 0;
+    for (; b < SUMMARY_BINS - 1; b++) {
+        cumulative += summary->histogram[ b ];
+        if (cumulative >= rank) break;
+    }
+    const double edge = (b == SUMMARY_BINS - 1) ? INFINITY : exp2(SUMMARY_MIN_OCTAVE + (double)b / SUMMARY_SUB_BINS);
+    return (edge < max_err) ? edge : max_err;
+}
 
-    double arg_step = (arg_max - arg_min) / (double)arg_cnt;
-    if (arg_step <= 0.0) {
-        printf("Bad argument range:  min = %e  max = %e  count = %d\n", arg_min, arg_max, arg_cnt);
+// Print the -r report; the points that gave NaNs are not in it.
+static void
+print_summary(const error_summary* summary, const double max_err) {
+    const long n_points = summary_count(summary);
+    printf("Error histogram (ulp):\n");
+    if (summary->histogram[ 0 ] != 0) {
+        printf("  [0, 2^%d)  %ld (%.4f%%)\n", SUMMARY_MIN_OCTAVE, summary->histogram[ 0 ],
+               100. * summary->histogram[ 0 ] / n_points);
+    }
+    for (int octave = SUMMARY_MIN_OCTAVE; octave < SUMMARY_MAX_OCTAVE; octave++) {
+        const long* sub_bins = &summary->histogram[ 1 + (octave - SUMMARY_MIN_OCTAVE) * SUMMARY_SUB_BINS ];
+        long count = 0;
+        for (int k = 0; k < SUMMARY_SUB_BINS; k++) count += sub_bins[ k ];
+        if (count != 0) printf("  [2^%d, 2^%d)  %ld (%.4f%%)\n", octave, octave + 1, count, 100. * count / n_points);
+    }
+    if (summary->histogram[ SUMMARY_BINS - 1 ] != 0) {
+        printf("  [2^%d, inf)  %ld (%.4f%%)\n", SUMMARY_MAX_OCTAVE, summary->histogram[ SUMMARY_BINS - 1 ],
+               100. * summary->histogram[ SUMMARY_BINS - 1 ] / n_points);
+    }
+    printf("Quantiles (to 1/%d octave):  p50 = %.*f ulp  p99 = %.*f ulp  p99.9 = %.*f ulp\n", SUMMARY_SUB_BINS, ERR_DIGITS,
+           summary_quantile(summary, 0.5, max_err), ERR_DIGITS, summary_quantile(summary, 0.99, max_err), ERR_DIGITS,
+           summary_quantile(summary, 0.999, max_err));
+    printf("Errors above %g ulp: %ld (%.4f%%)\n", summary->threshold, summary->above, 100. * summary->above / n_points);
+    for (int b = 0; b < SUMMARY_BINADES; b++) {
+        if (summary->binade_count[ b ] == 0) continue;
+        if (b == 0) {
+            printf("x = 0:  ");
+        } else {
+            printf("|x| in 2^%d:  ", b - 1 + SUMMARY_MIN_EXP);
+        }
+        printf("%ld points  max err = %.*f ulp at x = %.13a  above %g ulp: %ld\n", summary->binade_count[ b ], ERR_DIGITS,
+               summary->binade_max_err[ b ], summary->binade_max_arg[ b ], summary->threshold, summary->binade_above[ b ]);
+    }
+    return;
+}
+
+// A chunk of at most BUFFER_SIZE consecutive points i, first <= i < first + count, with the data points it produces.  The points
+// are arg_min + i * arg_step, or the bit patterns bits_min + i * bits_step if bits_step is not 0.  With a reference cache, the
+// reference values are read from it, or written to it if it is being filled.  If td_sign is not 0.0, the points are compared with a
+// triple-double reference first.  If bins is not NULL, the max error of the points i is recorded in bins[ i / bin_width ];
+// bin_width divides BUFFER_SIZE so that the chunks of a run do not share bins.  If summary is not NULL, the errors are added to it;
+// the summary of the points of a run (see run_points) is the total, each chunk has its own.
+typedef struct {
+    ref_cache* cache;
+    double td_sign;
+    double arg_min;
+    double arg_step;
+    uint64_t bits_min;
+    uint64_t bits_step;
+    search_bin* bins;
+    long bin_width;
+    error_summary* summary;
+    long first;
+    long count;
+    data_point* data;
+    size_t n_data;
+    accuracy_stats stats;
+} chunk;
+
+static void
+merge_stats(accuracy_stats* total, const accuracy_stats* part) {
+    if (part->max_err_ulp > total->max_err_ulp) {
+        total->max_err_ulp = part->max_err_ulp;
+        total->max_err_arg = part->max_err_arg;
+    }
+    total->correctly_rounded += part->correctly_rounded;
+    total->faithfully_rounded += part->faithfully_rounded;
+    total->geq_1_ulp += part->geq_1_ulp;
+    total->nans += part->nans;
+    total->cache_mismatches += part->cache_mismatches;
+    total->mpfr_references += part->mpfr_references;
+    return;
+}
+
+// Allocate the buffers of a chunk for n_data points, and its summary if the run has one; returns 0 if that fails.
+static int
+alloc_chunk(chunk* c, const chunk* points, const size_t n_data) {
+    c->data = malloc(n_data * sizeof(data_point));
+    c->summary = (points->summary != NULL) ? malloc(sizeof(error_summary)) : NULL;
+    if (c->data == NULL || (points->summary != NULL && c->summary == NULL)) {
+        free(c->data);
+        free(c->summary);
         return 0;
     }
+    return 1;
+}
 
-    FILE* out_datafile = fopen(output_filename, "wb");
-    if (out_datafile == NULL) {
-        printf("Failed to open output data file\n");
-        return -1;
+static void
+free_chunk(chunk* c) {
+    free(c->data);
+    free(c->summary);
+    return;
+}
+
+// Set up a chunk of the run described by points, keeping its buffers.
+static void
+prepare_chunk(chunk* c, const chunk* points) {
+    data_point* data = c->data;
+    error_summary* summary = c->summary;
+    *c = *points;
+    c->data = data;
+    c->summary = summary;
+    if (summary != NULL) {
+        memset(summary, 0, sizeof(error_summary));
+        summary->threshold = points->summary->threshold;
     }
+    return;
+}
 
+// Write the data points of a chunk that has run to out_datafile (unless it is NULL) and add its statistics to total and its summary
+// to that of the run.
+static void
+finish_chunk(const chunk* c, const chunk* points, accuracy_stats* total, FILE* out_datafile) {
+    if (out_datafile != NULL) fwrite(c->data, sizeof(data_point), c->n_data, out_datafile);
+    merge_stats(total, &c->stats);
+    if (c->summary != NULL) merge_summary(points->summary, c->summary);
+    return;
+}
+
+// Test the points of one chunk.  Each call has its own MPFR workspace, so chunks can run in parallel.
+static int
+run_chunk(void* arg) {
+    chunk* c = arg;
+    accuracy_stats stats = { 0.0, 0.0, 0, 0, 0, 0, 0, 0 };
     mpfr_t mpfr_result;
     mpfr_inits2(DEFAULT_MPFR_PREC, mpfr_result, (mpfr_ptr)NULL);
-    
-    data_point data_buffer[ BUFFER_SIZE ];
-    unsigned int index = 0;
-    double max_err_ulp = 0.0;
-    double max_err_arg = 0.0;
-    int correctly_rounded = 0;
-    int faithfully_rounded = 0;
-    int geq_1_ulp = 0;
-    int nans = 0;
-
-    double arg = arg_min;
-    for (int i = 1; arg <= arg_max; i++) {
+    c->n_data = 0;
+    for (long i = c->first; i < c->first + c->count; i++) {
+        double arg = (c->bits_step == 0) ? c->arg_min + (double)(i) * c->arg_step
+                                         : sweep_arg(c->bits_min + (uint64_t)i * c->bits_step);
         double test_result = test_function(arg);
-        reference_function(mpfr_result, arg);
-        double error = compare(mpfr_result, test_result);
+        double error;
+        double ref_d;
+        if (c->td_sign == 0.0 || !compare_reference_td(arg, test_result, c->td_sign, &error, &ref_d)) {
+            if (c->cache == NULL) {
+                reference_function(mpfr_result, arg);
+                stats.mpfr_references++;
+            } else if (c->cache->filling) {
+                reference_function(mpfr_result, arg);
+                ref_cache_store(&c->cache->entries[ i ], TEST_ARG(arg), mpfr_result);
+            } else if (!ref_cache_load(mpfr_result, &c->cache->entries[ i ], TEST_ARG(arg))) {
+                stats.cache_mismatches++;
+                reference_function(mpfr_result, arg);
+            }
+            error = COMPARE(mpfr_result, test_result);
+            ref_d = mpfr_get_d(mpfr_result, MPFR_RNDN);
+        }
         if (isnan(test_result) || isnan(error)) {
-            nans++;
+            stats.nans++;
             continue;
         }
-        if (error > max_err_ulp) {
-            max_err_ulp = error;
-            max_err_arg = arg;
+        if (error > stats.max_err_ulp) {
+            stats.max_err_ulp = error;
+            stats.max_err_arg = TEST_ARG(arg);
         }
         if (error <= 0.5) {
-            correctly_rounded++;
+            stats.correctly_rounded++;
         } else if (error <= 1.0) {
-            faithfully_rounded++;
-        } else if (!isnan(error)) {
-            geq_1_ulp++;
+            stats.faithfully_rounded++;
         } else {
-            nans++;
+            stats.geq_1_ulp++;
         }
-        data_buffer[ index ].arg = arg;
-        data_buffer[ index ].ref = mpfr_get_d(mpfr_result, MPFR_RNDN);
-        data_buffer[ index ].test = test_result;
-        data_buffer[ index ].error = error;
-        index++;
-        if (index >= BUFFER_SIZE) {
-            fwrite(data_buffer, sizeof(data_point), BUFFER_SIZE, out_datafile);
-            index = 0;
+        if (c->bins != NULL) {
+            search_bin* bin = &c->bins[ i / c->bin_width ];
+            if (error > bin->error) {
+                bin->error = error;
+                bin->arg = TEST_ARG(arg);
+            }
         }
-        arg = arg_min + (double)(i) * arg_step;
-    }
-    if (index != 0) {
-        fwrite(data_buffer, sizeof(data_point), index, out_datafile);
+        if (c->summary != NULL) add_to_summary(c->summary, fabs(TEST_ARG(arg)), error);
+        c->data[ c->n_data ].arg = TEST_ARG(arg);
+        c->data[ c->n_data ].ref = ref_d;
+        c->data[ c->n_data ].test = test_result;
+        c->data[ c->n_data ].error = error;
+        c->n_data++;
     }
     mpfr_clears(mpfr_result, (mpfr_ptr)NULL);
+    c->stats = stats;
+    return 0;
+}
+
+// The number of points arg_min + i * arg_step <= arg_max, i = 0, 1, ...
+static long
+count_points(const double arg_min, const double arg_max, const double arg_step) {
+    long n = (long)((arg_max - arg_min) / arg_step);
+    while (n > 0 && arg_min + (double)(n) * arg_step > arg_max) n--;
+    while (arg_min + (double)(n + 1) * arg_step <= arg_max) n++;
+    return n + 1;
+}
+
+// Run n_chunks <= MAX_THREADS chunks, one per thread.
+static void
+run_chunks(chunk* chunks, const int n_chunks) {
+#if !defined(__STDC_NO_THREADS__)
+    thrd_t ids[ MAX_THREADS ];
+    int started[ MAX_THREADS ];
+    for (int t = 1; t < n_chunks; t++) started[ t ] = (thrd_create(&ids[ t ], run_chunk, &chunks[ t ]) == thrd_success);
+    run_chunk(&chunks[ 0 ]);
+    for (int t = 1; t < n_chunks; t++) {
+        if (started[ t ]) {
+            thrd_join(ids[ t ], NULL);
+        } else {
+            run_chunk(&chunks[ t ]);
+        }
+    }
+#else
+    for (int t = 0; t < n_chunks; t++) run_chunk(&chunks[ t ]);
+#endif
+    return;
+}
+
+// Run the chunks of the points 0 <= i < n_points described by points (see chunk) in rounds of one chunk per thread, then write
+// their data points to out_datafile (unless it is NULL) in argument order.
+static accuracy_stats
+run_points(const chunk* points, const long n_points, int threads, FILE* out_datafile) {
+    accuracy_stats total = { 0.0, 0.0, 0, 0, 0, 0, 0, 0 };
+    chunk chunks[ MAX_THREADS ];
+    int allocated = 0;
+    for (; allocated < threads; allocated++) {
+        if (!alloc_chunk(&chunks[ allocated ], points, BUFFER_SIZE)) break;
+    }
+    threads = allocated;
+    if (threads == 0) {
+        printf("Failed to allocate the data buffer\n");
+        exit(-1);
+    }
+
+    for (long first = 0; first < n_points; first += (long)threads * BUFFER_SIZE) {
+        int n_chunks = 0;
+        for (; n_chunks < threads && first + (long)n_chunks * BUFFER_SIZE < n_points; n_chunks++) {
+            chunk* c = &chunks[ n_chunks ];
+            prepare_chunk(c, points);
+            c->first = first + (long)n_chunks * BUFFER_SIZE;
+            c->count = (n_points - c->first < BUFFER_SIZE) ? n_points - c->first : BUFFER_SIZE;
+        }
+        run_chunks(chunks, n_chunks);
+        for (int t = 0; t < n_chunks; t++) finish_chunk(&chunks[ t ], points, &total, out_datafile);
+    }
+
+    for (int t = 0; t < threads; t++) free_chunk(&chunks[ t ]);
+    return total;
+}
+
+// Largest error first; ties are broken by the argument so that the bins kept do not depend on the sort.
+static int
+compare_search_bins(const void* a, const void* b) {
+    const search_bin* bin_a = a;
+    const search_bin* bin_b = b;
+    if (bin_a->error != bin_b->error) return (bin_a->error > bin_b->error) ? -1 : 1;
+    if (bin_a->arg != bin_b->arg) return (bin_a->arg < bin_b->arg) ? -1 : 1;
+    return 0;
+}
+
+// Move the bins with the largest errors to the start of bins; returns how many of them the -w mode keeps.
+static int
+select_search_bins(search_bin* bins, const long n_bins) {
+    qsort(bins, (size_t)n_bins, sizeof(search_bin), compare_search_bins);
+    return (n_bins < SEARCH_BEAM) ? (int)n_bins : SEARCH_BEAM;
+}
+
+// The refinement rounds of the -w mode (see SEARCH_BEAM), starting from the n_beam bins in beam and leaving the worst cases found
+// there, largest error first.  points gives the reference options and the summary of the run.  The data points of the rounds are
+// appended to out_datafile (unless it is NULL), their number is added to n_tested and the number of rounds is returned in rounds.
+static accuracy_stats
+search_worst_cases(const chunk* points, search_bin* beam, int* n_beam, const int threads, FILE* out_datafile, long* n_tested,
+                   int* rounds) {
+    static const long per_bin = SEARCH_BINS * SEARCH_BIN_WIDTH;
+    accuracy_stats total = { 0.0, 0.0, 0, 0, 0, 0, 0, 0 };
+    search_bin pool[ SEARCH_BEAM * (SEARCH_BINS + 1) ];
+    chunk chunks[ SEARCH_BEAM ];
+    for (int b = 0; b < SEARCH_BEAM; b++) {
+        if (!alloc_chunk(&chunks[ b ], points, (size_t)per_bin)) {
+            printf("Failed to allocate the data buffer\n");
+            exit(-1);
+        }
+    }
+
+    for (*rounds = 0; *rounds < SEARCH_MAX_ROUNDS; (*rounds)++) {
+        // A chunk of per_bin points for each bin kept that has not been enumerated yet; its bins go to the start of the pool.
+        int n_chunks = 0;
+        for (int b = 0; b < *n_beam; b++) {
+            if (beam[ b ].exact) continue;
+            const double lo = beam[ b ].lo;
+            const double hi = beam[ b ].hi;
+            chunk* c = &chunks[ n_chunks ];
+            prepare_chunk(c, points);
+            c->bins = &pool[ (long)n_chunks * SEARCH_BINS ];
+            c->bin_width = SEARCH_BIN_WIDTH;
+            c->first = 0;
+            c->count = per_bin;
+            // The bit patterns of the arguments in [lo, hi] are consecutive if lo and hi have the same sign.  No bin extends past
+            // arg_max, so neither the samples nor the enumeration leave the range.
+            const uint64_t bits_lo = sweep_bits(lo);
+            const uint64_t bits_hi = sweep_bits(hi);
+            const uint64_t bits_min = (bits_lo < bits_hi) ? bits_lo : bits_hi;
+            const uint64_t n_args = ((bits_lo < bits_hi) ? bits_hi - bits_lo : bits_lo - bits_hi) + 1;
+            const int exact = !(lo < 0.0 && hi > 0.0) && n_args <= (uint64_t)per_bin;
+            if (exact) {
+                c->bits_min = bits_min;
+                c->bits_step = 1;
+                c->count = (long)n_args;
+            } else {
+                c->arg_min = lo;
+                c->arg_step = (hi - lo) / (double)per_bin;
+                c->bits_step = 0;
+            }
+            for (long k = 0; k < SEARCH_BINS; k++) {
+                search_bin* bin = &c->bins[ k ];
+                bin->arg = lo;
+                bin->error = -1.0;
+                bin->lo = exact ? lo : lo + (double)(k * SEARCH_BIN_WIDTH) * c->arg_step;
+                bin->hi = exact ? hi : fmin(lo + (double)((k + 1) * SEARCH_BIN_WIDTH) * c->arg_step, hi);
+                bin->exact = exact;
+            }
+            n_chunks++;
+        }
+        if (n_chunks == 0) break;
+
+        for (int first = 0; first < n_chunks; first += threads) {
+            run_chunks(&chunks[ first ], (n_chunks - first < threads) ? n_chunks - first : threads);
+        }
+        for (int t = 0; t < n_chunks; t++) {
+            finish_chunk(&chunks[ t ], points, &total, out_datafile);
+            *n_tested += chunks[ t ].count;
+        }
+
+        // The bins enumerated in earlier rounds compete with the new ones.
+        long n_pool = (long)n_chunks * SEARCH_BINS;
+        for (int b = 0; b < *n_beam; b++) {
+            if (beam[ b ].exact) pool[ n_pool++ ] = beam[ b ];
+        }
+        *n_beam = select_search_bins(pool, n_pool);
+        memcpy(beam, pool, (size_t)(*n_beam) * sizeof(search_bin));
+    }
+
+    for (int b = 0; b < SEARCH_BEAM; b++) free_chunk(&chunks[ b ]);
+    return total;
+}
+
+#define USAGE "Usage:  %s [-j threads] [-r threshold] [-c cache_filename | [-t] [-w]] arg_min arg_max arg_cnt output_filename\n" \
+              "        %s [-j threads] [-r threshold] [-t] -e binade_min binade_max stride output_filename\n" \
+              "        %s -s arg...\n"
+
+int
+main(int argc, char* argv[]) {
+
+    const char* program = argv[ 0 ];
+    if (argc < 2) {
+        printf(USAGE, program, program, program);
+        return -1;
+    }
+    if (strcmp(argv[ 1 ], "-s") == 0) {
+        doPoints(&argv[ 2 ], argc - 2);
+        return 0;
+    }
+    // -j threads splits the range into chunks that are tested in parallel.  The output file and the statistics are the same as
+    // those of a single-threaded run.  -c cache_filename reads the reference values from a reference cache made by an earlier run
+    // over the same range, or makes one.  -t compares with a triple-double reference first and calls MPFR only for the points whose
+    // classification that leaves in doubt.  -e binade_min binade_max stride tests every stride-th bit pattern of the positive
+    // arguments in each binade [2^e, 2^(e+1)), binade_min <= e <= binade_max, instead of a linear range, and reports each binade.
+    // -w searches for the worst cases of the range (see SEARCH_BEAM) after the run over it and reports them; the data points of the
+    // search follow those of the range in the output file.  -r threshold prints a report of the errors computed as the points are
+    // tested (see error_summary) with the counts of the errors above threshold ulp.  An output_filename of - writes no data points.
+    int threads = 1;
+    error_summary* summary = NULL;
+    const char* cache_filename = NULL;
+    double td_sign = 0.0;
+    int search = 0;
+    int sweep = 0;
+    int binade_min = 0;
+    int binade_max = 0;
+    long stride = 0;
+    while (argc >= 2 && argv[ 1 ][ 0 ] == '-' && strchr("jcterw", argv[ 1 ][ 1 ]) != NULL && argv[ 1 ][ 2 ] == '\0') {
+        const char option = argv[ 1 ][ 1 ];
+        if (option == 'e') {
+            if (argc < 5) break;
+            sweep = 1;
+            binade_min = atoi(argv[ 2 ]);
+            binade_max = atoi(argv[ 3 ]);
+            stride = atol(argv[ 4 ]);
+            if (binade_min < SWEEP_MIN_EXP || binade_max > SWEEP_MAX_EXP || binade_min > binade_max || stride < 1) {
+                printf("Bad sweep:  binades %d to %d (%d to %d)  stride %ld\n", binade_min, binade_max, SWEEP_MIN_EXP,
+                       SWEEP_MAX_EXP, stride);
+                return -1;
+            }
+            argc -= 4;
+            argv += 4;
+            continue;
+        }
+        if (option == 'w') {
+            search = 1;
+            argc -= 1;
+            argv += 1;
+            continue;
+        }
+        if (option == 't') {
+            td_sign = reference_td_sign();
+            if (td_sign == 0.0) {
+                printf("No triple-double reference for %s\n", STRINGIZE(MPFR_FUNC_NAME));
+                return -1;
+            }
+            argc -= 1;
+            argv += 1;
+            continue;
+        }
+        if (argc < 3) break;
+        if (option == 'c') {
+            cache_filename = argv[ 2 ];
+        } else if (option == 'r') {
+            const double threshold = strtod(argv[ 2 ], NULL);
+            if (!(threshold >= 0.0)) {
+                printf("Bad threshold:  %s\n", argv[ 2 ]);
+                return -1;
+            }
+            if (summary == NULL) summary = calloc(1, sizeof(error_summary));
+            if (summary == NULL) {
+                printf("Failed to allocate the error summary\n");
+                return -1;
+            }
+            summary->threshold = threshold;
+        } else {
+            threads = atoi(argv[ 2 ]);
+            if (threads < 1 || threads > MAX_THREADS) {
+                printf("Bad thread count:  %s (1 to %d)\n", argv[ 2 ], MAX_THREADS);
+                return -1;
+            }
+        }
+        argc -= 2;
+        argv += 2;
+    }
+    if (((td_sign != 0.0 || sweep || search) && cache_filename != NULL) || (search && sweep)) {
+        printf(USAGE, program, program, program);
+        return -1;
+    }
+    if (argc != (sweep ? 2 : 5)) {
+        printf(USAGE, program, program, program);
+        return -1;
+    }
+
+    chunk points = { .td_sign = td_sign, .summary = summary };
+    double arg_min = 0.0;
+    double arg_max = 0.0;
+    long arg_cnt = 0;
+    long n_points = 0;
+    char* output_filename = argv[ sweep ? 1 : 4 ];
+    if (!sweep) {
+        arg_min = strtod(argv[ 1 ], NULL);
+        arg_max = strtod(argv[ 2 ], NULL);
+        arg_cnt = atol(argv[ 3 ]);
+        double arg_step = (arg_max - arg_min) / (double)arg_cnt;
+        if (arg_step <= 0.0) {
+            printf("Bad argument range:  min = %e  max = %e  count = %ld\n", arg_min, arg_max, arg_cnt);
+            return 0;
+        }
+        points.arg_min = arg_min;
+        points.arg_step = arg_step;
+        n_points = count_points(arg_min, arg_max, arg_step);
+    }
 
-    fclose(out_datafile);
-    printf("arg range: %.18e (%.13a) to %.18e (%.13a)  %d points\n", arg_min, arg_min, arg_max, arg_max, arg_cnt);
-    printf("max err = %.3f ulp at x = %.17e (%.13a)\n", max_err_ulp, max_err_arg, max_err_arg);
-    printf("Correctly rounded: %d (%.2f)\n", correctly_rounded, 100. * correctly_rounded / arg_cnt);
-    printf("Faithfully rounded: %d (%.2f)\n", faithfully_rounded, 100. * faithfully_rounded / arg_cnt);
-    printf("Error >= 1 ulp: %d (%.2f)\n", geq_1_ulp, 100. * geq_1_ulp / arg_cnt);
-    printf("Nans encountered: %d\n", nans);
+    // The bins of the coarse sweep of the -w mode; they are widened for long ranges to bound their number.
+    long n_bins = 0;
+    if (search) {
+        points.bin_width = SEARCH_BIN_WIDTH;
+        while (n_points / points.bin_width > SEARCH_MAX_COARSE_BINS && points.bin_width < BUFFER_SIZE) points.bin_width *= 2;
+        n_bins = (n_points + points.bin_width - 1) / points.bin_width;
+        points.bins = malloc((size_t)n_bins * sizeof(search_bin));
+        if (points.bins == NULL) {
+            printf("Failed to allocate %ld bins\n", n_bins);
+            return -1;
+        }
+        for (long k = 0; k < n_bins; k++) {
+            search_bin* bin = &points.bins[ k ];
+            bin->lo = arg_min + (double)(k * points.bin_width) * points.arg_step;
+            // The last bin is usually partial; the refinement rounds must not reach past the range.
+            bin->hi = fmin(arg_min + (double)((k + 1) * points.bin_width) * points.arg_step, arg_max);
+            bin->arg = bin->lo;
+            bin->error = -1.0;
+            bin->exact = 0;
+        }
+    }
+
+    ref_cache cache;
+    if (cache_filename != NULL) {
+        ref_cache_header wanted = { .arg_min = arg_min, .arg_max = arg_max, .arg_cnt = arg_cnt, .n_points = n_points,
+                                    .precision = DEFAULT_MPFR_PREC };
+        strncpy(wanted.function, REFERENCE_NAME, REF_CACHE_NAME_SIZE - 1);
+        if (ref_cache_open(&cache, cache_filename, &wanted) != 0) return -1;
+        points.cache = &cache;
+    }
+
+    FILE* out_datafile = NULL;
+    if (strcmp(output_filename, "-") != 0) out_datafile = fopen(output_filename, "wb");
+    if (out_datafile == NULL && strcmp(output_filename, "-") != 0) {
+        printf("Failed to open output data file\n");
+        return -1;
+    }
+
+#if defined(TEST_CR_FUNC)
+    // FUNC_NAME is a correctly rounded function; count the arguments for which its rounding test failed (in all threads).
+    extern unsigned long long expxsqr_cr_escalations(void);
+    const unsigned long long escalations_before = expxsqr_cr_escalations();
+#endif
+    accuracy_stats stats = { 0.0, 0.0, 0, 0, 0, 0, 0, 0 };
+    if (sweep) {
+        const uint64_t binade_size = (uint64_t)1 << SWEEP_MANT_BITS;
+        const long per_binade = (long)((binade_size + (uint64_t)stride - 1) / (uint64_t)stride);
+        points.bits_step = (uint64_t)stride;
+        for (int e = binade_min; e <= binade_max; e++) {
+            points.bits_min = SWEEP_BITS(e);
+            accuracy_stats binade = run_points(&points, per_binade, threads, out_datafile);
+            printf("binade 2^%d:  %ld points  max err = %.*f ulp at x = %.13a  correctly rounded %ld  faithfully rounded %ld"
+                   "  >= 1 ulp %ld\n", e, per_binade, ERR_DIGITS, binade.max_err_ulp, binade.max_err_arg, binade.correctly_rounded,
+                   binade.faithfully_rounded, binade.geq_1_ulp);
+            merge_stats(&stats, &binade);
+        }
+        arg_min = sweep_arg(SWEEP_BITS(binade_min));
+        arg_max = sweep_arg(SWEEP_BITS(binade_max) + (uint64_t)(per_binade - 1) * points.bits_step);
+        arg_cnt = per_binade * (binade_max - binade_min + 1);
+    } else {
+        stats = run_points(&points, n_points, threads, out_datafile);
+    }
+    if (search) {
+        search_bin beam[ SEARCH_BEAM ];
+        int n_beam = select_search_bins(points.bins, n_bins);
+        memcpy(beam, points.bins, (size_t)n_beam * sizeof(search_bin));
+        free(points.bins);
+        points.bins = NULL;
+        long n_tested = 0;
+        int rounds = 0;
+        accuracy_stats found = search_worst_cases(&points, beam, &n_beam, threads, out_datafile, &n_tested, &rounds);
+        merge_stats(&stats, &found);
+        printf("Search:  %d rounds  %ld points after %ld in the range\n", rounds, n_tested, arg_cnt);
+        for (int b = 0; b < n_beam && beam[ b ].error >= 0.0; b++) {
+            printf("worst case %d:  x = %.17e (%.13a)  err = %.*f ulp%s\n", b + 1, beam[ b ].arg, beam[ b ].arg, ERR_DIGITS,
+                   beam[ b ].error, beam[ b ].exact ? "" : "  (neighbourhood not enumerated)");
+        }
+        arg_cnt += n_tested;
+    }
+
+    if (out_datafile != NULL) fclose(out_datafile);
+    if (cache_filename != NULL) {
+        printf("Reference values %s %s\n", cache.filling ? "written to" : "read from", cache_filename);
+        ref_cache_close(&cache);
+    }
+    printf("arg range: %.18e (%.13a) to %.18e (%.13a)  %ld points\n", arg_min, arg_min, arg_max, arg_max, arg_cnt);
+    printf("max err = %.*f ulp at x = %.17e (%.13a)\n", ERR_DIGITS, stats.max_err_ulp, stats.max_err_arg, stats.max_err_arg);
+    printf("Correctly rounded: %ld (%.2f)\n", stats.correctly_rounded, 100. * stats.correctly_rounded / arg_cnt);
+    printf("Faithfully rounded: %ld (%.2f)\n", stats.faithfully_rounded, 100. * stats.faithfully_rounded / arg_cnt);
+    printf("Error >= 1 ulp: %ld (%.2f)\n", stats.geq_1_ulp, 100. * stats.geq_1_ulp / arg_cnt);
+    printf("Nans encountered: %ld\n", stats.nans);
+    if (td_sign != 0.0) {
+        printf("Points escalated from the triple-double reference to MPFR: %ld (%.3f%%)\n", stats.mpfr_references,
+               100. * stats.mpfr_references / arg_cnt);
+    }
+#if defined(TEST_CR_FUNC)
+    const unsigned long long escalations = expxsqr_cr_escalations() - escalations_before;
+    printf("Escalations to triple-double: %llu (%.3f%%)\n", escalations, 100. * (double)escalations / arg_cnt);
+#endif
+    if (summary != NULL) {
+        print_summary(summary, stats.max_err_ulp);
+        free(summary);
+    }
+    if (stats.cache_mismatches != 0) {
+        printf("FAILED:  %ld arguments do not match the reference cache\n", stats.cache_mismatches);
+        return 1;
+    }
+#if defined(MAX_ERR_ULP)
+    // Check the documented error bound of the accuracy tier being tested.
+    if (stats.max_err_ulp > MAX_ERR_ULP) {
+        printf("FAILED:  max err exceeds the bound of %.*f ulp\n", ERR_DIGITS - 1, (double)MAX_ERR_ULP);
+        return 1;
+    }
+    printf("Within the bound of %.*f ulp\n", ERR_DIGITS - 1, (double)MAX_ERR_ULP);
+#endif
 
     return 0;
 }
@@ -0,0 +1,206 @@
+// -*-  mode: C;  fill-column: 132  comment-start:  "// "  comment-end:  ""  coding: utf-8  -*-
+
+// ****************************************************************
+// * Copyright (C) 2020  J.M. Arnold  jearnold <at> cern <dot> ch *
+// ****************************************************************
+
+// *****************************************************************************
+// This program is free software: you can redistribute it and/or modify it     *
+// under the terms of the GNU Lesser General Public License as published by    *
+// the Free Software Foundation, either version 2 of the License, or (at your  *
+// option) any later version.                                                  *
+//                                                                             *
+// This program is distributed in the hope that it will be useful, but WITHOUT *
+// ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or       *
+// FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public        *
+// License for more details.                                                   *
+//                                                                             *
+// You should have received a copy of the GNU Lesser General Public License    *
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.      *
+// *****************************************************************************
+
+
+// Check that the array functions return bitwise the same results as the scalar functions over a buffer long enough to run the
+// full-width main loop of the vector kernels many times, with an odd tail, and with NaNs, infinities, zeros and the overflow and
+// underflow thresholds of the functions spread over all the lanes.  Each array function is run on the whole buffer and on the
+// buffer from an odd offset, so that the lanes see different arguments and the loads are unaligned.  Compiled with -DTEST_AVX512,
+// the AVX-512 kernels are called directly instead of the array functions.  The program returns 1 if any result differs.
+
+#include <float.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "expxsqr.h"
+#include "expxy.h"
+#include "gaussian.h"
+
+#if defined(TEST_AVX512)
+#define ARRAY(f) f ## _avx512
+#define ARRAY_NAME "_avx512"
+#else
+#define ARRAY(f) f
+#define ARRAY_NAME ""
+#endif
+
+#define N_POINTS 5003
+#define SPECIAL_PERIOD 13
+
+// The parameters of the Gaussian checked.
+#define GAUSSIAN_A 3.7
+#define GAUSSIAN_MU 1.3
+#define GAUSSIAN_SIGMA 0.7
+
+// Arguments at which the code paths of the functions change:  zeros, the largest arguments whose results are 1.0, the overflow
+// and underflow thresholds of the double and float versions and their neighbours, subnormals, infinities and NaNs.
+static const double specials[] = {
+    0.0, -0.0, 0x1.0p-1074, -0x1.0p-1022, 0x1.0p-28, 0x1.6a09e667f3bccp-27, -0x1.6a09e667f3bcdp-27, 0x1.0p-12, 1.0, -2.5,
+    0x1.aa4499161cd48p+4, 0x1.aa4499161cd49p+4, -0x1.aa4499161cd47p+4, 0x1.9ep+4, 0x1.b4c109b69b1bap+4, -0x1.b4c109b69b1bbp+4,
+    0x1.2d6acp+3, -0x1.2d6aep+3, 0x1.464b2p+3, 0x1.464b4p+3, 27.5, -1.0e+300, DBL_MAX, INFINITY, -INFINITY, NAN, -NAN,
+};
+#define N_SPECIALS (sizeof(specials) / sizeof(specials[ 0 ]))
+
+// xorshift64* (Vigna); a fixed seed makes the arguments reproducible.
+static uint64_t rng_state = 0x9e3779b97f4a7c15ULL;
+
+static double
+next_uniform(void) {
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return (double)((rng_state * 0x2545f4914f6cdd1dULL) >> 11) * 0x1.0p-53;
+}
+
+// Uniform in [-range, range], with a special argument at every SPECIAL_PERIOD-th point.
+static void
+make_arguments(double* x, const size_t n, const double range, const size_t phase) {
+    for (size_t i = 0; i < n; i++) {
+        x[ i ] = (i % SPECIAL_PERIOD == phase) ? specials[ (i / SPECIAL_PERIOD) % N_SPECIALS ]
+                                               : range * (2.0 * next_uniform() - 1.0);
+    }
+    return;
+}
+
+// Count the results that differ bitwise from the scalar ones and report the first of them.
+static size_t
+count_mismatches(const char* name, const double* x, const void* array_results, const void* scalar_results, const size_t n,
+                 const size_t size) {
+    size_t mismatches = 0;
+    for (size_t i = 0; i < n; i++) {
+        const char* a = (const char*)array_results + i * size;
+        const char* s = (const char*)scalar_results + i * size;
+        if (memcmp(a, s, size) != 0) {
+            if (mismatches == 0) {
+                double y_a, y_s;
+                if (size == sizeof(float)) {
+                    float f_a, f_s;
+                    memcpy(&f_a, a, sizeof(float));
+                    memcpy(&f_s, s, sizeof(float));
+                    y_a = f_a;
+                    y_s = f_s;
+                } else {
+                    memcpy(&y_a, a, sizeof(double));
+                    memcpy(&y_s, s, sizeof(double));
+                }
+                printf("%s(%.17e (%.13a)) at %zu:  array = %.17e (%.13a)  scalar = %.17e (%.13a)\n", name, x[ i ], x[ i ], i,
+                       y_a, y_a, y_s, y_s);
+            }
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+static size_t
+report(const char* name, const size_t offset, const size_t mismatches) {
+    printf("%-26s  offset %zu  %d points  mismatches = %zu\n", name, offset, N_POINTS - (int)offset, mismatches);
+    return mismatches;
+}
+
+int
+main(void) {
+    static double x[ N_POINTS ], y[ N_POINTS ];
+    static double a[ N_POINTS ], b[ N_POINTS ], s[ N_POINTS ], t[ N_POINTS ];
+    static float x_flt[ N_POINTS ], a_flt[ N_POINTS ], s_flt[ N_POINTS ];
+    static const size_t offsets[] = { 0, 3 };
+    size_t mismatches = 0;
+
+    for (size_t k = 0; k < sizeof(offsets) / sizeof(offsets[ 0 ]); k++) {
+        const size_t o = offsets[ k ];
+        const size_t n = N_POINTS - o;
+
+        make_arguments(x, N_POINTS, 28.0, 5);
+        ARRAY(expxsqr_array)(x + o, a, n);
+        for (size_t i = 0; i < n; i++) s[ i ] = expxsqr(x[ o + i ]);
+        mismatches += report("expxsqr_array" ARRAY_NAME, o, count_mismatches("expxsqr", x + o, a, s, n, sizeof(double)));
+
+        ARRAY(expmxsqr_array)(x + o, a, n);
+        for (size_t i = 0; i < n; i++) s[ i ] = expmxsqr(x[ o + i ]);
+        mismatches += report("expmxsqr_array" ARRAY_NAME, o, count_mismatches("expmxsqr", x + o, a, s, n, sizeof(double)));
+
+        ARRAY(expxsqr_pair_array)(x + o, a, b, n);
+        for (size_t i = 0; i < n; i++) expxsqr_pair(x[ o + i ], &s[ i ], &t[ i ]);
+        mismatches += report("expxsqr_pair_array" ARRAY_NAME, o,
+                             count_mismatches("expxsqr_pair pos", x + o, a, s, n, sizeof(double)) +
+                             count_mismatches("expxsqr_pair neg", x + o, b, t, n, sizeof(double)));
+
+        ARRAY(expxsqr_dd_array)(x + o, a, b, n);
+        for (size_t i = 0; i < n; i++) {
+            DD r = expxsqr_dd(x[ o + i ]);
+            s[ i ] = DD_HI(r);
+            t[ i ] = DD_LO(r);
+        }
+        mismatches += report("expxsqr_dd_array" ARRAY_NAME, o,
+                             count_mismatches("expxsqr_dd hi", x + o, a, s, n, sizeof(double)) +
+                             count_mismatches("expxsqr_dd lo", x + o, b, t, n, sizeof(double)));
+
+        ARRAY(expmxsqr_dd_array)(x + o, a, b, n);
+        for (size_t i = 0; i < n; i++) {
+            DD r = expmxsqr_dd(x[ o + i ]);
+            s[ i ] = DD_HI(r);
+            t[ i ] = DD_LO(r);
+        }
+        mismatches += report("expmxsqr_dd_array" ARRAY_NAME, o,
+                             count_mismatches("expmxsqr_dd hi", x + o, a, s, n, sizeof(double)) +
+                             count_mismatches("expmxsqr_dd lo", x + o, b, t, n, sizeof(double)));
+
+        make_arguments(x, N_POINTS, 11.0, 7);
+        for (size_t i = 0; i < N_POINTS; i++) x_flt[ i ] = (float)x[ i ];
+        ARRAY(expxsqrf_array)(x_flt + o, a_flt, n);
+        for (size_t i = 0; i < n; i++) s_flt[ i ] = expxsqrf(x_flt[ o + i ]);
+        mismatches += report("expxsqrf_array" ARRAY_NAME, o, count_mismatches("expxsqrf", x + o, a_flt, s_flt, n, sizeof(float)));
+
+        ARRAY(expmxsqrf_array)(x_flt + o, a_flt, n);
+        for (size_t i = 0; i < n; i++) s_flt[ i ] = expmxsqrf(x_flt[ o + i ]);
+        mismatches += report("expmxsqrf_array" ARRAY_NAME, o, count_mismatches("expmxsqrf", x + o, a_flt, s_flt, n, sizeof(float)));
+
+        make_arguments(x, N_POINTS, 30.0, 9);
+        ARRAY(gaussian_array)(x + o, a, n, GAUSSIAN_A, GAUSSIAN_MU, GAUSSIAN_SIGMA);
+        for (size_t i = 0; i < n; i++) s[ i ] = gaussian(x[ o + i ], GAUSSIAN_A, GAUSSIAN_MU, GAUSSIAN_SIGMA);
+        mismatches += report("gaussian_array" ARRAY_NAME, o, count_mismatches("gaussian", x + o, a, s, n, sizeof(double)));
+
+        // gaussian() is gaussian_kernel() on the parameters of gaussian_setup(); callers may also make those two calls themselves.
+        const gaussian_params params = gaussian_setup(GAUSSIAN_A, GAUSSIAN_MU, GAUSSIAN_SIGMA);
+        for (size_t i = 0; i < n; i++) a[ i ] = gaussian_kernel(x[ o + i ], &params);
+        mismatches += report("gaussian_kernel", o, count_mismatches("gaussian", x + o, a, s, n, sizeof(double)));
+
+        make_arguments(x, N_POINTS, 40.0, 11);
+        make_arguments(y, N_POINTS, 40.0, 2);
+        ARRAY(expxy_array)(x + o, y + o, a, n);
+        for (size_t i = 0; i < n; i++) s[ i ] = expxy(x[ o + i ], y[ o + i ]);
+        mismatches += report("expxy_array" ARRAY_NAME, o, count_mismatches("expxy", x + o, a, s, n, sizeof(double)));
+
+        ARRAY(expmxy_array)(x + o, y + o, a, n);
+        for (size_t i = 0; i < n; i++) s[ i ] = expmxy(x[ o + i ], y[ o + i ]);
+        mismatches += report("expmxy_array" ARRAY_NAME, o, count_mismatches("expmxy", x + o, a, s, n, sizeof(double)));
+    }
+
+    if (mismatches != 0) {
+        printf("FAILED:  the array results differ from the scalar ones\n");
+        return 1;
+    }
+    return 0;
+}
@@ -27,6 +27,7 @@
 #include "mpfr.h"
 #include "utils.h"
 #include "DD_arithmetic.h"
+#include "TD_arithmetic.h"
 
 typedef union {
     double d;
@@ -46,12 +47,12 @@ getexpo(const double x) {
 float
 ulpf (const float x) {
     int class_x = fpclassify(x);
-    if (class_x == FP_NAN || class_x == FP_ZERO || class_x == FP_INFINITE)
+    if (class_x == FP_NAN || class_x == FP_INFINITE)
         return NAN;
     int expo;
-    if (class_x != FP_SUBNORMAL)
+    if (class_x == FP_NORMAL)
         frexpf(x, &expo);
-    else
+    else // class_x == FP_SUBNORMAL || class_x == ZERO
         expo = FLT_MIN_EXP;
     return ldexpf(1.0f, expo - FLT_MANT_DIG);
 }
@@ -83,5 +84,102 @@ compare(mpfr_srcptr ref, const double test) {
     mpfr_sub_d(mpfr_temp, ref, test, MPFR_RNDN);
     mpfr_div_d(mpfr_temp, mpfr_temp, ulp(ref_d), MPFR_RNDN);
     double ulp_error = mpfr_get_d(mpfr_temp, MPFR_RNDN);
+    mpfr_clears(mpfr_temp, (mpfr_ptr)NULL);
+    return fabs(ulp_error);
+}
+
+// Calculate |ulp error| of a double-double test result hi + lo by comparing it to an MPFR reference value.  The ulp is that of the
+// reference rounded to double, so the error of an accurate double-double result is a small fraction of 1.
+double
+compare_DD(mpfr_srcptr ref, const DD test) {
+    double ref_d = mpfr_get_d(ref, MPFR_RNDN);
+    if (isnan(ref_d) && isnan(DD_HI(test))) return 0.0;
+    if (isnan(ref_d) || isnan(DD_HI(test)) || isnan(DD_LO(test))) return NAN;
+    if (isinf(ref_d) && isinf(DD_HI(test)) && (ref_d * DD_HI(test) >= 0.0)) return 0.0;
+    if (isinf(ref_d) || isinf(DD_HI(test))) return INFINITY;
+    // Calculate (double)((ref - hi - lo) / ulp(ref)).
+    mpfr_t mpfr_temp;
+    mpfr_inits2(mpfr_get_prec(ref), mpfr_temp, (mpfr_ptr)NULL);
+    mpfr_sub_d(mpfr_temp, ref, DD_HI(test), MPFR_RNDN);
+    mpfr_sub_d(mpfr_temp, mpfr_temp, DD_LO(test), MPFR_RNDN);
+    mpfr_div_d(mpfr_temp, mpfr_temp, ulp(ref_d), MPFR_RNDN);
+    double ulp_error = mpfr_get_d(mpfr_temp, MPFR_RNDN);
+    mpfr_clears(mpfr_temp, (mpfr_ptr)NULL);
     return fabs(ulp_error);
 }
+
+// Calculate |ulp error| of a single-precision test result by comparing it to an MPFR reference value.  The ulp is that of the
+// reference rounded to float.
+double
+comparef(mpfr_srcptr ref, const float test) {
+    float ref_f = mpfr_get_flt(ref, MPFR_RNDN);
+    if (isnan(ref_f) && isnan(test)) return 0.0;
+    if (isnan(ref_f) || isnan(test)) return NAN;
+    if (isinf(ref_f) && isinf(test) && (ref_f * test >= 0.0f)) return 0.0;
+    if (isinf(ref_f) || isinf(test)) return INFINITY;
+    // Calculate (double)((ref - test) / ulpf(ref)).
+    mpfr_t mpfr_temp;
+    mpfr_inits2(mpfr_get_prec(ref), mpfr_temp, (mpfr_ptr)NULL);
+    mpfr_sub_d(mpfr_temp, ref, (double)test, MPFR_RNDN);
+    mpfr_div_d(mpfr_temp, mpfr_temp, (double)ulpf(ref_f), MPFR_RNDN);
+    double ulp_error = mpfr_get_d(mpfr_temp, MPFR_RNDN);
+    mpfr_clears(mpfr_temp, (mpfr_ptr)NULL);
+    return fabs(ulp_error);
+}
+
+// Round the reference 2^e * y, 1/sqrt(2) < y < sqrt(2), to p bits with minimum normal exponent emin.  Sets *rounded to the result
+// and *quantum to its ulp, both scaled by 2^-e.  Returns 0 if y is within rel_err of a rounding boundary (where the rounding of the
+// exact reference is not certain) or if it rounds to 0.
+static int
+round_scaled_TD(const TD y, const int e, const int p, const int emin, const double rel_err, double* rounded, double* quantum) {
+    int expo = ilogb(TD_HI(y)) + e;
+    if (expo < emin) expo = emin;
+    double q = ldexp(1.0, expo - (p - 1) - e);
+    // y / q = n + d with n an integer and |d| <= 1/2.  The division is exact.
+    TD t = load_D_D_D_TD(TD_HI(y) / q, TD_MI(y) / q, TD_LO(y) / q);
+    double n = nearbyint(TD_HI(t));
+    double d = TD_HI(add_TD_D_TD(t, -n));
+    if (d > 0.5) {
+        n += 1.0;
+        d -= 1.0;
+    } else if (d < -0.5) {
+        n -= 1.0;
+        d += 1.0;
+    }
+    // Rounding up to a power of 2 moves to the next binade.  Just below a normal power of 2 the rounding boundary is a quarter of
+    // its ulp away, not half.
+    const double two_p = ldexp(1.0, p);
+    if (n == two_p) {
+        n *= 0.5;
+        d *= 0.5;
+        q *= 2.0;
+    }
+    const double half_gap = (n == 0.5 * two_p && d < 0.0 && ilogb(n * q) + e > emin) ? 0.25 : 0.5;
+    if (n == 0.0 || fabs(d) >= half_gap - 2.0 * rel_err * two_p) return 0;
+    *rounded = n * q;
+    *quantum = q;
+    return 1;
+}
+
+// Calculate |ulp error| of a test result hi + lo (lo = 0.0 except for double-double results) by comparing it to the reference
+// 2^e * y, 1/sqrt(2) < y < sqrt(2), given in triple-double with a relative error of at most rel_err, without MPFR.  The ulp is that
+// of the reference rounded to double, or to float if float_ulps.  Sets *error, *bound (a bound on the error of *error) and *ref_d
+// (the reference rounded to double).  Returns 0 if the reference is too close to a rounding boundary to be sure of its rounding,
+// if the result is not finite or 0, or if it is not within a factor of 2 of the reference; compare() etc. are needed for those.
+int
+compare_TD(const TD y, const int e, const double rel_err, const DD test, const int float_ulps, double* error, double* bound,
+           double* ref_d) {
+    if (!isfinite(DD_HI(test)) || DD_HI(test) == 0.0 || e > DBL_MAX_EXP - 1) return 0;
+    double rounded, quantum;
+    if (!round_scaled_TD(y, e, DBL_MANT_DIG, DBL_MIN_EXP - 1, rel_err, &rounded, &quantum)) return 0;
+    *ref_d = ldexp(rounded, e);
+    if (float_ulps && !round_scaled_TD(y, e, FLT_MANT_DIG, FLT_MIN_EXP - 1, rel_err, &rounded, &quantum)) return 0;
+    // The test result scaled by 2^-e, exactly since it is within a factor of 2 of y.
+    const double t_hi = ldexp(DD_HI(test), -e);
+    if (!(fabs(t_hi - TD_HI(y)) <= 0.5 * TD_HI(y))) return 0;
+    const double t_lo = ldexp(DD_LO(test), -e);
+    TD diff = add_TD_D_TD(add_TD_D_TD(y, -t_hi), -t_lo);
+    *error = fabs(TD_HI(diff)) / quantum;
+    *bound = 2.0 * rel_err * TD_HI(y) / quantum + 0x1.0p-51 * *error;
+    return 1;
+}
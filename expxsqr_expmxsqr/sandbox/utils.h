@@ -23,11 +23,16 @@
 #define _UTILS_H 1
 
 #include "DD_arithmetic.h"
+#include "TD_arithmetic.h"
 
 int getexpo(const double x);
 float ulpf (const float x);
 double ulp (const double x);
 double compare(mpfr_srcptr ref, const double test);
+double comparef(mpfr_srcptr ref, const float test);
+double compare_DD(mpfr_srcptr ref, const DD test);
+int compare_TD(const TD y, const int e, const double rel_err, const DD test, const int float_ulps, double* error, double* bound,
+               double* ref_d);
 
 #define COMPARE_CORRECTLY_ROUNDED (1)
 #define COMPARE_FAITHFULLY_ROUNDED (2)